@@ -24,6 +24,7 @@
 
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
+#include "views/CardFaceAtlas.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -94,6 +95,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
     // 设置FPS
     director->setAnimationInterval(1.0f / 60);
 
+    // 按需渲染：牌桌静止时跳过绘制，主循环阻塞等待输入或下一个定时器
+    director->setRenderOnDemand(true);
+
     // 设置设计分辨率
     glview->setDesignResolutionSize(1080, 2080, ResolutionPolicy::FIXED_WIDTH);
     auto frameSize = glview->getFrameSize();
@@ -115,6 +119,11 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     register_all_packages();
 
+    // 烘焙牌面图集，之后每张卡牌只需一个四边形绘制
+    if (!CardFaceAtlas::bake()) {
+        CCLOG("Card atlas bake failed, cards will fall back to plain backgrounds");
+    }
+
     // 创建场景，这是一个自动释放对象
     auto scene = HelloWorld::createScene();
 
@@ -1,70 +1,49 @@
 ﻿#include "LevelConfig.h"
-#include "json/document.h"
-#include "json/writer.h"
-#include "json/stringbuffer.h"
+#include "LevelParser.h"
+#include <memory>
 
 USING_NS_CC;
 
-LevelConfigManager* LevelConfigManager::s_instance = nullptr;
-
-LevelConfigManager* LevelConfigManager::getInstance() {
-    if (s_instance == nullptr) {
-        s_instance = new LevelConfigManager();
-    }
-    return s_instance;
-}
-
-bool LevelConfigManager::loadLevel(const std::string& levelFile) {
-    // 读取JSON文件
+bool LevelConfigManager::loadLevel(const std::string& levelFile, LevelConfig& level) {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(levelFile);
-    std::string jsonString = FileUtils::getInstance()->getStringFromFile(fullPath);
-    
-    if (jsonString.empty()) {
-        CCLOG("Failed to load level file: %s", levelFile.c_str());
+    std::string error;
+    if (!readLevelFile(fullPath, level, error)) {
+        CCLOG("Failed to load level %s: %s", levelFile.c_str(), error.c_str());
         return false;
     }
     
-    // 解析JSON
-    rapidjson::Document document;
-    document.Parse(jsonString.c_str());
+    CCLOG("Level loaded successfully: %s", levelFile.c_str());
+    return true;
+}
+
+void LevelConfigManager::loadLevelAsync(const std::string& levelFile, const LoadCallback& callback) {
+    // 路径在主线程解析，后台只按完整路径读取
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(levelFile);
     
-    if (document.HasParseError()) {
-        CCLOG("Failed to parse level JSON: %s", levelFile.c_str());
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [fullPath, levelFile, callback]() {
+        std::shared_ptr<LevelConfig> level = std::make_shared<LevelConfig>();
+        std::shared_ptr<std::string> error = std::make_shared<std::string>();
+        bool success = readLevelFile(fullPath, *level, *error);
+        
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread([levelFile, callback, level, error, success]() {
+            if (!success) {
+                CCLOG("Failed to load level %s: %s", levelFile.c_str(), error->c_str());
+            }
+            if (callback) {
+                callback(success, *level, *error);
+            }
+        });
+    });
+}
+
+bool LevelConfigManager::readLevelFile(const std::string& fullPath, LevelConfig& level, std::string& error) {
+    // 读入的字符串以'\0'结尾，直接作为原位解析的缓冲区
+    std::string json = fullPath.empty() ? std::string() : FileUtils::getInstance()->getStringFromFile(fullPath);
+    if (json.empty()) {
+        level.playfield.clear();
+        level.stack.clear();
+        error = "file is missing or empty";
         return false;
     }
-    
-    // 清空当前配置
-    m_currentLevel.playfield.clear();
-    m_currentLevel.stack.clear();
-    
-    // 解析Playfield
-    if (document.HasMember("Playfield") && document["Playfield"].IsArray()) {
-        const rapidjson::Value& playfield = document["Playfield"];
-        for (rapidjson::SizeType i = 0; i < playfield.Size(); i++) {
-            const rapidjson::Value& card = playfield[i];
-            CardConfig cardConfig;
-            cardConfig.cardFace = card["CardFace"].GetInt();
-            cardConfig.cardSuit = card["CardSuit"].GetInt();
-            cardConfig.position.x = card["Position"]["x"].GetFloat();
-            cardConfig.position.y = card["Position"]["y"].GetFloat();
-            m_currentLevel.playfield.push_back(cardConfig);
-        }
-    }
-    
-    // 解析Stack
-    if (document.HasMember("Stack") && document["Stack"].IsArray()) {
-        const rapidjson::Value& stack = document["Stack"];
-        for (rapidjson::SizeType i = 0; i < stack.Size(); i++) {
-            const rapidjson::Value& card = stack[i];
-            CardConfig cardConfig;
-            cardConfig.cardFace = card["CardFace"].GetInt();
-            cardConfig.cardSuit = card["CardSuit"].GetInt();
-            cardConfig.position.x = card["Position"]["x"].GetFloat();
-            cardConfig.position.y = card["Position"]["y"].GetFloat();
-            m_currentLevel.stack.push_back(cardConfig);
-        }
-    }
-    
-    CCLOG("Level loaded successfully: %s", levelFile.c_str());
-    return true;
-}
\ No newline at end of file
+    return LevelParser::parseInsitu(&json[0], level, &error);
+}
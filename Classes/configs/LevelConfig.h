@@ -3,36 +3,51 @@
 
 #include "cocos2d.h"
 #include "CardTypes.h"
-#include <vector>
+#include "LevelData.h"
+#include <functional>
 #include <string>
 
-struct CardConfig {
-    int cardFace;
-    int cardSuit;
-    cocos2d::Vec2 position;
-};
-
-struct LevelConfig {
-    std::vector<CardConfig> playfield;
-    std::vector<CardConfig> stack;
-};
-
+/**
+ * 关卡配置加载 - 通过cocos2d的FileUtils读取关卡文件并解析
+ * 无状态，解析结果写入调用方提供的配置，通常随后交给GameContext加载
+ * 解析在读入的文件缓冲区上原位进行并同时校验关卡结构，
+ * 内存占用为文件大小加上解析出的关卡配置
+ */
 class LevelConfigManager {
 public:
-    static LevelConfigManager* getInstance();
+    /**
+     * 异步加载完成回调，在主线程调用
+     * @param success 是否加载成功
+     * @param level 解析出的关卡配置，失败时为空；可直接交换走其中的内容
+     * @param error 失败时的错误描述，包含出错的行列号和JSON路径
+     */
+    typedef std::function<void(bool success, LevelConfig& level, const std::string& error)> LoadCallback;
     
     // 加载关卡配置
-    bool loadLevel(const std::string& levelFile);
+    static bool loadLevel(const std::string& levelFile, LevelConfig& level);
     
-    // 获取当前关卡配置
-    const LevelConfig& getCurrentLevel() const { return m_currentLevel; }
+    /**
+     * 在AsyncTaskPool的IO线程上读取并解析关卡文件，完成后在主线程调用回调
+     * 回调持有的对象需自行保证在回调时仍然有效
+     * @param levelFile 关卡文件，按FileUtils的搜索路径查找
+     * @param callback 完成回调
+     */
+    static void loadLevelAsync(const std::string& levelFile, const LoadCallback& callback);
     
-private:
-    LevelConfigManager() = default;
-    ~LevelConfigManager() = default;
+    /**
+     * 按完整路径读取并解析关卡文件，不访问FileUtils的查找缓存，可在任意线程调用
+     * @param fullPath 关卡文件的完整路径
+     * @param level 输出的关卡配置，失败时为空
+     * @param error 失败时输出错误描述
+     * @return 加载成功返回true
+     */
+    static bool readLevelFile(const std::string& fullPath, LevelConfig& level, std::string& error);
     
-    static LevelConfigManager* s_instance;
-    LevelConfig m_currentLevel;
+private:
+    LevelConfigManager() = delete;
+    ~LevelConfigManager() = delete;
+    LevelConfigManager(const LevelConfigManager&) = delete;
+    LevelConfigManager& operator=(const LevelConfigManager&) = delete;
 };
 
-#endif // __LEVEL_CONFIG_H__
\ No newline at end of file
+#endif // __LEVEL_CONFIG_H__
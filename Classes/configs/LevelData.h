@@ -0,0 +1,33 @@
+﻿#ifndef __LEVEL_DATA_H__
+#define __LEVEL_DATA_H__
+
+#include "RuleSetType.h"
+#include "../models/GameVec2.h"
+#include <vector>
+
+/**
+ * @struct CardConfig
+ * @brief 关卡中一张卡牌的配置
+ */
+struct CardConfig {
+    int cardFace;           ///< 牌面
+    int cardSuit;           ///< 花色
+    GameVec2 position;      ///< 卡牌位置
+};
+
+/**
+ * @struct LevelConfig
+ * @brief 一个关卡的卡牌配置
+ *
+ * 只包含数据，不依赖cocos2d，游戏、求解器和命令行工具共用
+ * 堆叠中最后一张为初始顶部手牌；牌桌按配置顺序叠放，越靠后越在上层
+ */
+struct LevelConfig {
+    std::vector<CardConfig> playfield;  ///< 牌桌卡牌
+    std::vector<CardConfig> stack;      ///< 手牌堆叠
+    int ruleSet;                        ///< 规则集（RuleSetType）
+
+    LevelConfig() : ruleSet(RST_CLASSIC) {}
+};
+
+#endif // __LEVEL_DATA_H__
@@ -0,0 +1,288 @@
+﻿#include "LevelPack.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 静态常量定义
+const uint32_t LevelPack::MAGIC;
+const uint16_t LevelPack::VERSION;
+const uint32_t LevelPack::DEFAULT_POSITION_SCALE;
+
+namespace {
+
+const int MAX_STACK_CARDS = 255;        ///< 单个关卡手牌堆叠的最大卡牌数
+const int MAX_PLAYFIELD_CARDS = 255;    ///< 单个关卡牌桌的最大卡牌数
+
+bool fail(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+/**
+ * @brief 量化一个坐标分量
+ *
+ * @return 超出16位整数范围返回false
+ */
+bool quantize(float value, int16_t& out) {
+    float scaled = std::floor(value * LevelPack::DEFAULT_POSITION_SCALE + 0.5f);
+    if (!(scaled >= std::numeric_limits<int16_t>::min() && scaled <= std::numeric_limits<int16_t>::max())) {
+        return false;
+    }
+    out = static_cast<int16_t>(scaled);
+    return true;
+}
+
+/**
+ * @brief 写入一张卡牌记录
+ */
+bool appendCard(const CardConfig& config, std::vector<LevelPackCard>& cards) {
+    if (config.cardFace < 0 || config.cardFace > 0xFF || config.cardSuit < 0 || config.cardSuit > 0xFF) {
+        return false;
+    }
+    LevelPackCard card;
+    card.face = static_cast<uint8_t>(config.cardFace);
+    card.suit = static_cast<uint8_t>(config.cardSuit);
+    if (!quantize(config.position.x, card.x) || !quantize(config.position.y, card.y)) {
+        return false;
+    }
+    cards.push_back(card);
+    return true;
+}
+
+} // namespace
+
+LevelPack::LevelPack()
+    : m_header(nullptr)
+    , m_entries(nullptr)
+    , m_cards(nullptr)
+    , m_inverseScale(1.0f)
+    , m_mappedData(nullptr)
+    , m_mappedSize(0)
+#ifdef _WIN32
+    , m_fileHandle(INVALID_HANDLE_VALUE)
+    , m_mappingHandle(nullptr)
+#endif
+{
+}
+
+LevelPack::~LevelPack() {
+    close();
+}
+
+bool LevelPack::build(const std::vector<LevelConfig>& levels, std::vector<uint8_t>& out, std::string* error) {
+    out.clear();
+
+    std::vector<LevelPackEntry> entries;
+    std::vector<LevelPackCard> cards;
+    entries.reserve(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const LevelConfig& level = levels[i];
+        if (level.stack.size() > MAX_STACK_CARDS || level.playfield.size() > MAX_PLAYFIELD_CARDS) {
+            return fail(error, "level has too many cards for a level pack");
+        }
+        if (level.ruleSet < 0 || level.ruleSet >= RST_NUM_RULE_SET_TYPES) {
+            return fail(error, "level has an unknown rule set");
+        }
+
+        LevelPackEntry entry;
+        entry.firstCard = static_cast<uint32_t>(cards.size());
+        entry.stackCount = static_cast<uint8_t>(level.stack.size());
+        entry.playfieldCount = static_cast<uint8_t>(level.playfield.size());
+        entry.ruleSet = static_cast<uint8_t>(level.ruleSet);
+        entry.reserved = 0;
+        entries.push_back(entry);
+
+        for (size_t c = 0; c < level.stack.size(); ++c) {
+            if (!appendCard(level.stack[c], cards)) {
+                return fail(error, "card face, suit or position out of range for a level pack");
+            }
+        }
+        for (size_t c = 0; c < level.playfield.size(); ++c) {
+            if (!appendCard(level.playfield[c], cards)) {
+                return fail(error, "card face, suit or position out of range for a level pack");
+            }
+        }
+    }
+
+    LevelPackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.cardRecordSize = sizeof(LevelPackCard);
+    header.levelCount = static_cast<uint32_t>(entries.size());
+    header.cardCount = static_cast<uint32_t>(cards.size());
+    header.indexOffset = sizeof(LevelPackHeader);
+    header.cardsOffset = static_cast<uint32_t>(header.indexOffset + entries.size() * sizeof(LevelPackEntry));
+    header.positionScale = DEFAULT_POSITION_SCALE;
+
+    out.resize(header.cardsOffset + cards.size() * sizeof(LevelPackCard));
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!entries.empty()) {
+        std::memcpy(out.data() + header.indexOffset, entries.data(), entries.size() * sizeof(LevelPackEntry));
+    }
+    if (!cards.empty()) {
+        std::memcpy(out.data() + header.cardsOffset, cards.data(), cards.size() * sizeof(LevelPackCard));
+    }
+    return true;
+}
+
+bool LevelPack::openFile(const std::string& path, std::string* error) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return fail(error, "cannot open level pack");
+    }
+    m_fileHandle = file;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return fail(error, "level pack is empty");
+    }
+    m_mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mappingHandle) {
+        close();
+        return fail(error, "cannot map level pack");
+    }
+    m_mappedData = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    m_mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail(error, "cannot open level pack");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return fail(error, "level pack is empty");
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped != MAP_FAILED) {
+        m_mappedData = mapped;
+        m_mappedSize = static_cast<size_t>(st.st_size);
+    }
+#endif
+
+    if (!m_mappedData) {
+        close();
+        return fail(error, "cannot map level pack");
+    }
+    if (!attach(static_cast<const uint8_t*>(m_mappedData), m_mappedSize, error)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool LevelPack::openMemory(const void* data, size_t size, std::string* error) {
+    close();
+    if (!data || (reinterpret_cast<uintptr_t>(data) & 3) != 0) {
+        return fail(error, "level pack data must be 4-byte aligned");
+    }
+    return attach(static_cast<const uint8_t*>(data), size, error);
+}
+
+void LevelPack::close() {
+    m_header = nullptr;
+    m_entries = nullptr;
+    m_cards = nullptr;
+
+#ifdef _WIN32
+    if (m_mappedData) {
+        UnmapViewOfFile(m_mappedData);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_mappedData) {
+        munmap(m_mappedData, m_mappedSize);
+    }
+#endif
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+}
+
+bool LevelPack::decodeLevel(int index, LevelConfig& level) const {
+    level.stack.clear();
+    level.playfield.clear();
+    level.ruleSet = RST_CLASSIC;
+    if (index < 0 || index >= getLevelCount()) {
+        return false;
+    }
+
+    const LevelPackEntry& entry = m_entries[index];
+    level.ruleSet = entry.ruleSet;
+    const LevelPackCard* cards = getCards(index);
+    level.stack.resize(entry.stackCount);
+    level.playfield.resize(entry.playfieldCount);
+    for (int i = 0; i < entry.stackCount + entry.playfieldCount; ++i) {
+        CardConfig& config = i < entry.stackCount ? level.stack[i] : level.playfield[i - entry.stackCount];
+        config.cardFace = cards[i].face;
+        config.cardSuit = cards[i].suit;
+        config.position = decodePosition(cards[i]);
+    }
+    return true;
+}
+
+bool LevelPack::attach(const uint8_t* data, size_t size, std::string* error) {
+    if (size < sizeof(LevelPackHeader)) {
+        return fail(error, "level pack is truncated");
+    }
+    const LevelPackHeader* header = reinterpret_cast<const LevelPackHeader*>(data);
+    if (header->magic != MAGIC) {
+        return fail(error, "not a level pack");
+    }
+    if (header->version != VERSION || header->cardRecordSize != sizeof(LevelPackCard)) {
+        return fail(error, "unsupported level pack version");
+    }
+    if (header->positionScale == 0) {
+        return fail(error, "level pack position scale is zero");
+    }
+
+    // 各段用64位计算范围，避免恶意的计数造成溢出
+    uint64_t indexEnd = static_cast<uint64_t>(header->indexOffset) +
+                        static_cast<uint64_t>(header->levelCount) * sizeof(LevelPackEntry);
+    uint64_t cardsEnd = static_cast<uint64_t>(header->cardsOffset) +
+                        static_cast<uint64_t>(header->cardCount) * sizeof(LevelPackCard);
+    if (header->indexOffset < sizeof(LevelPackHeader) || (header->indexOffset & 3) != 0 ||
+        (header->cardsOffset & 1) != 0 || indexEnd > size || cardsEnd > size) {
+        return fail(error, "level pack sections are out of range");
+    }
+
+    const LevelPackEntry* entries = reinterpret_cast<const LevelPackEntry*>(data + header->indexOffset);
+    for (uint32_t i = 0; i < header->levelCount; ++i) {
+        uint64_t end = static_cast<uint64_t>(entries[i].firstCard) + entries[i].stackCount + entries[i].playfieldCount;
+        if (end > header->cardCount) {
+            return fail(error, "level pack index points past the card records");
+        }
+        if (entries[i].ruleSet >= RST_NUM_RULE_SET_TYPES) {
+            return fail(error, "level pack entry has an unknown rule set");
+        }
+    }
+
+    m_header = header;
+    m_entries = entries;
+    m_cards = reinterpret_cast<const LevelPackCard*>(data + header->cardsOffset);
+    m_inverseScale = 1.0f / header->positionScale;
+    return true;
+}
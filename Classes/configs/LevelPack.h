@@ -0,0 +1,178 @@
+﻿#ifndef __LEVEL_PACK_H__
+#define __LEVEL_PACK_H__
+
+#include "LevelData.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct LevelPackHeader
+ * @brief 关卡包文件头
+ *
+ * 定长32字节，位于文件开头，之后依次是关卡索引和卡牌记录
+ */
+struct LevelPackHeader {
+    uint32_t magic;             ///< 文件标识
+    uint16_t version;           ///< 文件格式版本
+    uint16_t cardRecordSize;    ///< 每条卡牌记录的字节数
+    uint32_t levelCount;        ///< 关卡数量
+    uint32_t cardCount;         ///< 卡牌记录总数
+    uint32_t indexOffset;       ///< 关卡索引相对文件开头的偏移
+    uint32_t cardsOffset;       ///< 卡牌记录相对文件开头的偏移
+    uint32_t positionScale;     ///< 位置量化比例：记录中的坐标为像素坐标乘以该值后取整
+    uint32_t reserved;          ///< 保留，写为0
+};
+
+/**
+ * @struct LevelPackEntry
+ * @brief 关卡索引中的一项
+ *
+ * 一个关卡的卡牌记录连续存放：先是手牌堆叠，然后是牌桌卡牌，顺序与LevelConfig相同
+ */
+struct LevelPackEntry {
+    uint32_t firstCard;         ///< 第一条卡牌记录的下标
+    uint8_t stackCount;         ///< 手牌堆叠的卡牌数
+    uint8_t playfieldCount;     ///< 牌桌卡牌数
+    uint8_t ruleSet;            ///< 规则集（RuleSetType），旧文件中为0即经典规则
+    uint8_t reserved;           ///< 保留，写为0
+};
+
+/**
+ * @struct LevelPackCard
+ * @brief 定长的卡牌记录
+ */
+struct LevelPackCard {
+    uint8_t face;               ///< 牌面
+    uint8_t suit;               ///< 花色
+    int16_t x;                  ///< 量化后的x坐标
+    int16_t y;                  ///< 量化后的y坐标
+};
+
+static_assert(sizeof(LevelPackHeader) == 32, "LevelPackHeader must stay 32 bytes");
+static_assert(sizeof(LevelPackEntry) == 8, "LevelPackEntry must stay 8 bytes");
+static_assert(sizeof(LevelPackCard) == 6, "LevelPackCard must stay 6 bytes");
+
+/**
+ * @class LevelPack
+ * @brief 二进制关卡包
+ *
+ * 把大量关卡存进一个文件：文件头、按关卡下标排列的定长索引、定长卡牌记录
+ * 打开时对文件做内存映射，并一次性校验文件头和整个索引的范围；
+ * 之后按下标取关卡只是指针运算，卡牌记录直接从映射的内存中读取，不做任何复制
+ *
+ * 坐标按positionScale量化为16位整数，默认每像素4个单位，可表示正负8191像素以内的位置
+ * 文件按小端字节序存放，与游戏支持的所有平台一致
+ *
+ * 职责：
+ * - 由关卡配置生成关卡包数据
+ * - 映射并校验关卡包文件
+ * - 按下标读取关卡的卡牌记录或还原为关卡配置
+ *
+ * 使用场景：
+ * - level_packer工具把关卡JSON转换成关卡包
+ * - GameService::loadLevel直接从关卡包记录创建卡牌
+ */
+class LevelPack {
+public:
+    static const uint32_t MAGIC = 0x504C4743;        ///< 文件标识"CGLP"
+    static const uint16_t VERSION = 1;               ///< 当前文件格式版本
+    static const uint32_t DEFAULT_POSITION_SCALE = 4; ///< 默认位置量化比例（每像素单位数）
+
+    LevelPack();
+    ~LevelPack();
+
+    /**
+     * @brief 由关卡配置生成关卡包数据
+     *
+     * @param levels 关卡配置，按下标顺序写入
+     * @param out 输出数据，会先被清空
+     * @param error 失败时输出错误描述，可为空
+     * @return 全部关卡都能装入关卡包返回true
+     */
+    static bool build(const std::vector<LevelConfig>& levels, std::vector<uint8_t>& out,
+                      std::string* error = nullptr);
+
+    /**
+     * @brief 内存映射并校验关卡包文件，之前打开的关卡包会先被关闭
+     *
+     * @param path 文件路径
+     * @param error 失败时输出错误描述，可为空
+     * @return 成功返回true
+     */
+    bool openFile(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief 校验并使用已在内存中的关卡包数据，不复制
+     *
+     * @param data 关卡包数据，需4字节对齐，关闭前须保持有效
+     * @param size 数据字节数
+     * @param error 失败时输出错误描述，可为空
+     * @return 成功返回true
+     */
+    bool openMemory(const void* data, size_t size, std::string* error = nullptr);
+
+    /**
+     * @brief 关闭关卡包，解除内存映射
+     */
+    void close();
+
+    /**
+     * @brief 检查是否已打开
+     */
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * @brief 获取关卡数量
+     */
+    int getLevelCount() const { return m_header ? static_cast<int>(m_header->levelCount) : 0; }
+
+    /**
+     * @brief 获取关卡的索引项，调用前需确认下标有效
+     */
+    const LevelPackEntry& getEntry(int index) const { return m_entries[index]; }
+
+    /**
+     * @brief 获取关卡的第一条卡牌记录（手牌堆叠在前，牌桌卡牌在后），调用前需确认下标有效
+     */
+    const LevelPackCard* getCards(int index) const { return m_cards + m_entries[index].firstCard; }
+
+    /**
+     * @brief 将量化坐标还原为像素坐标
+     */
+    GameVec2 decodePosition(const LevelPackCard& card) const {
+        return GameVec2(card.x * m_inverseScale, card.y * m_inverseScale);
+    }
+
+    /**
+     * @brief 将关卡还原为关卡配置
+     *
+     * @param index 关卡下标
+     * @param level 输出的关卡配置，会先被清空
+     * @return 下标有效返回true
+     */
+    bool decodeLevel(int index, LevelConfig& level) const;
+
+private:
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    /**
+     * @brief 校验文件头和索引并设置各段指针
+     */
+    bool attach(const uint8_t* data, size_t size, std::string* error);
+
+    const LevelPackHeader* m_header;    ///< 文件头，未打开时为空
+    const LevelPackEntry* m_entries;    ///< 关卡索引
+    const LevelPackCard* m_cards;       ///< 卡牌记录
+    float m_inverseScale;               ///< 位置量化比例的倒数
+    void* m_mappedData;                 ///< 内存映射的起始地址，使用外部内存时为空
+    size_t m_mappedSize;                ///< 内存映射的字节数
+#ifdef _WIN32
+    void* m_fileHandle;                 ///< 文件句柄
+    void* m_mappingHandle;              ///< 映射对象句柄
+#endif
+};
+
+#endif // __LEVEL_PACK_H__
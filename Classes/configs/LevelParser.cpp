@@ -0,0 +1,512 @@
+﻿#include "LevelParser.h"
+#include "CardTypes.h"
+#include "json/reader.h"
+#include "json/error/en.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief 记录行列号的输入流包装
+ *
+ * 转发rapidjson所需的读取和原位写入接口，读取时统计换行，
+ * 出错时的行列号对应原文位置，不受原位解析改写字符串内容的影响
+ */
+template <typename Stream>
+class LineCountingStream {
+public:
+    typedef typename Stream::Ch Ch;
+
+    explicit LineCountingStream(Stream& stream) : m_stream(stream), m_line(1), m_lineStart(0) {}
+
+    Ch Peek() const { return m_stream.Peek(); }
+    Ch Take() {
+        Ch c = m_stream.Take();
+        if (c == '\n') {
+            ++m_line;
+            m_lineStart = m_stream.Tell();
+        }
+        return c;
+    }
+    size_t Tell() const { return m_stream.Tell(); }
+
+    Ch* PutBegin() { return m_stream.PutBegin(); }
+    void Put(Ch c) { m_stream.Put(c); }
+    void Flush() { m_stream.Flush(); }
+    size_t PutEnd(Ch* begin) { return m_stream.PutEnd(begin); }
+
+    size_t getLine() const { return m_line; }
+    size_t getColumn() const { return m_stream.Tell() - m_lineStart + 1; }
+
+private:
+    Stream& m_stream;
+    size_t m_line;          ///< 当前行号，从1开始
+    size_t m_lineStart;     ///< 当前行首的偏移
+};
+
+/**
+ * @brief 边解析边校验的关卡SAX处理器
+ *
+ * 不构建DOM，每个事件到来时立即检查它在关卡结构中的位置和取值，卡牌直接写入关卡配置
+ * 结构：根对象中可选的Playfield和Stack数组，数组元素为卡牌对象，
+ * 卡牌必须有整数CardFace（0-12）和CardSuit（0-3），可选的Position对象中x、y为数值且在坐标范围内；
+ * 根对象中可选的Rules为规则集名称
+ * 未知的键连同其值整体跳过，便于以后增加字段
+ */
+class LevelSchemaHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, LevelSchemaHandler> {
+public:
+    explicit LevelSchemaHandler(LevelConfig& level)
+        : m_level(level)
+        , m_state(PS_ROOT_START)
+        , m_field(CF_NONE)
+        , m_section(nullptr)
+        , m_sectionName("")
+        , m_skipDepth(0)
+        , m_skipReturn(PS_ROOT)
+        , m_seenSections(0)
+        , m_seenFields(0) {
+    }
+
+    bool Null() { return scalar("null"); }
+    bool Bool(bool) { return scalar("a boolean"); }
+    bool Int(int value) { return integer(value); }
+    bool Uint(unsigned value) { return integer(value); }
+    bool Int64(int64_t value) { return integer(value); }
+    bool Uint64(uint64_t value) {
+        const uint64_t maxValue = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        return integer(static_cast<int64_t>(value > maxValue ? maxValue : value));
+    }
+    bool Double(double value) { return number(value, false, 0); }
+    bool String(const char* value, rapidjson::SizeType length, bool) {
+        if (m_state == PS_RULES) {
+            return ruleSet(value, length);
+        }
+        return scalar("a string");
+    }
+
+    bool StartObject() {
+        switch (m_state) {
+            case PS_ROOT_START:
+                m_state = PS_ROOT;
+                return true;
+            case PS_SECTION:
+                m_section->push_back(CardConfig());
+                m_seenFields = 0;
+                m_field = CF_NONE;
+                m_state = PS_CARD;
+                return true;
+            case PS_FIELD_VALUE:
+                if (m_field == CF_POSITION) {
+                    m_state = PS_POSITION;
+                    return true;
+                }
+                return fieldTypeError("an object");
+            case PS_SKIP:
+                ++m_skipDepth;
+                return true;
+            default:
+                return unexpected("an object");
+        }
+    }
+
+    bool Key(const char* key, rapidjson::SizeType length, bool) {
+        switch (m_state) {
+            case PS_ROOT:
+                return rootKey(key, length);
+            case PS_CARD:
+                return cardKey(key, length);
+            case PS_POSITION:
+                return positionKey(key, length);
+            default:
+                return true;    // 跳过中的对象
+        }
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        switch (m_state) {
+            case PS_ROOT:
+                m_state = PS_DONE;
+                return true;
+            case PS_CARD:
+                m_field = CF_NONE;
+                if (!(m_seenFields & (1 << CF_FACE))) {
+                    return fail("missing CardFace");
+                }
+                if (!(m_seenFields & (1 << CF_SUIT))) {
+                    return fail("missing CardSuit");
+                }
+                m_state = PS_SECTION;
+                return true;
+            case PS_POSITION:
+                m_field = CF_NONE;
+                m_state = PS_CARD;
+                return true;
+            case PS_SKIP:
+                return endSkipped();
+            default:
+                return unexpected("the end of an object");
+        }
+    }
+
+    bool StartArray() {
+        switch (m_state) {
+            case PS_SECTION_START:
+                m_state = PS_SECTION;
+                return true;
+            case PS_SKIP:
+                ++m_skipDepth;
+                return true;
+            case PS_FIELD_VALUE:
+                return fieldTypeError("an array");
+            default:
+                return unexpected("an array");
+        }
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        switch (m_state) {
+            case PS_SECTION:
+                m_section = nullptr;
+                m_state = PS_ROOT;
+                return true;
+            case PS_SKIP:
+                return endSkipped();
+            default:
+                return unexpected("the end of an array");
+        }
+    }
+
+    /**
+     * @brief 获取校验失败的描述（含JSON路径）
+     */
+    const std::string& getError() const { return m_error; }
+
+private:
+    enum ParseState {
+        PS_ROOT_START,      ///< 等待根对象
+        PS_ROOT,            ///< 根对象中，等待键或结束
+        PS_SECTION_START,   ///< Playfield或Stack之后，等待数组
+        PS_RULES,           ///< Rules之后，等待规则集名称
+        PS_SECTION,         ///< 卡牌数组中，等待卡牌对象或结束
+        PS_CARD,            ///< 卡牌对象中，等待键或结束
+        PS_FIELD_VALUE,     ///< 卡牌字段或坐标分量之后，等待其值
+        PS_POSITION,        ///< Position对象中，等待键或结束
+        PS_SKIP,            ///< 跳过未知键的值
+        PS_DONE             ///< 根对象已结束
+    };
+
+    enum CardField {
+        CF_NONE,
+        CF_FACE,
+        CF_SUIT,
+        CF_POSITION,
+        CF_X,
+        CF_Y
+    };
+
+    static bool keyIs(const char* key, rapidjson::SizeType length, const char* name) {
+        return std::strlen(name) == length && std::memcmp(key, name, length) == 0;
+    }
+
+    bool rootKey(const char* key, rapidjson::SizeType length) {
+        int bit = 0;
+        if (keyIs(key, length, "Playfield")) {
+            m_section = &m_level.playfield;
+            m_sectionName = "Playfield";
+            bit = 1;
+        } else if (keyIs(key, length, "Stack")) {
+            m_section = &m_level.stack;
+            m_sectionName = "Stack";
+            bit = 2;
+        } else if (keyIs(key, length, "Rules")) {
+            bit = 4;
+        } else {
+            return skipValue(PS_ROOT);
+        }
+        m_state = bit == 4 ? PS_RULES : PS_SECTION_START;
+        if (m_seenSections & bit) {
+            return fail("duplicate key");
+        }
+        m_seenSections |= bit;
+        return true;
+    }
+
+    bool ruleSet(const char* name, rapidjson::SizeType length) {
+        RuleSetType type;
+        if (!RuleSetNames::findByName(name, length, type)) {
+            return fail("unknown rule set \"" + std::string(name, length) + "\"");
+        }
+        m_level.ruleSet = type;
+        m_state = PS_ROOT;
+        return true;
+    }
+
+    bool cardKey(const char* key, rapidjson::SizeType length) {
+        if (keyIs(key, length, "CardFace")) {
+            return field(CF_FACE);
+        }
+        if (keyIs(key, length, "CardSuit")) {
+            return field(CF_SUIT);
+        }
+        if (keyIs(key, length, "Position")) {
+            return field(CF_POSITION);
+        }
+        return skipValue(PS_CARD);
+    }
+
+    bool positionKey(const char* key, rapidjson::SizeType length) {
+        if (keyIs(key, length, "x")) {
+            return field(CF_X);
+        }
+        if (keyIs(key, length, "y")) {
+            return field(CF_Y);
+        }
+        return skipValue(PS_POSITION);
+    }
+
+    bool field(CardField field) {
+        m_field = field;
+        if (m_seenFields & (1 << field)) {
+            return fail("duplicate key");
+        }
+        m_seenFields |= 1 << field;
+        m_state = PS_FIELD_VALUE;
+        return true;
+    }
+
+    bool skipValue(ParseState returnState) {
+        m_skipReturn = returnState;
+        m_skipDepth = 0;
+        m_state = PS_SKIP;
+        return true;
+    }
+
+    bool endSkipped() {
+        if (--m_skipDepth == 0) {
+            m_state = m_skipReturn;
+        }
+        return true;
+    }
+
+    bool scalar(const char* what) {
+        if (m_state == PS_SKIP) {
+            if (m_skipDepth == 0) {
+                m_state = m_skipReturn;
+            }
+            return true;
+        }
+        if (m_state == PS_FIELD_VALUE) {
+            return fieldTypeError(what);
+        }
+        return unexpected(what);
+    }
+
+    bool integer(int64_t value) {
+        return number(static_cast<double>(value), true, value);
+    }
+
+    bool number(double value, bool isInteger, int64_t integerValue) {
+        if (m_state != PS_FIELD_VALUE) {
+            return scalar("a number");
+        }
+
+        CardConfig& card = m_section->back();
+        switch (m_field) {
+            case CF_FACE:
+                if (!isInteger) {
+                    return fieldTypeError("a non-integer number");
+                }
+                if (integerValue < 0 || integerValue >= CFT_NUM_CARD_FACE_TYPES) {
+                    return fail("face " + std::to_string(integerValue) + " is out of range 0-" +
+                                std::to_string(CFT_NUM_CARD_FACE_TYPES - 1));
+                }
+                card.cardFace = static_cast<int>(integerValue);
+                m_state = PS_CARD;
+                return true;
+            case CF_SUIT:
+                if (!isInteger) {
+                    return fieldTypeError("a non-integer number");
+                }
+                if (integerValue < 0 || integerValue >= CST_NUM_CARD_SUIT_TYPES) {
+                    return fail("suit " + std::to_string(integerValue) + " is out of range 0-" +
+                                std::to_string(CST_NUM_CARD_SUIT_TYPES - 1));
+                }
+                card.cardSuit = static_cast<int>(integerValue);
+                m_state = PS_CARD;
+                return true;
+            case CF_X:
+            case CF_Y:
+                if (!(value >= -LevelParser::POSITION_LIMIT && value <= LevelParser::POSITION_LIMIT)) {
+                    char buffer[96];
+                    std::snprintf(buffer, sizeof(buffer), "coordinate %g is out of range -%g to %g",
+                                  value, LevelParser::POSITION_LIMIT, LevelParser::POSITION_LIMIT);
+                    return fail(buffer);
+                }
+                (m_field == CF_X ? card.position.x : card.position.y) = static_cast<float>(value);
+                m_state = PS_POSITION;
+                return true;
+            default:
+                return fieldTypeError("a number");
+        }
+    }
+
+    bool fieldTypeError(const char* what) {
+        const char* expected = m_field == CF_POSITION ? "an object" : (m_field == CF_X || m_field == CF_Y) ? "a number" : "an integer";
+        return fail(std::string("expected ") + expected + ", found " + what);
+    }
+
+    bool unexpected(const char* what) {
+        switch (m_state) {
+            case PS_ROOT_START:
+                return fail(std::string("the root must be an object, found ") + what);
+            case PS_SECTION_START:
+                return fail(std::string("expected an array of cards, found ") + what);
+            case PS_RULES:
+                return fail(std::string("expected a rule set name, found ") + what);
+            case PS_SECTION:
+                return fail(std::string("expected a card object, found ") + what);
+            default:
+                return fail(std::string("unexpected ") + what);
+        }
+    }
+
+    /**
+     * @brief 记录带JSON路径的错误并中止解析
+     */
+    bool fail(const std::string& message) {
+        if (m_state == PS_ROOT_START || m_state == PS_ROOT) {
+            m_error = message;
+            return false;
+        }
+        if (m_state == PS_RULES) {
+            m_error = "Rules: " + message;
+            return false;
+        }
+        // 卡牌数组中出错的是下一个元素，卡牌对象中出错的是最后一张卡牌
+        m_error = m_sectionName;
+        if (m_state == PS_SECTION) {
+            m_error += "[" + std::to_string(m_section->size()) + "]";
+        } else if (m_state != PS_SECTION_START) {
+            m_error += "[" + std::to_string(m_section->size() - 1) + "]";
+        }
+        switch (m_field) {
+            case CF_FACE:
+                m_error += ".CardFace";
+                break;
+            case CF_SUIT:
+                m_error += ".CardSuit";
+                break;
+            case CF_POSITION:
+                m_error += ".Position";
+                break;
+            case CF_X:
+                m_error += ".Position.x";
+                break;
+            case CF_Y:
+                m_error += ".Position.y";
+                break;
+            default:
+                break;
+        }
+        m_error += ": " + message;
+        return false;
+    }
+
+    LevelConfig& m_level;
+    ParseState m_state;
+    CardField m_field;                      ///< 当前卡牌中最近的字段
+    std::vector<CardConfig>* m_section;     ///< 当前写入的卡牌数组
+    const char* m_sectionName;              ///< 当前卡牌数组的键名
+    int m_skipDepth;                        ///< 跳过的值中嵌套的层数
+    ParseState m_skipReturn;                ///< 跳过结束后回到的状态
+    int m_seenSections;                     ///< 已出现的卡牌数组
+    int m_seenFields;                       ///< 当前卡牌已出现的字段
+    std::string m_error;
+};
+
+/**
+ * @brief 用SAX处理器解析并校验关卡
+ */
+template <unsigned parseFlags, typename Stream>
+bool parseWithSchema(Stream& stream, LevelConfig& level, std::string* error) {
+    level.playfield.clear();
+    level.stack.clear();
+    level.ruleSet = RST_CLASSIC;
+
+    LineCountingStream<Stream> counted(stream);
+    LevelSchemaHandler handler(level);
+    rapidjson::Reader reader;
+    rapidjson::ParseResult result = reader.Parse<parseFlags>(counted, handler);
+    if (result) {
+        return true;
+    }
+
+    if (error) {
+        const char* message = result.Code() == rapidjson::kParseErrorTermination
+            ? handler.getError().c_str() : rapidjson::GetParseError_En(result.Code());
+        char location[64];
+        std::snprintf(location, sizeof(location), "line %u, column %u: ",
+                      static_cast<unsigned int>(counted.getLine()), static_cast<unsigned int>(counted.getColumn()));
+        *error = location;
+        *error += message;
+    }
+    level.playfield.clear();
+    level.stack.clear();
+    level.ruleSet = RST_CLASSIC;
+    return false;
+}
+
+/**
+ * @brief 写出一组卡牌配置
+ */
+void serializeCards(const char* name, const std::vector<CardConfig>& cards, std::string& json) {
+    char buffer[160];
+    json += "    \"";
+    json += name;
+    json += "\": [";
+    for (size_t i = 0; i < cards.size(); i++) {
+        const CardConfig& card = cards[i];
+        std::snprintf(buffer, sizeof(buffer),
+                      "%s\n        {\n"
+                      "            \"CardFace\": %d,\n"
+                      "            \"CardSuit\": %d,\n"
+                      "            \"Position\": {\"x\": %g, \"y\": %g}\n"
+                      "        }",
+                      i == 0 ? "" : ",", card.cardFace, card.cardSuit, card.position.x, card.position.y);
+        json += buffer;
+    }
+    json += cards.empty() ? "]" : "\n    ]";
+}
+
+} // namespace
+
+const float LevelParser::POSITION_LIMIT = 8191.0f;
+
+bool LevelParser::parse(const std::string& json, LevelConfig& level, std::string* error) {
+    rapidjson::StringStream stream(json.c_str());
+    return parseWithSchema<rapidjson::kParseDefaultFlags>(stream, level, error);
+}
+
+bool LevelParser::parseInsitu(char* json, LevelConfig& level, std::string* error) {
+    rapidjson::InsituStringStream stream(json);
+    return parseWithSchema<rapidjson::kParseInsituFlag>(stream, level, error);
+}
+
+void LevelParser::serialize(const LevelConfig& level, std::string& json) {
+    json.clear();
+    json += "{\n";
+    // 经典规则不写出，与之前生成的关卡文件保持一致
+    const char* ruleSetName = RuleSetNames::getName(level.ruleSet);
+    if (level.ruleSet != RST_CLASSIC && ruleSetName) {
+        json += "    \"Rules\": \"";
+        json += ruleSetName;
+        json += "\",\n";
+    }
+    serializeCards("Playfield", level.playfield, json);
+    json += ",\n";
+    serializeCards("Stack", level.stack, json);
+    json += "\n}\n";
+}
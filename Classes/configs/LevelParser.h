@@ -0,0 +1,61 @@
+﻿#ifndef __LEVEL_PARSER_H__
+#define __LEVEL_PARSER_H__
+
+#include "LevelData.h"
+#include <string>
+
+/**
+ * @class LevelParser
+ * @brief 关卡JSON解析器
+ *
+ * 负责关卡JSON与LevelConfig之间的转换
+ * 只依赖rapidjson，不读写文件；游戏通过LevelConfigManager读取资源后调用，
+ * 命令行工具自行读写文件
+ *
+ * 解析使用rapidjson的SAX接口，不构建DOM：每个值到来时立即按关卡结构校验类型和范围，
+ * 卡牌直接写入关卡配置，不需要第二遍遍历；出错时报告行列号和JSON路径，
+ * 如"line 12, column 27: Playfield[3].CardFace: face 14 is out of range 0-12"
+ * 关卡结构：根对象中可选的Playfield和Stack卡牌数组；卡牌必须有整数CardFace和CardSuit，
+ * 可选的Position对象中x、y为数值；可选的Rules为规则集名称（见RuleSetNames），默认为经典规则；未知的键被忽略
+ */
+class LevelParser {
+public:
+    /**
+     * @brief 解析关卡JSON
+     *
+     * @param json 关卡JSON文本
+     * @param level 输出的关卡配置，会先被清空
+     * @param error 解析失败时输出错误描述，可为空
+     * @return 解析成功返回true
+     */
+    static bool parse(const std::string& json, LevelConfig& level, std::string* error = nullptr);
+
+    /**
+     * @brief 原位解析关卡JSON
+     *
+     * 字符串直接在输入缓冲区中解码，除关卡配置本身外不再分配与文件大小相关的内存
+     * @param json 以'\0'结尾的关卡JSON文本，解析后内容被改写
+     * @param level 输出的关卡配置，会先被清空，失败时保持为空
+     * @param error 解析失败时输出错误描述，可为空
+     * @return 解析成功返回true
+     */
+    static bool parseInsitu(char* json, LevelConfig& level, std::string* error = nullptr);
+
+    /**
+     * @brief 把关卡配置写成与手工关卡相同格式的JSON
+     *
+     * @param level 关卡配置
+     * @param json 输出的JSON文本，会先被清空；批量生成时复用同一个字符串可避免重复分配
+     */
+    static void serialize(const LevelConfig& level, std::string& json);
+
+    static const float POSITION_LIMIT;  ///< 坐标绝对值上限（像素），与关卡包的量化范围一致
+
+private:
+    LevelParser() = delete;
+    ~LevelParser() = delete;
+    LevelParser(const LevelParser&) = delete;
+    LevelParser& operator=(const LevelParser&) = delete;
+};
+
+#endif // __LEVEL_PARSER_H__
@@ -0,0 +1,75 @@
+﻿#ifndef __RULE_SET_TYPE_H__
+#define __RULE_SET_TYPE_H__
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @file RuleSetType.h
+ * @brief 关卡规则集类型定义文件
+ *
+ * 每个关卡选用一套规则集，决定哪些牌面可以匹配以及每次匹配的得分
+ * 关卡JSON中以名称保存，关卡包和核心状态中以枚举值保存
+ */
+
+/**
+ * @enum RuleSetType
+ * @brief 关卡规则集类型枚举
+ *
+ * 枚举值写入关卡包和核心状态，只能在末尾追加
+ */
+enum RuleSetType
+{
+    RST_CLASSIC,                ///< 经典规则：牌面相差1
+    RST_WRAPAROUND,             ///< 首尾相接：牌面相差1，K与A也可匹配
+    RST_SAME_SUIT,              ///< 同花色：牌面相差1且花色相同
+    RST_BONUS,                  ///< 奖励关：牌面相差不超过2，同花色匹配额外得分
+    RST_NUM_RULE_SET_TYPES      ///< 规则集类型总数，用于遍历和验证
+};
+
+/**
+ * @class RuleSetNames
+ * @brief 规则集名称与枚举值的转换
+ */
+class RuleSetNames {
+public:
+    /**
+     * @brief 获取规则集名称，无效的类型返回nullptr
+     */
+    static const char* getName(int type) {
+        static const char* const NAMES[RST_NUM_RULE_SET_TYPES] = {
+            "classic",
+            "wraparound",
+            "same_suit",
+            "bonus"
+        };
+        return type >= 0 && type < RST_NUM_RULE_SET_TYPES ? NAMES[type] : nullptr;
+    }
+
+    /**
+     * @brief 按名称查找规则集
+     *
+     * @param name 名称，不要求以'\0'结尾
+     * @param length 名称长度
+     * @param type 输出的规则集类型
+     * @return 找到返回true
+     */
+    static bool findByName(const char* name, size_t length, RuleSetType& type) {
+        for (int i = 0; i < RST_NUM_RULE_SET_TYPES; ++i) {
+            const char* candidate = getName(i);
+            if (std::strlen(candidate) == length && std::memcmp(candidate, name, length) == 0) {
+                type = static_cast<RuleSetType>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    RuleSetNames() = delete;
+    ~RuleSetNames() = delete;
+    RuleSetNames(const RuleSetNames&) = delete;
+    RuleSetNames& operator=(const RuleSetNames&) = delete;
+};
+
+#endif // __RULE_SET_TYPE_H__
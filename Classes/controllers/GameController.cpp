@@ -1,28 +1,50 @@
 ﻿#include "GameController.h"
 #include "../views/GameView.h"
 #include "../managers/UndoManager.h"
+#include "../managers/ScoringEngine.h"
+#include "../managers/GameContext.h"
+#include "../managers/MoveLog.h"
+#include "../managers/HintCache.h"
 #include "../services/GameService.h"
 #include "../utils/GameUtils.h"
 #include <algorithm>
+#include <climits>
 
 USING_NS_CC;
 
+// 后台提示的前瞻步数和时间预算（微秒）
+static const int ASYNC_HINT_MAX_DEPTH = 8;
+static const int ASYNC_HINT_TIME_BUDGET_MICROS = 20000;
+
+// 实时输入回放在调度器中的键
+static const char* INPUT_REPLAY_SCHEDULE_KEY = "input_replay";
+
 // 构造函数
 GameController::GameController()
-    : m_gameModel(nullptr), m_gameView(nullptr), m_undoManager(nullptr) {
+    : m_gameContext(nullptr), m_gameModel(nullptr), m_gameView(nullptr), m_undoManager(nullptr)
+    , m_scoringEngine(nullptr), m_moveLog(nullptr)
+    , m_inputRecorder(nullptr)
+    , m_hintCache(std::make_shared<HintCache>())
+    , m_aliveToken(std::make_shared<int>(0))
+    , m_hintRequestId(1), m_pendingHintRequestId(0)
+    , m_replayCursor(0), m_replayFrame(0), m_replaying(false) {
 }
 
 // 析构函数
 GameController::~GameController() {
+    stopInputReplay();
 }
 
 // 初始化控制器
-bool GameController::init(GameModel* model, GameView* view) {
-    if (!model || !view) {
+bool GameController::init(GameContext* context, GameView* view) {
+    if (!context || !view) {
         return false;
     }
     
-    m_gameModel = model;
+    m_gameContext = context;
+    m_gameModel = &context->getModel();
+    m_undoManager = &context->getUndoManager();
+    m_scoringEngine = &context->getScoringEngine();
     m_gameView = view;
     
     return true;
@@ -30,65 +52,233 @@ bool GameController::init(GameModel* model, GameView* view) {
 
 // 处理手牌点击
 void GameController::onHandCardClicked(int cardId) {
-    if (!m_gameModel || m_gameModel->isGameOver) {
-        return;
+    handlePlayerInput(IO_HAND_CLICK, cardId);
+}
+
+// 处理牌桌卡牌点击
+void GameController::onPlayfieldCardClicked(int cardId) {
+    handlePlayerInput(IO_PLAYFIELD_CLICK, cardId);
+}
+
+// 处理撤销按钮点击
+void GameController::onUndoButtonClicked() {
+    handlePlayerInput(IO_UNDO, 0);
+}
+
+// 处理重做按钮点击
+void GameController::onRedoButtonClicked() {
+    handlePlayerInput(IO_REDO, 0);
+}
+
+// 处理一次玩家点击
+void GameController::handlePlayerInput(InputOp op, int cardId) {
+    if (!m_replaying) {
+        handleInput(op, cardId, Director::getInstance()->getTotalFrames());
+    }
+}
+
+// 处理一次输入
+bool GameController::handleInput(InputOp op, int cardId, uint32_t frame) {
+    if (!m_gameModel) {
+        return false;
     }
     
-    // 保存状态用于撤销
-    if (m_undoManager) {
-        m_undoManager->saveState();
+    // 先录制再应用，被规则拒绝的点击也要录下来
+    if (m_inputRecorder && !m_replaying) {
+        m_inputRecorder->record(frame, op, cardId);
     }
     
-    // 使用GameService处理业务逻辑
-    if (GameService::executeHandCardReplacement(m_gameModel, cardId)) {
-        // 触发动画
-        if (m_gameView) {
-            m_gameView->animateHandCardToTop(cardId);
-        }
-        refreshView();
+    // 使用GameService处理业务逻辑，成功的操作由其记录到撤销管理器；被拒绝的点击也要计分
+    MoveRecord record;
+    bool applied = GameService::applyInput(m_gameModel, m_undoManager, op, cardId, &record);
+    if (m_scoringEngine) {
+        m_scoringEngine->onInput(op, applied, record, *m_gameModel, frame);
+    }
+    if (!applied) {
+        return false;
+    }
+    
+    switch (op) {
+        case IO_HAND_CLICK:
+            if (m_moveLog) {
+                m_moveLog->append(MLO_HAND_REPLACE, cardId);
+            }
+            break;
+        case IO_PLAYFIELD_CLICK:
+            if (m_moveLog) {
+                m_moveLog->append(MLO_PLAYFIELD_MATCH, cardId);
+            }
+            break;
+        case IO_UNDO:
+            if (m_moveLog) {
+                m_moveLog->append(MLO_UNDO, 0);
+            }
+            break;
+        case IO_REDO:
+            if (m_moveLog) {
+                m_moveLog->append(MLO_REDO, 0);
+            }
+            break;
+        default:
+            break;
+    }
+    
+    // 模型已是最新状态，视图以动画过渡过去；前面的卡牌仍在飞行时直接转向新的落点
+    refreshView(true);
+    
+    // 撤销只会让对局回到未结束的状态
+    if (op != IO_UNDO) {
         checkGameEnd();
     }
+    return true;
 }
 
-// 处理牌桌卡牌点击
-void GameController::onPlayfieldCardClicked(int cardId) {
+// 处理提示按钮点击
+void GameController::onHintButtonClicked() {
     if (!m_gameModel || m_gameModel->isGameOver) {
         return;
     }
     
-    // Save state for undo
+    // 当前状态的提示已在计算中，结果回来时会高亮
+    if (m_pendingHintRequestId == m_hintRequestId) {
+        return;
+    }
+    requestHint();
+}
+
+// 刷新视图
+void GameController::refreshView(bool animate) {
+    if (m_gameView) {
+        m_gameModel->exportHandCards(m_handCardScratch);
+        m_gameModel->exportPlayfieldCards(m_playfieldCardScratch);
+        m_gameView->updateCards(m_handCardScratch, m_playfieldCardScratch, animate);
+    }
+    
+    // 状态已变化，进行中的提示结果作废；序号0表示没有进行中的请求，回绕时跳过
+    if (++m_hintRequestId == 0) {
+        m_hintRequestId = 1;
+    }
+}
+
+// 设置操作日志
+void GameController::setMoveLog(MoveLog* moveLog) {
+    m_moveLog = moveLog;
+}
+
+// 重放日志条目
+bool GameController::replayLoggedMove(const MoveLogEntry& entry) {
+    if (!m_gameModel) {
+        return false;
+    }
+    
+    InputOp op;
+    switch (entry.op) {
+        case MLO_HAND_REPLACE:
+            op = IO_HAND_CLICK;
+            break;
+        case MLO_PLAYFIELD_MATCH:
+            op = IO_PLAYFIELD_CLICK;
+            break;
+        case MLO_UNDO:
+            op = IO_UNDO;
+            break;
+        case MLO_REDO:
+            op = IO_REDO;
+            break;
+        default:
+            return false;
+    }
+    
+    // 与玩家输入经由同一个applyInput，游戏结束后的限制和结束标志的更新都与对局时一致
+    MoveRecord record;
+    if (!GameService::applyInput(m_gameModel, m_undoManager, op, entry.cardId, &record)) {
+        return false;
+    }
+    if (m_scoringEngine) {
+        m_scoringEngine->onInput(op, true, record, *m_gameModel, Director::getInstance()->getTotalFrames());
+    }
+    return true;
+}
+
+// 设置输入录制器
+void GameController::setInputRecorder(InputRecorder* recorder) {
+    m_inputRecorder = recorder;
+}
+
+// 开始输入回放
+bool GameController::startInputReplay(const InputRecording& recording, ReplaySpeed speed,
+                                      const std::function<void(const ReplayResult&)>& callback) {
+    stopInputReplay();
+    if (!ReplayService::matchesInitialState(m_gameModel, recording)) {
+        return false;
+    }
+    
+    // 撤销的结果取决于步数上限，需与录制时一致；计分按录制的帧序号重新计算
     if (m_undoManager) {
-        m_undoManager->saveState();
+        m_undoManager->clear();
+        m_undoManager->setMaxUndoSteps(recording.header.maxUndoSteps);
+    }
+    if (m_scoringEngine) {
+        ReplayService::prepareScoring(m_gameModel, recording, *m_scoringEngine);
     }
     
-    // 使用GameService处理业务逻辑
-    if (GameService::executePlayfieldCardMatch(m_gameModel, cardId)) {
-        // 触发动画
-        if (m_gameView) {
-            m_gameView->animatePlayfieldCardToHand(cardId);
-        }
-        refreshView();
-        checkGameEnd();
+    m_replayRecording = recording;
+    m_replayCursor = 0;
+    m_replayFrame = 0;
+    m_replayResult = ReplayResult();
+    m_replayCallback = callback;
+    m_replaying = true;
+    
+    if (speed == RS_MAX_SPEED) {
+        advanceInputReplay(UINT_MAX);
+        return true;
     }
+    
+    Director::getInstance()->getScheduler()->schedule([this](float) {
+        advanceInputReplay(m_replayFrame++);
+    }, this, 0.0f, false, INPUT_REPLAY_SCHEDULE_KEY);
+    return true;
 }
 
-// 处理撤销按钮点击
-void GameController::onUndoButtonClicked() {
-    if (m_undoManager && m_undoManager->canUndo()) {
-        m_undoManager->undo();
-        refreshView();
+// 中止输入回放
+void GameController::stopInputReplay() {
+    if (!m_replaying) {
+        return;
     }
+    m_replaying = false;
+    Director::getInstance()->getScheduler()->unschedule(INPUT_REPLAY_SCHEDULE_KEY, this);
 }
 
-// 刷新视图
-void GameController::refreshView() {
-    refreshHandView();
-    refreshPlayfieldView();
+// 推进输入回放
+void GameController::advanceInputReplay(uint32_t frame) {
+    const std::vector<InputEvent>& events = m_replayRecording.events;
+    while (m_replaying && m_replayCursor < events.size() && events[m_replayCursor].frame <= frame) {
+        const InputEvent& event = events[m_replayCursor++];
+        if (handleInput(static_cast<InputOp>(event.op), event.cardId, event.frame)) {
+            m_replayResult.appliedInputs++;
+        } else {
+            m_replayResult.rejectedInputs++;
+        }
+    }
+    
+    if (!m_replaying || m_replayCursor < events.size()) {
+        return;
+    }
+    
+    // 全部输入已应用，校验最终状态
+    stopInputReplay();
+    if (m_scoringEngine) {
+        ReplayService::verifyFinalState(m_gameModel, *m_scoringEngine, m_replayRecording, m_replayResult);
+    }
+    if (m_replayCallback) {
+        m_replayCallback(m_replayResult);
+    }
 }
 
-// 设置撤销管理器
-void GameController::setUndoManager(UndoManager* undoManager) {
-    m_undoManager = undoManager;
+// 会话恢复完成
+void GameController::onSessionRestored() {
+    refreshView();
+    checkGameEnd();
 }
 
 // 设置游戏结束回调
@@ -96,11 +286,18 @@ void GameController::setGameEndCallback(const std::function<void(bool)>& callbac
     m_gameEndCallback = callback;
 }
 
+// 清空提示缓存
+void GameController::clearHintCache() {
+    std::lock_guard<std::mutex> lock(m_hintCache->getMutex());
+    m_hintCache->clear();
+}
+
 // 开始新游戏
 void GameController::startNewGame() {
-    if (m_gameModel) {
-        m_gameModel->reset();
-        // TODO: 加载关卡数据
+    if (m_gameContext) {
+        // 按上下文中保存的关卡配置重新发牌
+        m_gameContext->loadLevel(m_gameContext->getLevelConfig(), m_gameModel->currentLevel);
+        clearHintCache();
         refreshView();
     }
 }
@@ -110,17 +307,44 @@ void GameController::resetGame() {
     startNewGame();
 }
 
-// 刷新手牌视图
-void GameController::refreshHandView() {
-    if (m_gameView) {
-        m_gameView->updateHandCards(m_gameModel->handCards);
-    }
+// 在后台计算提示
+void GameController::requestHint() {
+    unsigned int requestId = m_hintRequestId;
+    m_pendingHintRequestId = requestId;
+    
+    // 后台任务只使用核心状态的拷贝和共享的缓存，不触碰控制器本身
+    PackedGameState snapshot = m_gameModel->state;
+    std::shared_ptr<HintCache> cache = m_hintCache;
+    std::weak_ptr<int> alive = m_aliveToken;
+    
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER,
+        [this, snapshot, cache, alive, requestId]() {
+            HintOptions options;
+            options.maxDepth = ASYNC_HINT_MAX_DEPTH;
+            options.timeBudgetMicros = ASYNC_HINT_TIME_BUDGET_MICROS;
+            HintMove hint;
+            GameService::computeHint(snapshot, *cache, hint, options);
+            
+            Director::getInstance()->getScheduler()->performFunctionInCocosThread(
+                [this, alive, requestId, hint]() {
+                    if (!alive.expired()) {
+                        onHintReady(requestId, hint);
+                    }
+                });
+        });
 }
 
-// 刷新牌桌视图
-void GameController::refreshPlayfieldView() {
-    if (m_gameView) {
-        m_gameView->updatePlayfieldCards(m_gameModel->playfieldCards);
+// 提示计算完成
+void GameController::onHintReady(unsigned int requestId, const HintMove& hint) {
+    if (requestId == m_pendingHintRequestId) {
+        m_pendingHintRequestId = 0;
+    }
+    if (requestId != m_hintRequestId || !m_gameView) {
+        return;
+    }
+    
+    if (hint.isValid()) {
+        m_gameView->showHint(hint.handCardId, hint.playfieldCardId);
     }
 }
 
@@ -130,23 +354,8 @@ void GameController::checkGameEnd() {
         return;
     }
     
-    // 使用GameService检查游戏结束条件
-    int gameEndStatus = GameService::checkGameEndCondition(m_gameModel);
-    
-    if (gameEndStatus == 1) {
-        // 胜利
-        m_gameModel->isGameOver = true;
-        m_gameModel->isGameWon = true;
-        if (m_gameEndCallback) {
-            m_gameEndCallback(true);
-        }
-    } else if (gameEndStatus == -1) {
-        // 失败
-        m_gameModel->isGameOver = true;
-        m_gameModel->isGameWon = false;
-        if (m_gameEndCallback) {
-            m_gameEndCallback(false);
-        }
+    // 使用GameService检查并更新游戏结束标志，结束时通知场景
+    if (GameService::updateGameEndState(m_gameModel) != 0 && m_gameEndCallback) {
+        m_gameEndCallback(m_gameModel->isGameWon);
     }
-    // gameEndStatus == 0 时继续游戏
-}
\ No newline at end of file
+}
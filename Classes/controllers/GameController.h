@@ -3,11 +3,21 @@
 
 #include "cocos2d.h"
 #include "../models/GameModel.h"
+#include "../managers/MoveLog.h"
+#include "../models/HintMove.h"
+#include "../models/InputEvent.h"
+#include "../managers/InputRecording.h"
+#include "../services/ReplayService.h"
 #include <functional>
+#include <memory>
+#include <vector>
 
 // 前向声明
 class GameView;
+class GameContext;
 class UndoManager;
+class ScoringEngine;
+class HintCache;
 
 /**
  * @class GameController
@@ -23,6 +33,7 @@ class UndoManager;
  * - 协调模型数据更新和视图刷新
  * - 控制游戏的开始、重置和结束
  * - 管理撤销功能和游戏回调
+ * - 把每次输入的结果交给计分引擎
  * 
  * 使用场景：
  * - 作为游戏场景的核心控制组件
@@ -48,11 +59,12 @@ public:
     /**
      * @brief 初始化控制器
      * 
-     * @param model 游戏数据模型指针
+     * 控制器使用上下文中的游戏模型、撤销管理器和计分引擎，不持有上下文
+     * @param context 本局游戏的上下文指针
      * @param view 游戏视图指针
      * @return 初始化成功返回true，失败返回false
      */
-    bool init(GameModel* model, GameView* view);
+    bool init(GameContext* context, GameView* view);
     
     /**
      * @brief 处理手牌点击事件
@@ -73,19 +85,84 @@ public:
      */
     void onUndoButtonClicked();
     
+    /**
+     * @brief 处理重做按钮点击事件
+     */
+    void onRedoButtonClicked();
+    
+    /**
+     * @brief 处理提示按钮点击事件
+     * 
+     * 在后台线程按时间预算计算提示，结果回到主线程后高亮建议的卡牌
+     * 当前状态的提示已在计算中时不重复提交
+     */
+    void onHintButtonClicked();
+    
     /**
      * @brief 刷新游戏视图
      * 
-     * 根据当前游戏模型状态更新视图显示
+     * 根据当前游戏模型状态更新视图显示，并作废旧状态的提示请求
+     * @param animate 是否以动画过渡到新状态；开局和恢复会话时直接摆放
+     */
+    void refreshView(bool animate = false);
+    
+    /**
+     * @brief 设置操作日志
+     * 
+     * 设置后每步成功的操作、撤销和重做都会追加到日志中
+     * @param moveLog 操作日志指针，可为空
+     */
+    void setMoveLog(MoveLog* moveLog);
+    
+    /**
+     * @brief 重放一个日志条目
+     * 
+     * 与玩家操作经由同一个GameService::applyInput、撤销管理器和计分逻辑，但不刷新视图也不写日志
+     * 日志没有时间信息，恢复的操作按当前帧计分，时间奖励从恢复时算起
+     * @param entry 日志条目
+     * @return 成功应用返回true，条目与当前状态不一致返回false
+     */
+    bool replayLoggedMove(const MoveLogEntry& entry);
+    
+    /**
+     * @brief 设置输入录制器
+     * 
+     * 设置后玩家的每次点击（包括被规则拒绝的点击）都会连同帧序号记录下来
+     * @param recorder 输入录制器指针，可为空
+     */
+    void setInputRecorder(InputRecorder* recorder);
+    
+    /**
+     * @brief 在界面上回放一段输入录制
+     * 
+     * 录制的输入经由与玩家点击相同的处理路径应用，回放期间忽略玩家点击
+     * 实时回放按帧推进，每帧应用帧序号已到的输入；最快速度回放立即应用全部输入
+     * 回放结束后校验最终状态哈希和得分，并通过回调给出结果
+     * 
+     * @param recording 输入录制，模型须处于录制开始时的状态
+     * @param speed 回放速度
+     * @param callback 回放结束时的回调，可为空
+     * @return 初始状态与录制一致并开始回放返回true
+     */
+    bool startInputReplay(const InputRecording& recording, ReplaySpeed speed,
+                          const std::function<void(const ReplayResult&)>& callback);
+    
+    /**
+     * @brief 中止进行中的输入回放，不触发回调
+     */
+    void stopInputReplay();
+    
+    /**
+     * @brief 检查是否正在回放输入
      */
-    void refreshView();
+    bool isReplayingInput() const { return m_replaying; }
     
     /**
-     * @brief 设置撤销管理器
+     * @brief 会话恢复完成后调用
      * 
-     * @param undoManager 撤销管理器指针
+     * 刷新视图并检查恢复后的对局是否已经结束
      */
-    void setUndoManager(UndoManager* undoManager);
+    void onSessionRestored();
     
     /**
      * @brief 设置游戏结束回调函数
@@ -94,6 +171,13 @@ public:
      */
     void setGameEndCallback(const std::function<void(bool)>& callback);
     
+    /**
+     * @brief 清空提示缓存
+     * 
+     * 换关或重开时调用，旧关卡的缓存结果不会再命中；会等待进行中的后台提示释放缓存
+     */
+    void clearHintCache();
+    
     /**
      * @brief 开始新游戏
      * 
@@ -109,24 +193,68 @@ public:
     void resetGame();
     
 private:
-    GameModel* m_gameModel;                           ///< 游戏数据模型指针
+    GameContext* m_gameContext;                       ///< 本局游戏的上下文指针
+    GameModel* m_gameModel;                           ///< 游戏数据模型指针，属于上下文
     GameView* m_gameView;                            ///< 游戏视图指针
-    UndoManager* m_undoManager;                      ///< 撤销管理器指针
+    UndoManager* m_undoManager;                      ///< 撤销管理器指针，属于上下文
+    ScoringEngine* m_scoringEngine;                  ///< 计分引擎指针，属于上下文
+    MoveLog* m_moveLog;                              ///< 操作日志指针
+    InputRecorder* m_inputRecorder;                  ///< 输入录制器指针
     std::function<void(bool)> m_gameEndCallback;     ///< 游戏结束回调函数
+    std::vector<CardModel> m_handCardScratch;        ///< 手牌导出缓冲，刷新时复用
+    std::vector<CardModel> m_playfieldCardScratch;   ///< 牌桌卡牌导出缓冲，刷新时复用
+    std::shared_ptr<HintCache> m_hintCache;          ///< 提示缓存，后台任务同时持有
+    std::shared_ptr<int> m_aliveToken;               ///< 存活标记，后台任务回调时据此判断控制器是否已销毁
+    unsigned int m_hintRequestId;                    ///< 当前状态的提示序号，状态变化后递增，旧结果作废
+    unsigned int m_pendingHintRequestId;             ///< 正在后台计算的提示序号，没有时为0
+    InputRecording m_replayRecording;                ///< 正在回放的输入录制
+    size_t m_replayCursor;                           ///< 下一条待回放输入的下标
+    uint32_t m_replayFrame;                          ///< 实时回放已推进的帧数
+    bool m_replaying;                                ///< 是否正在回放输入
+    ReplayResult m_replayResult;                     ///< 回放的输入计数
+    std::function<void(const ReplayResult&)> m_replayCallback; ///< 回放结束回调
+    
+    /**
+     * @brief 处理一次输入
+     * 
+     * 录制输入，经GameService::applyInput立即应用到模型并计分，成功后写日志、以动画刷新视图并检查游戏结束
+     * 不等待进行中的动画，连续的点击都按最新的模型校验
+     * @param op 输入类型
+     * @param cardId 被点击的卡牌ID，撤销和重做时为0
+     * @param frame 输入发生的帧序号，回放时为录制中的帧序号
+     * @return 输入改变了游戏状态返回true
+     */
+    bool handleInput(InputOp op, int cardId, uint32_t frame);
+    
+    /**
+     * @brief 处理一次玩家点击，回放期间忽略
+     * 
+     * 以当前帧序号调用handleInput
+     */
+    void handlePlayerInput(InputOp op, int cardId);
+    
+    /**
+     * @brief 应用帧序号不超过指定帧的回放输入，全部应用后结束回放
+     * 
+     * @param frame 当前回放帧
+     */
+    void advanceInputReplay(uint32_t frame);
     
     /**
-     * @brief 刷新手牌视图
+     * @brief 在后台计算当前状态的提示
      * 
-     * 更新手牌区域的显示
+     * 后台任务只复制核心状态，计算在AsyncTaskPool上进行，结果通过Scheduler::performFunctionInCocosThread回到主线程
+     * 搜索结果保存在共享的提示缓存中，之后的请求大多直接命中
      */
-    void refreshHandView();
+    void requestHint();
     
     /**
-     * @brief 刷新牌桌视图
+     * @brief 提示计算完成后在主线程调用
      * 
-     * 更新牌桌区域的显示
+     * @param requestId 请求序号，与当前状态的序号不同时丢弃
+     * @param hint 计算结果
      */
-    void refreshPlayfieldView();
+    void onHintReady(unsigned int requestId, const HintMove& hint);
     
     /**
      * @brief 检查游戏结束条件
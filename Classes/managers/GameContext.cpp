@@ -0,0 +1,40 @@
+﻿#include "GameContext.h"
+#include "../services/GameService.h"
+
+// 构造函数
+GameContext::GameContext(uint32_t seed)
+    : m_random(seed), m_seed(seed) {
+    m_undoManager.init(&m_model);
+}
+
+// 加载关卡
+bool GameContext::loadLevel(const LevelConfig& level, int levelId) {
+    m_levelConfig = level;
+    m_undoManager.clear();
+    bool loaded = GameService::loadLevel(&m_model, m_levelConfig);
+    m_model.currentLevel = levelId;
+    m_scoringEngine.reset(m_model);
+    return loaded;
+}
+
+// 接管已加载的关卡
+void GameContext::adoptLevel(LevelConfig& level, const GameModel& model) {
+    m_levelConfig.stack.swap(level.stack);
+    m_levelConfig.playfield.swap(level.playfield);
+    // 重新开始时按保存的配置重新加载，规则集须随卡牌一起接管
+    m_levelConfig.ruleSet = level.ruleSet;
+    m_undoManager.clear();
+    m_model = model;
+    m_scoringEngine.reset(m_model);
+}
+
+// 设置随机数种子
+void GameContext::setSeed(uint32_t seed) {
+    m_seed = seed;
+    resetRandom();
+}
+
+// 重置随机数引擎
+void GameContext::resetRandom() {
+    m_random.seed(m_seed);
+}
@@ -0,0 +1,119 @@
+﻿#ifndef __GAME_CONTEXT_H__
+#define __GAME_CONTEXT_H__
+
+#include "../models/GameModel.h"
+#include "../configs/LevelData.h"
+#include "UndoManager.h"
+#include "ScoringEngine.h"
+#include <cstdint>
+#include <random>
+
+/**
+ * @class GameContext
+ * @brief 单局游戏的上下文
+ *
+ * 持有一局游戏的全部可变状态：关卡配置、游戏模型（卡牌ID由模型按布局顺序分配）、
+ * 撤销管理器、计分引擎和随机数引擎，取代原先的关卡配置单例和进程级的卡牌ID计数器
+ * 游戏规则服务都是无状态的，只作用于传入的模型，因此不同上下文之间没有任何共享的可变数据
+ *
+ * 线程安全：单个上下文不加锁，同一时刻只应由一个线程使用；
+ * 不同的上下文可以在任意多个线程中同时加载和对局，用于在一个进程内并发运行大量模拟或机器人对局
+ *
+ * 职责：
+ * - 加载关卡并重置模型、撤销历史和计分
+ * - 提供本局的随机数引擎，给定种子时结果可复现
+ *
+ * 使用场景：
+ * - GameScene为界面上的对局创建一个上下文，并交给GameController
+ * - 工具和服务端为每个并发对局各创建一个上下文
+ */
+class GameContext {
+public:
+    /**
+     * 随机数引擎，与LevelGenerationService和PlayoutService使用的相同
+     */
+    typedef std::mt19937 Random;
+
+    /**
+     * @brief 构造函数
+     *
+     * @param seed 随机数种子
+     */
+    explicit GameContext(uint32_t seed = 0);
+
+    /**
+     * @brief 加载关卡
+     *
+     * 保存关卡配置，重置模型后按配置创建卡牌，并清空撤销历史和计分
+     * @param level 关卡配置
+     * @param levelId 关卡ID
+     * @return 全部卡牌都被接受返回true
+     */
+    bool loadLevel(const LevelConfig& level, int levelId);
+
+    /**
+     * @brief 接管一个已在其他线程加载好的关卡
+     *
+     * 与loadLevel结果相同，但不再创建卡牌：交换进关卡配置（卡牌和规则集）、复制模型并清空撤销历史和计分，
+     * 用于关卡切换时把主线程的工作压缩到一次定长拷贝
+     * @param level 关卡配置，内容被交换进上下文
+     * @param model 已按该配置加载好的模型，关卡ID取自其中
+     */
+    void adoptLevel(LevelConfig& level, const GameModel& model);
+
+    /**
+     * @brief 获取当前关卡配置
+     */
+    const LevelConfig& getLevelConfig() const { return m_levelConfig; }
+
+    /**
+     * @brief 获取游戏模型
+     */
+    GameModel& getModel() { return m_model; }
+    const GameModel& getModel() const { return m_model; }
+
+    /**
+     * @brief 获取撤销管理器，已绑定到本上下文的模型
+     */
+    UndoManager& getUndoManager() { return m_undoManager; }
+    const UndoManager& getUndoManager() const { return m_undoManager; }
+
+    /**
+     * @brief 获取计分引擎，最大撤销步数须与撤销管理器保持一致
+     */
+    ScoringEngine& getScoringEngine() { return m_scoringEngine; }
+    const ScoringEngine& getScoringEngine() const { return m_scoringEngine; }
+
+    /**
+     * @brief 获取随机数引擎
+     */
+    Random& getRandom() { return m_random; }
+
+    /**
+     * @brief 获取随机数种子
+     */
+    uint32_t getSeed() const { return m_seed; }
+
+    /**
+     * @brief 重新设置随机数种子，随机数引擎随之重置
+     */
+    void setSeed(uint32_t seed);
+
+    /**
+     * @brief 将随机数引擎恢复到刚以当前种子初始化时的状态
+     */
+    void resetRandom();
+
+private:
+    GameContext(const GameContext&) = delete;
+    GameContext& operator=(const GameContext&) = delete;
+
+    LevelConfig m_levelConfig;      ///< 当前关卡配置
+    GameModel m_model;              ///< 游戏模型
+    UndoManager m_undoManager;      ///< 撤销管理器
+    ScoringEngine m_scoringEngine;  ///< 计分引擎
+    Random m_random;                ///< 随机数引擎
+    uint32_t m_seed;                ///< 随机数种子
+};
+
+#endif // __GAME_CONTEXT_H__
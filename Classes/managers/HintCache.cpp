@@ -0,0 +1,42 @@
+﻿#include "HintCache.h"
+
+const int HintCache::DEFAULT_CAPACITY_LOG2;
+
+// 构造函数
+HintCache::HintCache(int capacityLog2)
+    : m_mask((static_cast<uint64_t>(1) << capacityLog2) - 1)
+    , m_hits(0)
+    , m_misses(0) {
+    m_entries.resize(static_cast<size_t>(m_mask + 1));
+    clear();
+}
+
+// 查找结果
+bool HintCache::find(uint64_t hash, int depth, HintCacheEntry& entry) {
+    const HintCacheEntry& slot = m_entries[hash & m_mask];
+    if (slot.depth != 0 && slot.hash == hash && slot.depth >= depth) {
+        entry = slot;
+        m_hits++;
+        return true;
+    }
+    m_misses++;
+    return false;
+}
+
+// 写入结果
+void HintCache::store(const HintCacheEntry& entry) {
+    HintCacheEntry& slot = m_entries[entry.hash & m_mask];
+    if (slot.depth != 0 && slot.hash == entry.hash && slot.depth > entry.depth) {
+        return;
+    }
+    slot = entry;
+}
+
+// 清空缓存
+void HintCache::clear() {
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        m_entries[i].depth = 0;
+    }
+    m_hits = 0;
+    m_misses = 0;
+}
@@ -0,0 +1,81 @@
+﻿#ifndef __HINT_CACHE_H__
+#define __HINT_CACHE_H__
+
+#include "../solver/FaceState.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @struct HintCacheEntry
+ * @brief 一个状态的前瞻结果
+ */
+struct HintCacheEntry {
+    uint64_t hash;      ///< 牌面级状态的Zobrist哈希
+    int16_t value;      ///< 前瞻评估值
+    uint8_t depth;      ///< 评估时的剩余前瞻步数，0表示空条目
+    FaceStep best;      ///< 最佳的一步
+};
+
+/**
+ * @class HintCache
+ * @brief 提示前瞻结果缓存
+ *
+ * 按牌面级状态哈希直接映射的定长表，保存每个被完整评估过的状态的值和最佳步
+ * 走一步后新状态的大部分子树已在上一次前瞻中评估过，再次求提示只需补上最深的一层；
+ * 撤销回到旧状态时直接命中
+ *
+ * 计算提示时由GameService::computeHint持有互斥锁，可以在后台线程使用
+ */
+class HintCache {
+public:
+    static const int DEFAULT_CAPACITY_LOG2 = 14;    ///< 默认条目数的2的幂次
+
+    /**
+     * @brief 构造函数
+     *
+     * @param capacityLog2 条目数的2的幂次
+     */
+    explicit HintCache(int capacityLog2 = DEFAULT_CAPACITY_LOG2);
+
+    /**
+     * @brief 查找至少评估到指定深度的结果
+     *
+     * @return 命中返回true
+     */
+    bool find(uint64_t hash, int depth, HintCacheEntry& entry);
+
+    /**
+     * @brief 写入结果，同一位置已有更深的同一状态时保留原结果
+     */
+    void store(const HintCacheEntry& entry);
+
+    /**
+     * @brief 清空缓存，换关或重开时调用，调用方须持有getMutex()
+     */
+    void clear();
+
+    /**
+     * @brief 获取计算提示时使用的互斥锁
+     */
+    std::mutex& getMutex() { return m_mutex; }
+
+    /**
+     * @brief 获取命中次数
+     */
+    uint64_t getHits() const { return m_hits; }
+
+    /**
+     * @brief 获取未命中次数
+     */
+    uint64_t getMisses() const { return m_misses; }
+
+private:
+    std::vector<HintCacheEntry> m_entries;  ///< 直接映射的条目
+    uint64_t m_mask;                        ///< 下标掩码
+    uint64_t m_hits;                        ///< 命中次数
+    uint64_t m_misses;                      ///< 未命中次数
+    std::mutex m_mutex;                     ///< 计算提示时持有
+};
+
+#endif // __HINT_CACHE_H__
@@ -0,0 +1,228 @@
+﻿#include "InputRecording.h"
+#include <cstdio>
+#include <cstring>
+
+// 静态常量定义
+const uint32_t InputRecording::MAGIC;
+const uint16_t InputRecording::VERSION;
+const uint16_t InputRecording::FIRST_VERSION;
+const uint16_t InputRecording::SCORED_VERSION;
+const uint8_t InputRecording::END_OP;
+const uint32_t InputRecording::INLINE_DELTA_LIMIT;
+
+namespace {
+
+const int OP_BITS = 3;                          ///< 标记字节中输入类型所占位数
+const uint8_t OP_MASK = (1 << OP_BITS) - 1;     ///< 输入类型掩码
+const size_t RESULT_SIZE = sizeof(uint64_t) + sizeof(int32_t); ///< 结果部分的字节数
+const int MAX_VARINT_BYTES = 5;                 ///< 32位变长整数的最大字节数
+
+/**
+ * @brief 设置错误描述
+ */
+bool fail(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+/**
+ * @brief 输入类型是否带卡牌ID
+ */
+bool hasCardId(uint8_t op) {
+    return op == IO_HAND_CLICK || op == IO_PLAYFIELD_CLICK;
+}
+
+} // namespace
+
+// 构造空录制
+InputRecording::InputRecording()
+    : hasResult(false), finalStateHash(0), finalScore(0) {
+    std::memset(&header, 0, sizeof(header));
+}
+
+// 解析录制
+bool InputRecording::parse(const uint8_t* data, size_t size, std::string* error) {
+    events.clear();
+    hasResult = false;
+    finalStateHash = 0;
+    finalScore = 0;
+
+    if (!data || size < sizeof(InputRecordingHeader)) {
+        return fail(error, "input recording is truncated");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC) {
+        return fail(error, "not an input recording");
+    }
+    if (header.version < FIRST_VERSION || header.version > VERSION) {
+        return fail(error, "unsupported input recording version");
+    }
+
+    const uint8_t* cursor = data + sizeof(InputRecordingHeader);
+    const uint8_t* end = data + size;
+    uint32_t frame = 0;
+    while (cursor < end) {
+        uint8_t tag = *cursor++;
+        uint8_t op = tag & OP_MASK;
+
+        if (op == END_OP) {
+            if (static_cast<size_t>(end - cursor) != RESULT_SIZE) {
+                return fail(error, "input recording result is malformed");
+            }
+            std::memcpy(&finalStateHash, cursor, sizeof(finalStateHash));
+            std::memcpy(&finalScore, cursor + sizeof(finalStateHash), sizeof(finalScore));
+            hasResult = true;
+            return true;
+        }
+        if (op >= IO_NUM_OPS) {
+            return fail(error, "unknown input type in recording");
+        }
+
+        // 帧间隔：小间隔直接写在标记字节里，否则跟一个变长整数
+        uint32_t delta = tag >> OP_BITS;
+        if (delta == INLINE_DELTA_LIMIT) {
+            uint32_t extra = 0;
+            int shift = 0;
+            for (int i = 0;; ++i) {
+                if (cursor >= end || i >= MAX_VARINT_BYTES) {
+                    return fail(error, "input recording frame delta is malformed");
+                }
+                uint8_t byte = *cursor++;
+                extra |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                shift += 7;
+                if ((byte & 0x80) == 0) {
+                    break;
+                }
+            }
+            delta += extra;
+        }
+        frame += delta;
+
+        InputEvent event;
+        event.frame = frame;
+        event.op = op;
+        event.cardId = 0;
+        if (hasCardId(op)) {
+            if (cursor >= end) {
+                return fail(error, "input recording is truncated");
+            }
+            event.cardId = *cursor++;
+        }
+        events.push_back(event);
+    }
+    return true;
+}
+
+// 从文件读取录制
+bool InputRecording::loadFromFile(const std::string& path, std::string* error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return fail(error, "cannot open input recording");
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    bool readError = std::ferror(file) != 0;
+    std::fclose(file);
+    if (readError) {
+        return fail(error, "cannot read input recording");
+    }
+    return parse(data.data(), data.size(), error);
+}
+
+// 构造函数
+InputRecorder::InputRecorder()
+    : m_startFrame(0), m_lastFrame(0), m_eventCount(0), m_recording(false) {
+    std::memset(&m_header, 0, sizeof(m_header));
+}
+
+// 生成文件头
+InputRecordingHeader InputRecorder::makeHeader(const GameModel* gameModel, uint32_t seed, int maxUndoSteps,
+                                               int framesPerSecond) {
+    InputRecordingHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = InputRecording::MAGIC;
+    header.version = InputRecording::VERSION;
+    header.framesPerSecond = static_cast<uint16_t>(framesPerSecond > 0 ? framesPerSecond : 0);
+    header.levelId = gameModel ? gameModel->currentLevel : 0;
+    header.seed = seed;
+    header.initialStateHash = gameModel ? gameModel->computeStateHash() : 0;
+    header.maxUndoSteps = maxUndoSteps;
+    return header;
+}
+
+// 开始录制
+void InputRecorder::begin(const InputRecordingHeader& header, uint32_t startFrame) {
+    m_header = header;
+    m_stream.clear();
+    m_startFrame = startFrame;
+    m_lastFrame = 0;
+    m_eventCount = 0;
+    m_recording = true;
+}
+
+// 停止录制
+void InputRecorder::stop() {
+    m_recording = false;
+}
+
+// 记录输入
+void InputRecorder::record(uint32_t frame, InputOp op, int cardId) {
+    if (!m_recording || op < 0 || op >= IO_NUM_OPS) {
+        return;
+    }
+
+    // 帧计数不会倒退，万一倒退按同一帧处理
+    uint32_t relative = frame >= m_startFrame ? frame - m_startFrame : 0;
+    uint32_t delta = relative >= m_lastFrame ? relative - m_lastFrame : 0;
+    m_lastFrame += delta;
+
+    uint32_t inlineDelta = delta < InputRecording::INLINE_DELTA_LIMIT ? delta : InputRecording::INLINE_DELTA_LIMIT;
+    m_stream.push_back(static_cast<uint8_t>((inlineDelta << OP_BITS) | static_cast<uint8_t>(op)));
+    if (inlineDelta == InputRecording::INLINE_DELTA_LIMIT) {
+        uint32_t extra = delta - InputRecording::INLINE_DELTA_LIMIT;
+        while (extra >= 0x80) {
+            m_stream.push_back(static_cast<uint8_t>((extra & 0x7F) | 0x80));
+            extra >>= 7;
+        }
+        m_stream.push_back(static_cast<uint8_t>(extra));
+    }
+    if (hasCardId(static_cast<uint8_t>(op))) {
+        m_stream.push_back(static_cast<uint8_t>(cardId));
+    }
+    m_eventCount++;
+}
+
+// 生成完整录制数据
+void InputRecorder::serialize(uint64_t finalStateHash, int32_t finalScore, std::vector<uint8_t>& out) const {
+    out.clear();
+    out.reserve(sizeof(m_header) + m_stream.size() + 1 + RESULT_SIZE);
+
+    const uint8_t* header = reinterpret_cast<const uint8_t*>(&m_header);
+    out.insert(out.end(), header, header + sizeof(m_header));
+    out.insert(out.end(), m_stream.begin(), m_stream.end());
+
+    out.push_back(InputRecording::END_OP);
+    uint8_t result[RESULT_SIZE];
+    std::memcpy(result, &finalStateHash, sizeof(finalStateHash));
+    std::memcpy(result + sizeof(finalStateHash), &finalScore, sizeof(finalScore));
+    out.insert(out.end(), result, result + RESULT_SIZE);
+}
+
+// 写入文件
+bool InputRecorder::saveToFile(const std::string& path, uint64_t finalStateHash, int32_t finalScore) const {
+    std::vector<uint8_t> data;
+    serialize(finalStateHash, finalScore, data);
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    return std::fclose(file) == 0 && written;
+}
@@ -0,0 +1,182 @@
+﻿#ifndef __INPUT_RECORDING_H__
+#define __INPUT_RECORDING_H__
+
+#include "../models/InputEvent.h"
+#include "../models/GameModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct InputRecordingHeader
+ * @brief 输入录制文件头
+ *
+ * 定长32字节，位于文件开头；记录回放所需的全部前提条件
+ */
+struct InputRecordingHeader {
+    uint32_t magic;             ///< 文件标识
+    uint16_t version;           ///< 文件格式版本
+    uint16_t framesPerSecond;   ///< 录制时的帧率，实时回放时据此换算帧序号
+    int32_t levelId;            ///< 关卡ID
+    uint32_t seed;              ///< 发牌随机种子
+    uint64_t initialStateHash;  ///< 录制开始时的状态哈希，回放前据此确认关卡一致
+    int32_t maxUndoSteps;       ///< 录制时撤销管理器的最大撤销步数，影响撤销的结果
+    uint32_t reserved;          ///< 保留，写为0
+};
+
+static_assert(sizeof(InputRecordingHeader) == 32, "InputRecordingHeader must stay 32 bytes");
+
+/**
+ * @struct InputRecording
+ * @brief 解析后的输入录制
+ *
+ * 文件格式：文件头之后是按时间顺序排列的输入，每条输入以一个标记字节开头：
+ * - 低3位为输入类型，高5位为与上一条输入的帧间隔；间隔大于等于31时高5位写31，
+ *   随后以LEB128变长整数给出超出31的部分
+ * - 点击手牌和牌桌卡牌时随后再跟一个字节的卡牌ID
+ * 结束标记（输入类型为7）之后是12字节的结果：最终状态哈希（8字节）和最终得分（4字节）
+ * 没有结束标记的录制仍可回放，只是无法校验结果
+ * 版本2起结果中的得分是计分引擎的总分（含连击、时间和完成奖励），版本1只是匹配得分
+ *
+ * 典型的一次点击只占2到3个字节
+ */
+struct InputRecording {
+    static const uint32_t MAGIC = 0x52494743;        ///< 文件标识"CGIR"
+    static const uint16_t VERSION = 2;               ///< 当前文件格式版本
+    static const uint16_t FIRST_VERSION = 1;         ///< 仍可解析的最早版本
+    static const uint16_t SCORED_VERSION = 2;        ///< 结果得分包含奖励的最早版本
+    static const uint8_t END_OP = 7;                 ///< 结束标记的输入类型
+    static const uint32_t INLINE_DELTA_LIMIT = 31;   ///< 可直接写在标记字节中的最大帧间隔（不含）
+
+    InputRecordingHeader header;        ///< 文件头
+    std::vector<InputEvent> events;     ///< 按时间顺序排列的输入
+    bool hasResult;                     ///< 是否带有结果
+    uint64_t finalStateHash;            ///< 录制结束时的状态哈希
+    int32_t finalScore;                 ///< 录制结束时的得分
+
+    /**
+     * @brief 构造空的录制
+     */
+    InputRecording();
+
+    /**
+     * @brief 由内存中的数据解析录制
+     *
+     * 输入列表会复用已有容量，批量解析时可重复使用同一个对象
+     * @param data 录制数据
+     * @param size 数据字节数
+     * @param error 解析失败时输出错误描述，可为空
+     * @return 解析成功返回true
+     */
+    bool parse(const uint8_t* data, size_t size, std::string* error = nullptr);
+
+    /**
+     * @brief 从文件读取并解析录制
+     *
+     * @param path 文件路径
+     * @param error 失败时输出错误描述，可为空
+     * @return 成功返回true
+     */
+    bool loadFromFile(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief 获取最后一条输入的帧序号，没有输入时为0
+     */
+    uint32_t getLastFrame() const { return events.empty() ? 0 : events.back().frame; }
+};
+
+/**
+ * @class InputRecorder
+ * @brief 玩家输入录制器
+ *
+ * 把每次点击连同帧序号编码进内存中的紧凑字节流，格式见InputRecording
+ * 被规则拒绝的点击也会记录，回放时经由同一个GameService::applyInput得到相同的结果
+ *
+ * 职责：
+ * - 在对局开始时记录回放所需的前提条件
+ * - 追加编码每次输入
+ * - 按需生成带结果的完整录制数据
+ *
+ * 使用场景：
+ * - GameScene在新对局开始时调用begin()，在对局结束和离开场景时保存录制
+ * - GameController在每次点击时调用record()
+ */
+class InputRecorder {
+public:
+    /**
+     * @brief 构造函数
+     */
+    InputRecorder();
+
+    /**
+     * @brief 按模型的当前状态生成文件头
+     *
+     * @param gameModel 刚加载完关卡的游戏数据模型
+     * @param seed 发牌随机种子
+     * @param maxUndoSteps 撤销管理器的最大撤销步数
+     * @param framesPerSecond 帧率
+     * @return 文件头
+     */
+    static InputRecordingHeader makeHeader(const GameModel* gameModel, uint32_t seed, int maxUndoSteps,
+                                           int framesPerSecond);
+
+    /**
+     * @brief 开始新的录制，丢弃之前录制的输入
+     *
+     * @param header 文件头
+     * @param startFrame 开始时的帧序号，之后的输入帧序号以此为0点
+     */
+    void begin(const InputRecordingHeader& header, uint32_t startFrame);
+
+    /**
+     * @brief 停止录制，已录制的数据保留
+     */
+    void stop();
+
+    /**
+     * @brief 检查是否正在录制
+     */
+    bool isRecording() const { return m_recording; }
+
+    /**
+     * @brief 记录一次输入，未在录制时忽略
+     *
+     * @param frame 当前帧序号（与begin()使用同一个计数）
+     * @param op 输入类型
+     * @param cardId 被点击的卡牌ID，撤销和重做时忽略
+     */
+    void record(uint32_t frame, InputOp op, int cardId);
+
+    /**
+     * @brief 获取已录制的输入数量
+     */
+    size_t getEventCount() const { return m_eventCount; }
+
+    /**
+     * @brief 生成完整的录制数据
+     *
+     * 录制数据不会因此结束，之后仍可继续记录输入
+     * @param finalStateHash 当前状态哈希
+     * @param finalScore 计分引擎的当前总分
+     * @param out 输出数据，会先被清空
+     */
+    void serialize(uint64_t finalStateHash, int32_t finalScore, std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief 生成完整的录制数据并写入文件
+     *
+     * @return 写入成功返回true
+     */
+    bool saveToFile(const std::string& path, uint64_t finalStateHash, int32_t finalScore) const;
+
+private:
+    InputRecordingHeader m_header;  ///< 文件头
+    std::vector<uint8_t> m_stream;  ///< 已编码的输入
+    uint32_t m_startFrame;          ///< 开始录制时的帧序号
+    uint32_t m_lastFrame;           ///< 上一条输入的相对帧序号
+    size_t m_eventCount;            ///< 已录制的输入数量
+    bool m_recording;               ///< 是否正在录制
+};
+
+#endif // __INPUT_RECORDING_H__
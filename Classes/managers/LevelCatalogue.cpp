@@ -0,0 +1,194 @@
+﻿#include "LevelCatalogue.h"
+#include "cocos2d.h"
+#include "../configs/LevelPack.h"
+#include "../configs/LevelConfig.h"
+#include "../services/GameService.h"
+#include "../utils/GameUtils.h"
+#include "../views/CardFaceAtlas.h"
+
+USING_NS_CC;
+
+/**
+ * 关卡来源：关卡包或关卡JSON文件列表，打开后只读，由目录和后台任务共同持有
+ */
+struct LevelCatalogue::LevelSource {
+    LevelPack pack;                     ///< 关卡包，未打开时使用levelFiles
+    Data packData;                      ///< 无法映射时（如Android安装包内的文件）读入内存的关卡包
+    std::vector<std::string> levelFiles; ///< 关卡JSON文件的完整路径
+};
+
+const int LevelCatalogue::DEFAULT_PREFETCH_COUNT;
+
+// 构造函数
+LevelCatalogue::LevelCatalogue()
+    : m_prefetchCount(DEFAULT_PREFETCH_COUNT)
+    , m_currentIndex(-1)
+    , m_aliveToken(std::make_shared<int>(0)) {
+}
+
+// 析构函数
+LevelCatalogue::~LevelCatalogue() {
+}
+
+// 打开关卡目录
+bool LevelCatalogue::open(const std::string& packFile, const std::vector<std::string>& fallbackLevelFiles) {
+    m_ready.clear();
+    m_pending.clear();
+    m_currentIndex = -1;
+
+    // 完整路径在主线程解析，后台任务只使用绝对路径，不触碰FileUtils的查找缓存
+    std::shared_ptr<LevelSource> source = std::make_shared<LevelSource>();
+    FileUtils* fileUtils = FileUtils::getInstance();
+    std::string packPath = fileUtils->fullPathForFilename(packFile);
+    if (!packPath.empty()) {
+        std::string error;
+        bool opened = false;
+        if (fileUtils->isAbsolutePath(packPath)) {
+            opened = source->pack.openFile(packPath, &error);
+        } else {
+            source->packData = fileUtils->getDataFromFile(packPath);
+            opened = source->pack.openMemory(source->packData.getBytes(), source->packData.getSize(), &error);
+        }
+        if (!opened) {
+            CCLOG("Failed to open level pack %s: %s", packPath.c_str(), error.c_str());
+        }
+    }
+    if (!source->pack.isOpen()) {
+        for (size_t i = 0; i < fallbackLevelFiles.size(); ++i) {
+            source->levelFiles.push_back(fileUtils->fullPathForFilename(fallbackLevelFiles[i]));
+        }
+    }
+    m_source = source;
+
+    // 牌面来自已烘焙的图集；图集不可用时卡牌退回到背景纹理，提前在后台解码
+    if (!CardFaceAtlas::isBaked()) {
+        Director::getInstance()->getTextureCache()->addImageAsync(GameUtils::getCardBackImageName(), nullptr);
+    }
+
+    CCLOG("Level catalogue opened: %d levels from %s", getLevelCount(),
+          source->pack.isOpen() ? packPath.c_str() : "level files");
+    return getLevelCount() > 0;
+}
+
+// 获取关卡数量
+int LevelCatalogue::getLevelCount() const {
+    if (!m_source) {
+        return 0;
+    }
+    return m_source->pack.isOpen() ? m_source->pack.getLevelCount() : static_cast<int>(m_source->levelFiles.size());
+}
+
+// 预取后续关卡
+void LevelCatalogue::prefetch(int index) {
+    int levelCount = getLevelCount();
+    if (levelCount == 0) {
+        return;
+    }
+    m_currentIndex = index;
+
+    // 丢弃离开预取窗口的关卡
+    for (auto it = m_ready.begin(); it != m_ready.end();) {
+        if (isInPrefetchWindow(it->first)) {
+            ++it;
+        } else {
+            it = m_ready.erase(it);
+        }
+    }
+
+    std::shared_ptr<LevelSource> source = m_source;
+    std::weak_ptr<int> alive = m_aliveToken;
+    int count = m_prefetchCount < levelCount - 1 ? m_prefetchCount : levelCount - 1;
+    for (int i = 1; i <= count; ++i) {
+        int next = (index + i) % levelCount;
+        if (isReady(next) || m_pending.count(next) > 0) {
+            continue;
+        }
+        m_pending.insert(next);
+
+        AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO,
+            [this, source, alive, next]() {
+                std::shared_ptr<PreparedLevel> level = std::make_shared<PreparedLevel>();
+                if (!prepareLevel(*source, next, *level)) {
+                    level.reset();
+                }
+
+                Director::getInstance()->getScheduler()->performFunctionInCocosThread(
+                    [this, source, alive, next, level]() {
+                        if (!alive.expired()) {
+                            onLevelPrepared(source.get(), next, level);
+                        }
+                    });
+            });
+    }
+}
+
+// 把关卡加载进上下文
+bool LevelCatalogue::takeLevel(int index, GameContext& context) {
+    if (!m_source || index < 0 || index >= getLevelCount()) {
+        return false;
+    }
+
+    std::shared_ptr<PreparedLevel> level;
+    auto it = m_ready.find(index);
+    if (it != m_ready.end()) {
+        level = it->second;
+        m_ready.erase(it);
+    } else {
+        // 未预取到时同步加载
+        level = std::make_shared<PreparedLevel>();
+        if (!prepareLevel(*m_source, index, *level)) {
+            return false;
+        }
+    }
+
+    if (!level->loaded) {
+        CCLOG("Some cards in level %d were rejected", getLevelId(index));
+    }
+    context.adoptLevel(level->config, level->model);
+    return true;
+}
+
+// 加载一个关卡
+bool LevelCatalogue::prepareLevel(const LevelSource& source, int index, PreparedLevel& level) {
+    if (source.pack.isOpen()) {
+        // 关卡包记录直接建牌，配置只在重新开始本关时使用
+        source.pack.decodeLevel(index, level.config);
+        level.loaded = GameService::loadLevel(&level.model, source.pack, index);
+    } else {
+        std::string error;
+        if (!LevelConfigManager::readLevelFile(source.levelFiles[index], level.config, error)) {
+            CCLOG("Failed to load level %s: %s", source.levelFiles[index].c_str(), error.c_str());
+            return false;
+        }
+        level.loaded = GameService::loadLevel(&level.model, level.config);
+    }
+    level.model.currentLevel = getLevelId(index);
+    return true;
+}
+
+// 后台加载完成
+void LevelCatalogue::onLevelPrepared(const LevelSource* source, int index,
+                                     const std::shared_ptr<PreparedLevel>& level) {
+    if (source != m_source.get()) {
+        return;
+    }
+    m_pending.erase(index);
+    if (!level || !isInPrefetchWindow(index)) {
+        return;
+    }
+
+    m_ready[index] = level;
+    if (m_readyCallback) {
+        m_readyCallback(index, *level);
+    }
+}
+
+// 检查关卡是否在预取窗口中
+bool LevelCatalogue::isInPrefetchWindow(int index) const {
+    int levelCount = getLevelCount();
+    if (m_currentIndex < 0 || levelCount == 0) {
+        return false;
+    }
+    int distance = (index - m_currentIndex + levelCount) % levelCount;
+    return distance >= 1 && distance <= m_prefetchCount;
+}
@@ -0,0 +1,142 @@
+﻿#ifndef __LEVEL_CATALOGUE_H__
+#define __LEVEL_CATALOGUE_H__
+
+#include "../configs/LevelData.h"
+#include "../models/GameModel.h"
+#include "GameContext.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @struct PreparedLevel
+ * @brief 在后台线程加载好的关卡
+ */
+struct PreparedLevel {
+    LevelConfig config;     ///< 关卡配置
+    GameModel model;        ///< 按配置加载好的模型，关卡ID已设置
+    bool loaded;            ///< 全部卡牌都被模型接受
+
+    PreparedLevel() : loaded(false) {}
+};
+
+/**
+ * @class LevelCatalogue
+ * @brief 关卡目录，在后台预取后续关卡
+ *
+ * 关卡来源优先为二进制关卡包：映射后的关卡包本身就是按下标排列的索引，
+ * 打开时不逐个读取关卡，上万个关卡的目录也只有一次映射的开销；
+ * 找不到关卡包时退回到给定的关卡JSON文件列表
+ *
+ * 预取：prefetch(index)在AsyncTaskPool的IO线程上依次加载其后的若干个关卡，
+ * 加载出的配置和模型经Scheduler::performFunctionInCocosThread回到主线程后放入就绪表；
+ * takeLevel命中就绪表时只需把模型拷入上下文，主线程上没有文件读取、解析和建牌
+ * 牌面全部来自启动时烘焙好的图集，关卡之间不需要切换纹理；
+ * 图集不可用时退回的卡牌背景纹理在打开目录时通过TextureCache异步加载
+ *
+ * 线程：除后台任务外所有接口都只在主线程调用；后台任务只读取共享的关卡来源，
+ * 关卡来源由后台任务共同持有，目录先于任务销毁也不会失效
+ *
+ * 关卡ID为下标加1
+ */
+class LevelCatalogue {
+public:
+    typedef std::function<void(int index, const PreparedLevel& level)> ReadyCallback;
+
+    static const int DEFAULT_PREFETCH_COUNT = 2;    ///< 默认预取的后续关卡数
+
+    LevelCatalogue();
+    ~LevelCatalogue();
+
+    /**
+     * @brief 打开关卡目录，之前预取的关卡被丢弃
+     *
+     * @param packFile 关卡包文件，按FileUtils的搜索路径查找
+     * @param fallbackLevelFiles 没有关卡包时使用的关卡JSON文件，按顺序作为关卡下标
+     * @return 至少有一个关卡返回true
+     */
+    bool open(const std::string& packFile, const std::vector<std::string>& fallbackLevelFiles);
+
+    /**
+     * @brief 获取关卡数量
+     */
+    int getLevelCount() const;
+
+    /**
+     * @brief 由关卡下标得到关卡ID
+     */
+    static int getLevelId(int index) { return index + 1; }
+
+    /**
+     * @brief 由关卡ID得到关卡下标
+     */
+    static int getLevelIndex(int levelId) { return levelId - 1; }
+
+    /**
+     * @brief 设置预取的后续关卡数，0表示不预取
+     */
+    void setPrefetchCount(int count) { m_prefetchCount = count > 0 ? count : 0; }
+
+    /**
+     * @brief 设置关卡就绪回调，在主线程调用，可用于按卡牌数预热视图
+     */
+    void setReadyCallback(const ReadyCallback& callback) { m_readyCallback = callback; }
+
+    /**
+     * @brief 预取指定关卡之后的若干个关卡
+     *
+     * 预取窗口之外的就绪关卡被丢弃，已在窗口中的关卡不会重复加载；最后一个关卡之后回到第一个
+     * @param index 当前关卡下标
+     */
+    void prefetch(int index);
+
+    /**
+     * @brief 检查关卡是否已预取就绪
+     */
+    bool isReady(int index) const { return m_ready.find(index) != m_ready.end(); }
+
+    /**
+     * @brief 把关卡加载进上下文
+     *
+     * 已就绪时直接接管预取的模型；否则在当前线程同步加载
+     * 有卡牌被模型拒绝时只记录日志，关卡仍被加载
+     * @param index 关卡下标
+     * @param context 游戏上下文
+     * @return 关卡被加载进上下文返回true，下标无效或读取失败返回false
+     */
+    bool takeLevel(int index, GameContext& context);
+
+private:
+    LevelCatalogue(const LevelCatalogue&) = delete;
+    LevelCatalogue& operator=(const LevelCatalogue&) = delete;
+
+    struct LevelSource;
+
+    /**
+     * @brief 从关卡来源加载一个关卡，可在任意线程调用
+     */
+    static bool prepareLevel(const LevelSource& source, int index, PreparedLevel& level);
+
+    /**
+     * @brief 后台加载完成，在主线程调用；目录已重新打开时丢弃结果
+     */
+    void onLevelPrepared(const LevelSource* source, int index, const std::shared_ptr<PreparedLevel>& level);
+
+    /**
+     * @brief 检查关卡是否在当前预取窗口中
+     */
+    bool isInPrefetchWindow(int index) const;
+
+    std::shared_ptr<LevelSource> m_source;                      ///< 关卡来源，与后台任务共享
+    std::map<int, std::shared_ptr<PreparedLevel> > m_ready;     ///< 已就绪的关卡
+    std::set<int> m_pending;                                    ///< 正在后台加载的关卡
+    ReadyCallback m_readyCallback;                              ///< 关卡就绪回调
+    int m_prefetchCount;                                        ///< 预取的后续关卡数
+    int m_currentIndex;                                         ///< 最近一次预取时的当前关卡
+    std::shared_ptr<int> m_aliveToken;                          ///< 后台任务回到主线程时判断目录是否仍存在
+};
+
+#endif // __LEVEL_CATALOGUE_H__
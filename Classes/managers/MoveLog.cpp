@@ -0,0 +1,310 @@
+﻿#include "MoveLog.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// 静态常量定义
+const uint32_t MoveLog::MAGIC;
+const uint16_t MoveLog::VERSION;
+const size_t MoveLog::WRITE_BUFFER_SIZE;
+const int MoveLog::SYNC_INTERVAL_MS;
+
+namespace {
+
+/**
+ * @brief 写入错误信息并返回false
+ */
+bool fail(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+/**
+ * @brief 只读内存映射的日志文件
+ */
+struct MappedLogFile {
+    const uint8_t* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    MappedLogFile() : data(nullptr), size(0) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#endif
+    }
+
+    ~MappedLogFile() {
+#ifdef _WIN32
+        if (data) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (data) {
+            munmap(const_cast<uint8_t*>(data), size);
+        }
+#endif
+    }
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            return false;
+        }
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return data != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+};
+
+} // namespace
+
+// 构造函数
+MoveLog::MoveLog()
+    : m_fd(-1), m_bufferSize(0), m_entryCount(0), m_needsSync(false),
+      m_lastSync(std::chrono::steady_clock::now()), m_lastReplayMicroseconds(0.0), m_droppedEntryCount(0) {
+}
+
+// 析构函数
+MoveLog::~MoveLog() {
+    close();
+}
+
+// 开始新的会话
+bool MoveLog::startSession(const std::string& path, int levelId, uint32_t seed, std::string* error) {
+    close();
+    if (!openForWrite(path, 0, error)) {
+        return false;
+    }
+
+    MoveLogHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entrySize = sizeof(MoveLogEntry);
+    header.levelId = levelId;
+    header.seed = seed;
+    if (!writeAll(&header, sizeof(header))) {
+        close();
+        return fail(error, "cannot write move log header");
+    }
+
+    m_entryCount = 0;
+    sync();
+    return true;
+}
+
+// 恢复已有会话
+bool MoveLog::resumeSession(const std::string& path, int levelId, uint32_t seed,
+                            const std::function<bool(const MoveLogEntry&)>& replay, std::string* error) {
+    close();
+    m_droppedEntryCount = 0;
+
+    size_t replayed = 0;
+    {
+        MappedLogFile file;
+        if (!file.open(path) || file.size < sizeof(MoveLogHeader)) {
+            return fail(error, "no move log to resume");
+        }
+
+        MoveLogHeader header;
+        std::memcpy(&header, file.data, sizeof(header));
+        if (!isValidHeader(header) || header.levelId != levelId || header.seed != seed) {
+            return fail(error, "move log does not match the current level");
+        }
+
+        // 末尾不完整的条目直接忽略
+        auto start = std::chrono::steady_clock::now();
+        const MoveLogEntry* entries = reinterpret_cast<const MoveLogEntry*>(file.data + sizeof(MoveLogHeader));
+        size_t entryCount = (file.size - sizeof(MoveLogHeader)) / sizeof(MoveLogEntry);
+        while (replayed < entryCount && replay(entries[replayed])) {
+            replayed++;
+        }
+        m_lastReplayMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        m_droppedEntryCount = entryCount - replayed;
+    }
+
+    // 截掉无法重放的条目后继续追加
+    if (!openForWrite(path, sizeof(MoveLogHeader) + replayed * sizeof(MoveLogEntry), error)) {
+        return false;
+    }
+    m_entryCount = replayed;
+    return true;
+}
+
+// 读取文件头
+bool MoveLog::readHeader(const std::string& path, MoveLogHeader& header) {
+    MappedLogFile file;
+    if (!file.open(path) || file.size < sizeof(MoveLogHeader)) {
+        return false;
+    }
+    std::memcpy(&header, file.data, sizeof(header));
+    return isValidHeader(header);
+}
+
+// 检查文件头
+bool MoveLog::isValidHeader(const MoveLogHeader& header) {
+    return header.magic == MAGIC && header.version == VERSION && header.entrySize == sizeof(MoveLogEntry);
+}
+
+// 追加条目
+void MoveLog::append(MoveLogOp op, int cardId) {
+    if (!isOpen()) {
+        return;
+    }
+    bool wasPending = hasPendingWrites();
+    if (m_bufferSize + sizeof(MoveLogEntry) > WRITE_BUFFER_SIZE) {
+        flush(false);
+    }
+
+    MoveLogEntry entry;
+    entry.op = static_cast<uint8_t>(op);
+    entry.cardId = static_cast<uint8_t>(cardId);
+    std::memcpy(m_buffer + m_bufferSize, &entry, sizeof(entry));
+    m_bufferSize += sizeof(entry);
+    m_entryCount++;
+
+    if (!wasPending && m_pendingCallback) {
+        m_pendingCallback();
+    }
+}
+
+// 写出缓冲区
+bool MoveLog::flush(bool sync) {
+    if (!isOpen()) {
+        return true;
+    }
+    bool written = true;
+    if (m_bufferSize > 0) {
+        written = writeAll(m_buffer, m_bufferSize);
+        m_bufferSize = 0;
+        m_needsSync = true;
+    }
+    if (sync && m_needsSync) {
+        this->sync();
+    }
+    return written;
+}
+
+// 定期维护
+bool MoveLog::update() {
+    bool written = flush(false);
+    if (m_needsSync && std::chrono::steady_clock::now() - m_lastSync >= std::chrono::milliseconds(SYNC_INTERVAL_MS)) {
+        sync();
+    }
+    return written;
+}
+
+// 关闭文件
+void MoveLog::close() {
+    if (!isOpen()) {
+        return;
+    }
+    flush(true);
+#ifdef _WIN32
+    _close(m_fd);
+#else
+    ::close(m_fd);
+#endif
+    m_fd = -1;
+    m_bufferSize = 0;
+    m_entryCount = 0;
+}
+
+// 打开文件用于写入
+bool MoveLog::openForWrite(const std::string& path, size_t length, std::string* error) {
+#ifdef _WIN32
+    m_fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+    if (m_fd >= 0 && (_chsize(m_fd, static_cast<long>(length)) != 0 || _lseek(m_fd, 0, SEEK_END) < 0)) {
+        _close(m_fd);
+        m_fd = -1;
+    }
+#else
+    m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (m_fd >= 0 && (ftruncate(m_fd, static_cast<off_t>(length)) != 0 || lseek(m_fd, 0, SEEK_END) < 0)) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif
+    if (m_fd < 0) {
+        return fail(error, "cannot open move log for writing");
+    }
+    m_bufferSize = 0;
+    m_needsSync = false;
+    return true;
+}
+
+// 完整写入数据
+bool MoveLog::writeAll(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(m_fd, bytes, static_cast<unsigned int>(size));
+#else
+        ssize_t written = ::write(m_fd, bytes, size);
+#endif
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// 同步到磁盘
+void MoveLog::sync() {
+#ifdef _WIN32
+    _commit(m_fd);
+#else
+    fsync(m_fd);
+#endif
+    m_needsSync = false;
+    m_lastSync = std::chrono::steady_clock::now();
+}
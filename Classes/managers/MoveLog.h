@@ -0,0 +1,232 @@
+﻿#ifndef __MOVE_LOG_H__
+#define __MOVE_LOG_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @enum MoveLogOp
+ * @brief 操作日志条目类型
+ */
+enum MoveLogOp
+{
+    MLO_HAND_REPLACE,       ///< 点击手牌，将其移到顶部
+    MLO_PLAYFIELD_MATCH,    ///< 点击牌桌卡牌，与顶部手牌匹配
+    MLO_UNDO,               ///< 撤销一步
+    MLO_REDO                ///< 重做一步
+};
+
+/**
+ * @struct MoveLogHeader
+ * @brief 操作日志文件头
+ *
+ * 定长16字节，位于文件开头
+ */
+struct MoveLogHeader {
+    uint32_t magic;         ///< 文件标识
+    uint16_t version;       ///< 文件格式版本
+    uint16_t entrySize;     ///< 每个条目的字节数
+    int32_t levelId;        ///< 关卡ID
+    uint32_t seed;          ///< 发牌随机种子
+};
+
+/**
+ * @struct MoveLogEntry
+ * @brief 操作日志条目
+ *
+ * 每步操作占两个字节
+ */
+struct MoveLogEntry {
+    uint8_t op;             ///< 操作类型（MoveLogOp）
+    uint8_t cardId;         ///< 被点击的卡牌ID，撤销和重做时为0
+};
+
+static_assert(sizeof(MoveLogHeader) == 16, "MoveLogHeader must stay 16 bytes");
+static_assert(sizeof(MoveLogEntry) == 2, "MoveLogEntry must stay 2 bytes");
+
+/**
+ * @class MoveLog
+ * @brief 只追加的二进制操作日志
+ *
+ * 每局游戏对应一个日志文件：文件头之后按顺序追加每步操作（包括撤销和重做），
+ * 进程被杀死后重新启动时，通过内存映射读取日志并经由GameService重放，
+ * 即可恢复对局和完整的撤销历史
+ *
+ * 写入先进入固定大小的写缓冲区，由update()定期写入文件，并按时间间隔调用fsync
+ * 文件末尾不完整的条目在恢复时会被截掉
+ *
+ * 职责：
+ * - 创建新的日志文件并写入文件头
+ * - 缓冲并追加操作条目
+ * - 校验并重放已有日志
+ *
+ * 使用场景：
+ * - GameScene按日志文件头加载关卡后恢复会话，没有可恢复的日志时新建会话，
+ *   有待写出的数据时定期调用update()
+ * - GameController在操作、撤销和重做成功后追加条目
+ */
+class MoveLog {
+public:
+    static const uint32_t MAGIC = 0x4C4D4743;        ///< 文件标识"CGML"
+    static const uint16_t VERSION = 1;               ///< 当前文件格式版本
+    static const size_t WRITE_BUFFER_SIZE = 256;     ///< 写缓冲区字节数
+    static const int SYNC_INTERVAL_MS = 1000;        ///< 两次fsync之间的最短间隔（毫秒）
+
+    /**
+     * @brief 构造函数
+     */
+    MoveLog();
+
+    /**
+     * @brief 析构函数
+     *
+     * 写出缓冲区并关闭文件
+     */
+    ~MoveLog();
+
+    /**
+     * @brief 开始新的会话
+     *
+     * 清空已有文件并写入文件头
+     * @param path 日志文件路径
+     * @param levelId 关卡ID
+     * @param seed 发牌随机种子
+     * @param error 失败时写入原因，可为空
+     * @return 成功返回true，失败返回false
+     */
+    bool startSession(const std::string& path, int levelId, uint32_t seed, std::string* error = nullptr);
+
+    /**
+     * @brief 恢复已有会话
+     *
+     * 校验文件头后按顺序把每个条目交给replay，replay返回false时停止重放，
+     * 并将文件截断到最后一个成功重放的条目，之后以追加方式继续写入
+     * 被截掉的条目数可通过getDroppedEntryCount()获取
+     * @param path 日志文件路径
+     * @param levelId 期望的关卡ID
+     * @param seed 期望的发牌随机种子
+     * @param replay 重放回调，返回是否成功应用该条目
+     * @param error 失败时写入原因，可为空
+     * @return 文件存在且文件头匹配返回true，否则返回false
+     */
+    bool resumeSession(const std::string& path, int levelId, uint32_t seed,
+                       const std::function<bool(const MoveLogEntry&)>& replay, std::string* error = nullptr);
+
+    /**
+     * @brief 读取已有日志的文件头
+     *
+     * 只校验文件标识、版本和条目大小，恢复会话前据此加载日志所属的关卡
+     * @param path 日志文件路径
+     * @param header 输出的文件头
+     * @return 文件存在且文件头有效返回true
+     */
+    static bool readHeader(const std::string& path, MoveLogHeader& header);
+
+    /**
+     * @brief 追加一个条目
+     *
+     * 条目先写入缓冲区，缓冲区满时立即写入文件；此前没有待写出的数据时调用待写出回调
+     * @param op 操作类型
+     * @param cardId 被点击的卡牌ID
+     */
+    void append(MoveLogOp op, int cardId);
+
+    /**
+     * @brief 将缓冲区写入文件
+     *
+     * @param sync 是否随后调用fsync
+     * @return 写入失败返回false
+     */
+    bool flush(bool sync);
+
+    /**
+     * @brief 定期维护
+     *
+     * 写出缓冲区，距离上次fsync超过SYNC_INTERVAL_MS时再次fsync
+     * @return 写入失败返回false
+     */
+    bool update();
+
+    /**
+     * @brief 写出缓冲区、同步并关闭文件
+     */
+    void close();
+
+    /**
+     * @brief 检查日志文件是否已打开
+     */
+    bool isOpen() const { return m_fd >= 0; }
+
+    /**
+     * @brief 获取日志中的条目数
+     */
+    size_t getEntryCount() const { return m_entryCount; }
+
+    /**
+     * @brief 获取最近一次重放的耗时（微秒）
+     */
+    double getLastReplayMicroseconds() const { return m_lastReplayMicroseconds; }
+
+    /**
+     * @brief 获取最近一次恢复时因无法重放而截掉的条目数
+     *
+     * 末尾不完整的条目不计入
+     */
+    size_t getDroppedEntryCount() const { return m_droppedEntryCount; }
+
+    /**
+     * @brief 检查是否有尚未写入文件或尚未fsync的数据
+     *
+     * 没有时不需要调用update()
+     */
+    bool hasPendingWrites() const { return m_bufferSize > 0 || m_needsSync; }
+
+    /**
+     * @brief 设置待写出回调
+     *
+     * 日志从没有待写出的数据变为有数据时调用，用于按需启动定期写出
+     * @param callback 回调函数，可为空
+     */
+    void setPendingCallback(const std::function<void()>& callback) { m_pendingCallback = callback; }
+
+private:
+    /**
+     * @brief 检查文件头的标识、版本和条目大小
+     */
+    static bool isValidHeader(const MoveLogHeader& header);
+
+    int m_fd;                                         ///< 文件描述符，未打开时为-1
+    uint8_t m_buffer[WRITE_BUFFER_SIZE];              ///< 写缓冲区
+    size_t m_bufferSize;                              ///< 缓冲区中待写入的字节数
+    size_t m_entryCount;                              ///< 日志中的条目数（含缓冲区中的）
+    bool m_needsSync;                                 ///< 是否有已写入但未fsync的数据
+    std::chrono::steady_clock::time_point m_lastSync; ///< 上次fsync的时间
+    double m_lastReplayMicroseconds;                  ///< 最近一次重放的耗时
+    size_t m_droppedEntryCount;                       ///< 最近一次恢复时截掉的条目数
+    std::function<void()> m_pendingCallback;          ///< 待写出回调
+
+    /**
+     * @brief 打开日志文件用于写入
+     *
+     * @param path 文件路径
+     * @param length 打开后将文件截断到的长度
+     * @param error 失败时写入原因，可为空
+     * @return 成功返回true，失败返回false
+     */
+    bool openForWrite(const std::string& path, size_t length, std::string* error);
+
+    /**
+     * @brief 将数据完整写入文件
+     */
+    bool writeAll(const void* data, size_t size);
+
+    /**
+     * @brief 对文件调用fsync
+     */
+    void sync();
+};
+
+#endif // __MOVE_LOG_H__
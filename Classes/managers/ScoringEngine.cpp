@@ -0,0 +1,185 @@
+﻿#include "ScoringEngine.h"
+#include "UndoManager.h"
+#include "../services/ScoreService.h"
+#include <algorithm>
+
+// 静态常量定义
+const int ScoringEngine::DEFAULT_FRAMES_PER_SECOND;
+const int ScoringEngine::PAR_SECONDS_PER_CARD;
+
+// 构造函数
+ScoringEngine::ScoringEngine()
+    : m_head(0), m_count(0), m_maxUndoSteps(UndoManager::DEFAULT_MAX_UNDO_STEPS)
+    , m_combo(0), m_perfect(true), m_won(false), m_parSeconds(0.0f)
+    , m_framesPerSecond(DEFAULT_FRAMES_PER_SECOND), m_startFrame(0) {
+    m_journal.resize(UndoManager::DEFAULT_MAX_UNDO_STEPS);
+}
+
+// 重置计分
+void ScoringEngine::reset(const GameModel& gameModel) {
+    m_head = 0;
+    m_count = 0;
+    m_breakdown = ScoreBreakdown();
+    m_combo = 0;
+    m_perfect = true;
+    m_won = false;
+    m_parSeconds = static_cast<float>(gameModel.state.playfieldCount() * PAR_SECONDS_PER_CARD);
+}
+
+// 设置时钟
+void ScoringEngine::setClock(int framesPerSecond, uint32_t startFrame) {
+    m_framesPerSecond = framesPerSecond > 0 ? framesPerSecond : DEFAULT_FRAMES_PER_SECOND;
+    m_startFrame = startFrame;
+}
+
+// 设置最大撤销步数
+void ScoringEngine::setMaxUndoSteps(int maxSteps) {
+    m_maxUndoSteps = maxSteps;
+
+    if (m_maxUndoSteps > 0) {
+        resizeJournal(static_cast<size_t>(m_maxUndoSteps));
+    } else {
+        resizeJournal(std::max(m_journal.size(), UndoManager::UNLIMITED_INITIAL_CAPACITY));
+    }
+}
+
+// 消费计分事件
+void ScoringEngine::consume(const ScoreEvent& event) {
+    switch (event.type) {
+        case SET_MATCH: {
+            Entry& entry = pushEntry();
+            entry.comboBefore = static_cast<uint16_t>(std::min<int>(m_combo, UINT16_MAX));
+            m_combo = entry.comboBefore + 1;
+            entry.matchPoints = event.matchPoints;
+            entry.comboBonus = static_cast<int16_t>(ScoreService::calculateComboBonus(m_combo));
+            m_breakdown.matchPoints += entry.matchPoints;
+            m_breakdown.comboBonus += entry.comboBonus;
+            break;
+        }
+        case SET_SWAP: {
+            Entry& entry = pushEntry();
+            entry.comboBefore = static_cast<uint16_t>(std::min<int>(m_combo, UINT16_MAX));
+            m_combo = 0;
+            break;
+        }
+        case SET_UNDO: {
+            // 撤销本身使对局不再完美，即使已没有可回退的记录
+            m_perfect = false;
+            if (m_count == 0) {
+                break;
+            }
+            m_count--;
+            const Entry& entry = entryAt(m_count);
+            m_breakdown.matchPoints -= entry.matchPoints;
+            m_breakdown.comboBonus -= entry.comboBonus;
+            m_breakdown.timeBonus -= entry.timeBonus;
+            m_breakdown.completionBonus -= entry.completionBonus;
+            m_combo = entry.comboBefore;
+            m_won = false;
+            break;
+        }
+        case SET_MISS:
+            m_perfect = false;
+            break;
+        case SET_WIN: {
+            if (m_won) {
+                break;
+            }
+            m_won = true;
+
+            // 奖励记在结束对局的一步上，撤销这一步时一并回退
+            float elapsed = getElapsedSeconds(event.frame);
+            int timeBonus = ScoreService::calculateTimeBonus(elapsed, m_parSeconds);
+            int completionBonus = ScoreService::calculateCompletionBonus(0, elapsed, m_perfect);
+            if (m_count > 0) {
+                Entry& entry = entryAt(m_count - 1);
+                entry.timeBonus = static_cast<int16_t>(entry.timeBonus + timeBonus);
+                entry.completionBonus = static_cast<int16_t>(entry.completionBonus + completionBonus);
+            }
+            m_breakdown.timeBonus += timeBonus;
+            m_breakdown.completionBonus += completionBonus;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// 按输入结果计分
+void ScoringEngine::onInput(InputOp op, bool applied, const MoveRecord& record, const GameModel& gameModel,
+                            uint32_t frame) {
+    if (!applied) {
+        // 被拒绝的点击占输入的大多数，直接记为失误，不经过consume；对局结束后的点击不算失误
+        if (op == IO_PLAYFIELD_CLICK && !gameModel.isGameOver) {
+            m_perfect = false;
+        }
+        return;
+    }
+
+    if (op == IO_UNDO) {
+        consume(ScoreEvent(frame, SET_UNDO));
+        return;
+    }
+
+    // 点击和重做都以实际执行的操作记录计分
+    if (record.type == MT_PLAYFIELD_MATCH) {
+        consume(ScoreEvent(frame, SET_MATCH, record.scoreDelta));
+    } else {
+        consume(ScoreEvent(frame, SET_SWAP));
+    }
+    if (gameModel.isGameWon) {
+        consume(ScoreEvent(frame, SET_WIN));
+    }
+}
+
+// 获取用时
+float ScoringEngine::getElapsedSeconds(uint32_t frame) const {
+    uint32_t frames = frame > m_startFrame ? frame - m_startFrame : 0;
+    return static_cast<float>(frames) / static_cast<float>(m_framesPerSecond);
+}
+
+// 追加一条记录
+ScoringEngine::Entry& ScoringEngine::pushEntry() {
+    if (m_count == m_journal.size()) {
+        if (m_maxUndoSteps <= 0) {
+            // 不限步数时按倍数扩容
+            resizeJournal(m_journal.size() * 2);
+        } else {
+            // 缓冲区已满，覆盖最旧的记录
+            m_head = m_head + 1 < m_journal.size() ? m_head + 1 : 0;
+            m_count--;
+        }
+    }
+
+    Entry& entry = entryAt(m_count);
+    m_count++;
+    entry = Entry();
+    return entry;
+}
+
+// 获取从最旧记录起第offset条记录
+ScoringEngine::Entry& ScoringEngine::entryAt(size_t offset) {
+    // offset总小于容量，回绕一次即可，避免每个事件都做除法
+    size_t index = m_head + offset;
+    return m_journal[index < m_journal.size() ? index : index - m_journal.size()];
+}
+
+// 调整环形缓冲区容量
+void ScoringEngine::resizeJournal(size_t capacity) {
+    // 回放每次都会按录制设置步数上限，容量不变时不重新分配
+    if (capacity == m_journal.size()) {
+        return;
+    }
+
+    size_t dropped = m_count > capacity ? m_count - capacity : 0;
+    size_t count = m_count - dropped;
+
+    std::vector<Entry> journal(capacity);
+    for (size_t i = 0; i < count; ++i) {
+        journal[i] = entryAt(dropped + i);
+    }
+
+    m_journal.swap(journal);
+    m_head = 0;
+    m_count = count;
+}
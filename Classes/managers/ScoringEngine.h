@@ -0,0 +1,156 @@
+﻿#ifndef __SCORING_ENGINE_H__
+#define __SCORING_ENGINE_H__
+
+#include "../models/GameModel.h"
+#include "../models/InputEvent.h"
+#include "../models/MoveRecord.h"
+#include "../models/ScoreEvent.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ScoringEngine
+ * @brief 事件驱动的计分引擎
+ *
+ * 按时间顺序消费计分事件，在规则给出的匹配得分之上累加ScoreService定义的各项奖励：
+ * - 连击：连续匹配时第n次匹配得到calculateComboBonus(n)，换手牌打断连击
+ * - 完成：清空牌桌时得到calculateCompletionBonus，没有撤销和被拒绝的点击时为完美对局
+ * - 时间：清空牌桌时按用时与标准用时（牌桌卡牌数乘以每张牌的标准秒数）得到calculateTimeBonus
+ * 匹配得分已由关卡规则集的得分规则给出（奖励关的同花色奖励即在其中），这里不再重复计算
+ *
+ * 每步操作在环形缓冲区中记下本步的得分和此前的连击数，撤销时弹出并整体回退，
+ * 缓冲区容量与撤销管理器的最大撤销步数保持一致；每个事件都是O(1)
+ *
+ * 奖励只取决于事件序列和帧序号，对局中的控制器和服务端的输入回放经由同一个onInput
+ * 得到逐位相同的总分
+ *
+ * 职责：
+ * - 维护连击和完美对局状态
+ * - 按来源累计得分
+ * - 随撤销回退得分和连击
+ *
+ * 使用场景：
+ * - GameContext为每局游戏持有一个引擎，加载关卡时重置
+ * - GameController在每次输入后调用onInput
+ * - ReplayService回放录制时重新计分并与录制的得分比较
+ */
+class ScoringEngine {
+public:
+    static const int DEFAULT_FRAMES_PER_SECOND = 60;    ///< 未设置帧率时换算用时的帧率
+    static const int PAR_SECONDS_PER_CARD = 10;         ///< 每张牌桌卡牌的标准用时（秒）
+
+    /**
+     * @brief 构造函数
+     *
+     * 按撤销管理器的默认步数预分配环形缓冲区
+     */
+    ScoringEngine();
+
+    /**
+     * @brief 为刚加载的关卡重置计分
+     *
+     * 清空得分、连击和撤销记录，按模型的牌桌卡牌数计算标准用时；帧率和步数上限保持不变
+     * @param gameModel 刚加载完关卡的游戏数据模型
+     */
+    void reset(const GameModel& gameModel);
+
+    /**
+     * @brief 设置换算用时的时钟
+     *
+     * @param framesPerSecond 帧率，小于等于0时使用默认帧率
+     * @param startFrame 对局开始时的帧序号，用时从此帧算起
+     */
+    void setClock(int framesPerSecond, uint32_t startFrame);
+
+    /**
+     * @brief 设置最大撤销步数，须与撤销管理器一致
+     *
+     * @param maxSteps 最大撤销步数，小于等于0表示不限步数
+     */
+    void setMaxUndoSteps(int maxSteps);
+
+    /**
+     * @brief 消费一个计分事件
+     *
+     * 没有可回退记录时的撤销和重复的胜利事件被忽略
+     * @param event 计分事件
+     */
+    void consume(const ScoreEvent& event);
+
+    /**
+     * @brief 按一次输入的处理结果生成并消费计分事件
+     *
+     * @param op 输入类型
+     * @param applied GameService::applyInput的返回值
+     * @param record applyInput输出的操作记录，applied为false或撤销时不使用
+     * @param gameModel 应用输入之后的游戏数据模型
+     * @param frame 输入发生的帧序号
+     */
+    void onInput(InputOp op, bool applied, const MoveRecord& record, const GameModel& gameModel, uint32_t frame);
+
+    /**
+     * @brief 获取按来源分开的得分
+     */
+    const ScoreBreakdown& getBreakdown() const { return m_breakdown; }
+
+    /**
+     * @brief 获取总分
+     */
+    int32_t getTotalScore() const { return m_breakdown.total(); }
+
+    /**
+     * @brief 获取当前连击数
+     */
+    int getCombo() const { return m_combo; }
+
+    /**
+     * @brief 检查目前是否仍是完美对局
+     */
+    bool isPerfect() const { return m_perfect; }
+
+    /**
+     * @brief 获取指定帧距对局开始的秒数
+     */
+    float getElapsedSeconds(uint32_t frame) const;
+
+private:
+    /**
+     * @brief 一步操作的得分记录
+     */
+    struct Entry {
+        int32_t matchPoints;        ///< 匹配得分
+        int16_t comboBonus;         ///< 连击奖励
+        int16_t timeBonus;          ///< 时间奖励，仅结束对局的一步
+        int16_t completionBonus;    ///< 完成奖励，仅结束对局的一步
+        uint16_t comboBefore;       ///< 本步之前的连击数
+    };
+
+    std::vector<Entry> m_journal;   ///< 得分记录环形缓冲区，大小即容量
+    size_t m_head;                  ///< 最旧记录在缓冲区中的下标
+    size_t m_count;                 ///< 可回退的记录数
+    int m_maxUndoSteps;             ///< 最大撤销步数，小于等于0表示不限
+    ScoreBreakdown m_breakdown;     ///< 按来源分开的得分
+    int m_combo;                    ///< 当前连击数
+    bool m_perfect;                 ///< 是否仍是完美对局
+    bool m_won;                     ///< 是否已结算胜利
+    float m_parSeconds;             ///< 标准用时（秒）
+    int m_framesPerSecond;          ///< 换算用时的帧率
+    uint32_t m_startFrame;          ///< 对局开始时的帧序号
+
+    /**
+     * @brief 追加一条记录，缓冲区已满时扩容或覆盖最旧的记录
+     */
+    Entry& pushEntry();
+
+    /**
+     * @brief 获取从最旧记录起第offset条记录
+     */
+    Entry& entryAt(size_t offset);
+
+    /**
+     * @brief 调整环形缓冲区容量，保留最新的记录
+     */
+    void resizeJournal(size_t capacity);
+};
+
+#endif // __SCORING_ENGINE_H__
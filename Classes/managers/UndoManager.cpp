@@ -1,10 +1,15 @@
 ﻿#include "UndoManager.h"
+#include "../services/GameService.h"
+#include <algorithm>
 
-USING_NS_CC;
+// 静态常量定义
+const int UndoManager::DEFAULT_MAX_UNDO_STEPS;
+const size_t UndoManager::UNLIMITED_INITIAL_CAPACITY;
 
 // 构造函数
 UndoManager::UndoManager()
-    : m_gameModel(nullptr), m_maxUndoSteps(10) {
+    : m_gameModel(nullptr), m_head(0), m_undoCount(0), m_redoCount(0), m_maxUndoSteps(DEFAULT_MAX_UNDO_STEPS) {
+    m_journal.resize(DEFAULT_MAX_UNDO_STEPS);
 }
 
 // 析构函数
@@ -22,71 +27,111 @@ bool UndoManager::init(GameModel* gameModel) {
     return true;
 }
 
-// 保存当前游戏状态
-void UndoManager::saveState() {
-    if (!m_gameModel) {
-        return;
-    }
-    
-    // 创建当前状态快照
-    auto snapshot = std::make_shared<GameStateSnapshot>(*m_gameModel);
-    m_undoStack.push(snapshot);
+// 记录一步操作
+void UndoManager::recordMove(const MoveRecord& record) {
+    // 新操作使所有已撤销的记录失效
+    m_redoCount = 0;
     
-    // 限制撤销栈大小
-    while (m_undoStack.size() > static_cast<size_t>(m_maxUndoSteps)) {
-        m_undoStack.pop();
+    if (m_undoCount == m_journal.size()) {
+        if (m_maxUndoSteps <= 0) {
+            // 不限步数时按倍数扩容
+            resizeJournal(m_journal.size() * 2);
+        } else {
+            // 缓冲区已满，覆盖最旧的记录
+            m_head = (m_head + 1) % m_journal.size();
+            m_undoCount--;
+        }
     }
+    
+    recordAt(m_undoCount) = record;
+    m_undoCount++;
 }
 
-// 撤销到上一状态
+// 撤销最近一步操作
 bool UndoManager::undo() {
     if (!canUndo()) {
         return false;
     }
     
-    // 获取上一状态
-    auto snapshot = m_undoStack.top();
-    m_undoStack.pop();
+    m_undoCount--;
+    m_redoCount++;
+    GameService::revertMove(m_gameModel, recordAt(m_undoCount));
     
-    // 应用快照
-    applySnapshot(*snapshot);
+    return true;
+}
+
+// 重做最近一步被撤销的操作
+bool UndoManager::redo(MoveRecord* record) {
+    if (!canRedo()) {
+        return false;
+    }
     
+    if (!GameService::replayMove(m_gameModel, recordAt(m_undoCount))) {
+        // 状态与记录不一致，丢弃剩余的重做记录
+        m_redoCount = 0;
+        return false;
+    }
+    
+    if (record) {
+        *record = recordAt(m_undoCount);
+    }
+    m_undoCount++;
+    m_redoCount--;
     return true;
 }
 
 // 检查是否可以撤销
 bool UndoManager::canUndo() const {
-    return !m_undoStack.empty() && m_gameModel != nullptr;
+    return m_undoCount > 0 && m_gameModel != nullptr;
+}
+
+// 检查是否可以重做
+bool UndoManager::canRedo() const {
+    return m_redoCount > 0 && m_gameModel != nullptr;
 }
 
 // 清除撤销历史
 void UndoManager::clear() {
-    while (!m_undoStack.empty()) {
-        m_undoStack.pop();
-    }
+    m_head = 0;
+    m_undoCount = 0;
+    m_redoCount = 0;
 }
 
 // 设置最大撤销步数
 void UndoManager::setMaxUndoSteps(int maxSteps) {
     m_maxUndoSteps = maxSteps;
     
-    // 如果当前栈大小超过新限制，移除多余元素
-    while (m_undoStack.size() > static_cast<size_t>(m_maxUndoSteps)) {
-        m_undoStack.pop();
+    if (m_maxUndoSteps > 0) {
+        resizeJournal(static_cast<size_t>(m_maxUndoSteps));
+    } else {
+        resizeJournal(std::max(m_journal.size(), UNLIMITED_INITIAL_CAPACITY));
     }
 }
 
-// 应用游戏状态快照
-void UndoManager::applySnapshot(const GameStateSnapshot& snapshot) {
-    if (!m_gameModel) {
+// 获取从最旧记录起第offset条记录
+MoveRecord& UndoManager::recordAt(size_t offset) {
+    return m_journal[(m_head + offset) % m_journal.size()];
+}
+
+// 调整环形缓冲区容量
+void UndoManager::resizeJournal(size_t capacity) {
+    // 回放每次都会按录制设置步数上限，容量不变时不重新分配
+    if (capacity == m_journal.size()) {
         return;
     }
     
-    m_gameModel->handCards = snapshot.handCards;
-    m_gameModel->playfieldCards = snapshot.playfieldCards;
-    m_gameModel->score = snapshot.score;
+    // 丢弃超出容量的最旧记录，可重做的记录排在可撤销记录之后
+    size_t dropped = m_undoCount > capacity ? m_undoCount - capacity : 0;
+    size_t undoCount = m_undoCount - dropped;
+    size_t redoCount = std::min(m_redoCount, capacity - undoCount);
     
-    // 重新检查游戏状态
-    m_gameModel->isGameOver = false;
-    m_gameModel->isGameWon = false;
-}
\ No newline at end of file
+    std::vector<MoveRecord> journal(capacity);
+    for (size_t i = 0; i < undoCount + redoCount; ++i) {
+        journal[i] = recordAt(dropped + i);
+    }
+    
+    m_journal.swap(journal);
+    m_head = 0;
+    m_undoCount = undoCount;
+    m_redoCount = redoCount;
+}
@@ -1,61 +1,39 @@
 ﻿#ifndef __UNDO_MANAGER_H__
 #define __UNDO_MANAGER_H__
 
-#include "cocos2d.h"
 #include "../models/GameModel.h"
-#include <stack>
-#include <memory>
-
-/**
- * @struct GameStateSnapshot
- * @brief 游戏状态快照结构体
- * 
- * 用于保存游戏在某个时刻的完整状态
- * 包括手牌、牌桌卡牌和分数等关键信息
- * 支持游戏状态的保存和恢复功能
- */
-struct GameStateSnapshot {
-    std::vector<CardModel> handCards;        ///< 快照时的手牌状态
-    std::vector<CardModel> playfieldCards;   ///< 快照时的牌桌卡牌状态
-    int score;                               ///< 快照时的游戏分数
-    
-    /**
-     * @brief 构造函数
-     * 
-     * @param model 要创建快照的游戏模型
-     */
-    GameStateSnapshot(const GameModel& model)
-        : handCards(model.handCards)
-        , playfieldCards(model.playfieldCards)
-        , score(model.score) {
-    }
-};
+#include "../models/MoveRecord.h"
+#include <vector>
 
 /**
  * @class UndoManager
  * @brief 撤销管理器类
  * 
- * 负责管理游戏的撤销功能
- * 通过保存游戏状态快照，支持玩家撤销之前的操作
- * 使用栈结构存储历史状态，支持多步撤销
+ * 负责管理游戏的撤销和重做功能
+ * 每次成功的操作记录一条可逆的MoveRecord增量，而不是复制整个游戏状态
+ * 记录存放在预分配的环形缓冲区中，压入、撤销和重做都是O(1)，
+ * 达到步数上限时直接覆盖最旧的记录
  * 
  * 职责：
- * - 保存游戏状态的历史快照
- * - 提供撤销到之前状态的功能
- * - 管理撤销历史的存储和清理
+ * - 记录玩家每步成功操作的增量
+ * - 提供撤销和重做操作的功能
+ * - 管理操作记录的存储和清理
  * - 控制最大撤销步数限制
  * 
  * 使用场景：
- * - 玩家点击撤销按钮时恢复游戏状态
- * - 在关键操作前自动保存状态
- * - 游戏重置时清理撤销历史
+ * - 控制器在操作成功后记录增量
+ * - 玩家点击撤销或重做按钮时恢复游戏状态
+ * - 游戏重置时清理操作记录
  */
 class UndoManager {
 public:
+    static const int DEFAULT_MAX_UNDO_STEPS = 10;    ///< 默认最大撤销步数
+    static const size_t UNLIMITED_INITIAL_CAPACITY = 64; ///< 不限步数时环形缓冲区的初始容量
+    
     /**
      * @brief 构造函数
      * 
-     * 初始化撤销管理器，设置默认参数
+     * 初始化撤销管理器，按默认步数预分配环形缓冲区
      */
     UndoManager();
     
@@ -75,51 +53,92 @@ public:
     bool init(GameModel* gameModel);
     
     /**
-     * @brief 保存当前游戏状态
+     * @brief 记录一步已执行成功的操作
      * 
-     * 将当前游戏状态创建快照并压入撤销栈
+     * 会清空所有可重做的记录；缓冲区已满时覆盖最旧的记录
+     * @param record 操作记录
      */
-    void saveState();
+    void recordMove(const MoveRecord& record);
     
     /**
-     * @brief 撤销到上一个状态
+     * @brief 撤销最近一步操作
      * 
-     * @return 撤销成功返回true，无可撤销状态返回false
+     * @return 撤销成功返回true，无可撤销操作返回false
      */
     bool undo();
     
+    /**
+     * @brief 重做最近一步被撤销的操作
+     * 
+     * @param record 重做成功时输出被重做的操作记录，可为空
+     * @return 重做成功返回true，无可重做操作返回false
+     */
+    bool redo(MoveRecord* record = nullptr);
+    
     /**
      * @brief 检查是否可以撤销
      * 
-     * @return 有可撤销状态返回true，否则返回false
+     * @return 有可撤销操作返回true，否则返回false
      */
     bool canUndo() const;
     
+    /**
+     * @brief 检查是否可以重做
+     * 
+     * @return 有可重做操作返回true，否则返回false
+     */
+    bool canRedo() const;
+    
     /**
      * @brief 清空撤销历史
      * 
-     * 清除所有保存的状态快照
+     * 清除所有操作记录，保留已分配的缓冲区
      */
     void clear();
     
     /**
      * @brief 设置最大撤销步数
      * 
-     * @param maxSteps 允许的最大撤销步数
+     * 超出新限制的最旧记录会被丢弃
+     * @param maxSteps 允许的最大撤销步数，小于等于0表示不限步数
      */
     void setMaxUndoSteps(int maxSteps);
     
+    /**
+     * @brief 获取最大撤销步数，小于等于0表示不限步数
+     */
+    int getMaxUndoSteps() const { return m_maxUndoSteps; }
+    
+    /**
+     * @brief 获取可撤销的步数
+     */
+    size_t getUndoCount() const { return m_undoCount; }
+    
+    /**
+     * @brief 获取可重做的步数
+     */
+    size_t getRedoCount() const { return m_redoCount; }
+    
 private:
-    GameModel* m_gameModel;                                    ///< 游戏数据模型指针
-    std::stack<std::shared_ptr<GameStateSnapshot>> m_undoStack; ///< 撤销状态栈，存储历史快照
-    int m_maxUndoSteps;                                        ///< 最大撤销步数限制
+    GameModel* m_gameModel;                ///< 游戏数据模型指针
+    std::vector<MoveRecord> m_journal;     ///< 操作记录环形缓冲区，大小即容量
+    size_t m_head;                         ///< 最旧记录在缓冲区中的下标
+    size_t m_undoCount;                    ///< 可撤销的记录数
+    size_t m_redoCount;                    ///< 可重做的记录数（紧跟在可撤销记录之后）
+    int m_maxUndoSteps;                    ///< 最大撤销步数限制，小于等于0表示不限
+    
+    /**
+     * @brief 获取从最旧记录起第offset条记录
+     */
+    MoveRecord& recordAt(size_t offset);
     
     /**
-     * @brief 应用游戏状态快照
+     * @brief 调整环形缓冲区容量
      * 
-     * @param snapshot 要应用的状态快照
+     * 记录会按从旧到新的顺序重新排列到缓冲区开头，超出容量的最旧记录被丢弃
+     * @param capacity 新容量
      */
-    void applySnapshot(const GameStateSnapshot& snapshot);
+    void resizeJournal(size_t capacity);
 };
 
 #endif // __UNDO_MANAGER_H__
\ No newline at end of file
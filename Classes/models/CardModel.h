@@ -1,8 +1,8 @@
 ﻿#ifndef __CARD_MODEL_H__
 #define __CARD_MODEL_H__
 
-#include "cocos2d.h"
 #include "../configs/CardTypes.h"
+#include "GameVec2.h"
 
 /**
  * @class CardModel
@@ -12,6 +12,9 @@
  * 包括卡牌的ID、牌面值、花色、朝向状态和位置等
  * 用于游戏逻辑中的卡牌数据表示和传递
  * 
+ * 游戏核心状态使用单字节的PackedCard存储卡牌，
+ * CardModel作为视图层和外部接口使用的完整卡牌描述
+ * 
  * 使用场景：
  * - 游戏中所有卡牌对象的数据载体
  * - 卡牌状态的持久化和序列化
@@ -23,7 +26,7 @@ public:
     CardFaceType face;         ///< 卡牌牌面值，决定卡牌的数值
     CardSuitType suit;         ///< 卡牌花色，决定卡牌的花色类型
     bool isFaceUp;            ///< 卡牌朝向状态，true为正面朝上，false为背面朝上
-    cocos2d::Vec2 position;   ///< 卡牌在游戏场景中的位置坐标
+    GameVec2 position;       ///< 卡牌在游戏场景中的位置坐标
     
     /**
      * @brief 默认构造函数
@@ -41,28 +44,6 @@ public:
      * @param faceUp 是否正面朝上，默认为true
      */
     CardModel(int cardId, CardFaceType cardFace, CardSuitType cardSuit, bool faceUp = true);
-    
-    /**
-     * @brief 拷贝构造函数
-     * 
-     * @param other 要拷贝的卡牌模型对象
-     */
-    CardModel(const CardModel& other);
-    
-    /**
-     * @brief 赋值运算符重载
-     * 
-     * @param other 要赋值的卡牌模型对象
-     * @return 返回当前对象的引用
-     */
-    CardModel& operator=(const CardModel& other);
-    
-    /**
-     * @brief 析构函数
-     * 
-     * 清理卡牌模型占用的资源
-     */
-    ~CardModel();
 };
 
 #endif // __CARD_MODEL_H__
\ No newline at end of file
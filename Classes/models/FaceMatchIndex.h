@@ -0,0 +1,102 @@
+﻿#ifndef __FACE_MATCH_INDEX_H__
+#define __FACE_MATCH_INDEX_H__
+
+#include "../configs/CardTypes.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @struct FaceMatchIndex
+ * @brief 按牌面维护的匹配索引
+ *
+ * 用13位掩码记录牌桌和手牌中出现过的牌面，并维护每种牌面的数量，
+ * 牌桌卡牌另按牌面挂在以卡牌ID为节点的双向链表（桶）上
+ * 匹配规则给出某个掩码能匹配的牌面（经典规则为((mask << 1) | (mask >> 1))），
+ * 与另一掩码按位与即可在常数时间内判断是否存在可匹配的卡牌；判断本身由RuleEngine按关卡规则完成
+ *
+ * 结构体为POD类型，作为PackedGameState的一部分随快照一起复制
+ * 由PackedGameState在增删卡牌时增量维护，不应单独修改
+ */
+struct FaceMatchIndex {
+    static const int MAX_CARD_IDS = 192;     ///< 支持的卡牌ID数量
+    static const uint8_t NO_CARD = 0xFF;     ///< 链表结束标记
+    static const uint16_t ALL_FACES = (1 << CFT_NUM_CARD_FACE_TYPES) - 1; ///< 全部牌面的掩码
+
+    uint16_t playfieldMask;                              ///< 牌桌中出现的牌面
+    uint16_t handMask;                                   ///< 手牌中出现的牌面
+    uint8_t playfieldCounts[CFT_NUM_CARD_FACE_TYPES];    ///< 牌桌中每种牌面的数量
+    uint8_t handCounts[CFT_NUM_CARD_FACE_TYPES];         ///< 手牌中每种牌面的数量
+    uint8_t bucketHead[CFT_NUM_CARD_FACE_TYPES];         ///< 每种牌面的牌桌卡牌链表头
+    uint8_t bucketNext[MAX_CARD_IDS];                    ///< 同牌面的下一张牌桌卡牌ID
+    uint8_t bucketPrev[MAX_CARD_IDS];                    ///< 同牌面的上一张牌桌卡牌ID
+
+    /**
+     * @brief 获取单个牌面的掩码
+     */
+    static uint16_t faceBit(CardFaceType face) {
+        return static_cast<uint16_t>(1 << face);
+    }
+
+    /**
+     * @brief 清空索引
+     */
+    void clear() {
+        playfieldMask = 0;
+        handMask = 0;
+        std::memset(playfieldCounts, 0, sizeof(playfieldCounts));
+        std::memset(handCounts, 0, sizeof(handCounts));
+        std::memset(bucketHead, NO_CARD, sizeof(bucketHead));
+    }
+
+    /**
+     * @brief 登记一张牌桌卡牌
+     */
+    void addPlayfieldCard(CardFaceType face, int cardId) {
+        uint8_t id = static_cast<uint8_t>(cardId);
+        bucketPrev[id] = NO_CARD;
+        bucketNext[id] = bucketHead[face];
+        if (bucketHead[face] != NO_CARD) {
+            bucketPrev[bucketHead[face]] = id;
+        }
+        bucketHead[face] = id;
+        playfieldCounts[face]++;
+        playfieldMask |= faceBit(face);
+    }
+
+    /**
+     * @brief 移除一张牌桌卡牌
+     */
+    void removePlayfieldCard(CardFaceType face, int cardId) {
+        uint8_t id = static_cast<uint8_t>(cardId);
+        if (bucketPrev[id] != NO_CARD) {
+            bucketNext[bucketPrev[id]] = bucketNext[id];
+        } else {
+            bucketHead[face] = bucketNext[id];
+        }
+        if (bucketNext[id] != NO_CARD) {
+            bucketPrev[bucketNext[id]] = bucketPrev[id];
+        }
+        if (--playfieldCounts[face] == 0) {
+            playfieldMask &= static_cast<uint16_t>(~faceBit(face));
+        }
+    }
+
+    /**
+     * @brief 登记一张手牌
+     */
+    void addHandCard(CardFaceType face) {
+        handCounts[face]++;
+        handMask |= faceBit(face);
+    }
+
+    /**
+     * @brief 移除一张手牌
+     */
+    void removeHandCard(CardFaceType face) {
+        if (--handCounts[face] == 0) {
+            handMask &= static_cast<uint16_t>(~faceBit(face));
+        }
+    }
+};
+
+#endif // __FACE_MATCH_INDEX_H__
@@ -1,56 +1,145 @@
 ﻿#include "GameModel.h"
 
-USING_NS_CC;
+// 静态常量定义
+const int PackedGameState::MAX_HAND_CARDS;
+const int PackedGameState::MAX_PLAYFIELD_CARDS;
+const int PackedGameState::MAX_CARDS;
+const int FaceMatchIndex::MAX_CARD_IDS;
+const uint8_t FaceMatchIndex::NO_CARD;
+const uint16_t FaceMatchIndex::ALL_FACES;
 
 // 构造函数
 GameModel::GameModel() 
-    : currentLevel(1), score(0), isGameOver(false), isGameWon(false) {
+    : currentLevel(1), isGameOver(false), isGameWon(false) {
+    state.clear();
 }
 
-// 获取顶部手牌
-CardModel* GameModel::getTopHandCard() {
-    if (handCards.empty()) {
-        return nullptr;
+// 加入手牌
+int GameModel::addHandCard(CardFaceType face, CardSuitType suit) {
+    if (!isValidCard(face, suit) || state.handCount >= PackedGameState::MAX_HAND_CARDS) {
+        return -1;
     }
-    return &handCards.back();
+    int cardId = allocateCardId(GameVec2());
+    if (cardId < 0) {
+        return -1;
+    }
+    state.pushHandCard(PackedCard::make(face, suit), cardId);
+    return cardId;
 }
 
-// 根据ID查找牌桌卡牌
-CardModel* GameModel::findPlayfieldCardById(int cardId) {
-    for (auto& card : playfieldCards) {
-        if (card.id == cardId) {
-            return &card;
-        }
+// 加入牌桌卡牌
+int GameModel::addPlayfieldCard(CardFaceType face, CardSuitType suit, const GameVec2& position) {
+    if (!isValidCard(face, suit) || state.playfieldCount() >= PackedGameState::MAX_PLAYFIELD_CARDS) {
+        return -1;
+    }
+    int cardId = allocateCardId(position);
+    if (cardId < 0) {
+        return -1;
     }
-    return nullptr;
+    state.pushPlayfieldCard(PackedCard::make(face, suit), cardId);
+    return cardId;
 }
 
 // 从牌桌移除卡牌
 bool GameModel::removePlayfieldCard(int cardId) {
-    for (auto it = playfieldCards.begin(); it != playfieldCards.end(); ++it) {
-        if (it->id == cardId) {
-            playfieldCards.erase(it);
-            return true;
+    if (!state.playfield.contains(cardId)) {
+        return false;
+    }
+    return state.removePlayfieldCard(state.playfield.handleOf(cardId));
+}
+
+// 生成手牌列表
+void GameModel::exportHandCards(std::vector<CardModel>& out) const {
+    out.clear();
+    out.reserve(state.handCount);
+    for (int i = 0; i < state.handCount; ++i) {
+        out.push_back(makeCardModel(state.handCards[i], state.handIds[i]));
+    }
+}
+
+// 生成牌桌卡牌列表
+void GameModel::exportPlayfieldCards(std::vector<CardModel>& out) const {
+    out.clear();
+    out.reserve(state.playfieldCount());
+    
+    // 按卡牌ID顺序输出，使列表顺序与关卡配置的层级一致
+    for (int cardId = 0; cardId < layout.cardCount; ++cardId) {
+        const PackedCard* card = state.playfield.find(cardId);
+        if (card) {
+            out.push_back(makeCardModel(*card, cardId));
         }
     }
-    return false;
 }
 
 // 重置游戏数据
 void GameModel::reset() {
-    handCards.clear();
-    playfieldCards.clear();
-    score = 0;
+    state.clear();
+    layout.cardCount = 0;
     isGameOver = false;
     isGameWon = false;
 }
 
 // 检查胜利条件
 bool GameModel::checkWinCondition() const {
-    return playfieldCards.empty();
+    return state.playfield.empty();
 }
 
 // 检查失败条件
 bool GameModel::checkLoseCondition() const {
-    return handCards.empty() && !playfieldCards.empty();
-}
\ No newline at end of file
+    return state.handCount == 0 && !state.playfield.empty();
+}
+
+// 计算状态哈希
+uint64_t GameModel::computeStateHash() const {
+    const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    const uint64_t FNV_PRIME = 0x100000001b3ULL;
+    uint64_t hash = FNV_OFFSET_BASIS;
+    
+    hash = (hash ^ static_cast<uint8_t>(layout.cardCount)) * FNV_PRIME;
+    hash = (hash ^ state.handCount) * FNV_PRIME;
+    for (int i = 0; i < state.handCount; ++i) {
+        hash = (hash ^ state.handIds[i]) * FNV_PRIME;
+        hash = (hash ^ state.handCards[i].bits) * FNV_PRIME;
+    }
+    
+    // 牌桌按卡牌ID遍历，不在牌桌上的ID也参与哈希
+    for (int cardId = 0; cardId < layout.cardCount; ++cardId) {
+        const PackedCard* card = state.playfield.find(cardId);
+        hash = (hash ^ (card ? card->bits : 0xFFu)) * FNV_PRIME;
+    }
+    
+    uint32_t score = static_cast<uint32_t>(state.score);
+    for (int shift = 0; shift < 32; shift += 8) {
+        hash = (hash ^ ((score >> shift) & 0xFFu)) * FNV_PRIME;
+    }
+    hash = (hash ^ ((isGameOver ? 1u : 0u) | (isGameWon ? 2u : 0u))) * FNV_PRIME;
+    
+    // 经典规则不参与哈希，已有录制中的哈希保持不变
+    if (state.ruleSet != RST_CLASSIC) {
+        hash = (hash ^ state.ruleSet) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// 检查牌面和花色是否有效
+bool GameModel::isValidCard(CardFaceType face, CardSuitType suit) {
+    return face >= 0 && face < CFT_NUM_CARD_FACE_TYPES &&
+           suit >= 0 && suit < CST_NUM_CARD_SUIT_TYPES;
+}
+
+// 分配卡牌ID
+int GameModel::allocateCardId(const GameVec2& position) {
+    if (layout.cardCount >= PackedGameState::MAX_CARDS) {
+        return -1;
+    }
+    int cardId = layout.cardCount++;
+    layout.positions[cardId] = position;
+    return cardId;
+}
+
+// 生成卡牌模型
+CardModel GameModel::makeCardModel(PackedCard card, int cardId) const {
+    CardModel model(cardId, card.face(), card.suit(), true);
+    model.position = layout.positions[cardId];
+    return model;
+}
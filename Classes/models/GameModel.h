@@ -1,10 +1,28 @@
 ﻿#ifndef __GAME_MODEL_H__
 #define __GAME_MODEL_H__
 
-#include "cocos2d.h"
 #include "CardModel.h"
+#include "GameVec2.h"
+#include "PackedGameState.h"
 #include <vector>
 
+/**
+ * @struct CardLayoutTable
+ * @brief 卡牌布局表
+ * 
+ * 按卡牌ID保存每张卡牌在场景中的位置
+ * 关卡加载后只读，与可变的核心状态分开存放，撤销快照无需复制
+ */
+struct CardLayoutTable {
+    int cardCount;                                               ///< 已分配的卡牌ID数量
+    GameVec2 positions[PackedGameState::MAX_CARDS];              ///< 按卡牌ID索引的位置
+    
+    /**
+     * @brief 构造函数
+     */
+    CardLayoutTable() : cardCount(0) {}
+};
+
 /**
  * @struct GameModel
  * @brief 游戏数据模型结构体
@@ -13,6 +31,9 @@
  * 包括手牌、牌桌卡牌、关卡信息、分数和游戏状态等
  * 作为游戏逻辑的数据中心，为控制器和视图提供数据支持
  * 
+ * 卡牌数据保存在紧凑的PackedGameState中，位置保存在只读的CardLayoutTable中
+ * 视图需要的CardModel列表通过exportHandCards/exportPlayfieldCards按需生成
+ * 
  * 职责：
  * - 维护游戏中所有卡牌的状态和位置
  * - 管理游戏进度和分数统计
@@ -25,10 +46,9 @@
  * - 游戏状态的保存和恢复
  */
 struct GameModel {
-    std::vector<CardModel> handCards;      ///< 手牌列表，存储玩家当前持有的卡牌
-    std::vector<CardModel> playfieldCards; ///< 牌桌卡牌列表，存储场上的所有卡牌
-    int currentLevel;                      ///< 当前游戏关卡等级
-    int score;                            ///< 当前游戏得分
+    PackedGameState state;                ///< 核心游戏状态，可直接memcpy
+    CardLayoutTable layout;               ///< 卡牌布局表
+    int currentLevel;                     ///< 当前游戏关卡等级
     bool isGameOver;                      ///< 游戏结束标志，true表示游戏已结束
     bool isGameWon;                       ///< 游戏胜利标志，true表示玩家获胜
     
@@ -40,19 +60,23 @@ struct GameModel {
     GameModel();
     
     /**
-     * @brief 获取顶部手牌
+     * @brief 加入一张手牌（放在手牌顶部）
      * 
-     * @return 返回手牌堆顶的卡牌指针，如果手牌为空则返回nullptr
+     * @param face 牌面
+     * @param suit 花色
+     * @return 分配的卡牌ID，超出容量或卡牌无效返回-1
      */
-    CardModel* getTopHandCard();
+    int addHandCard(CardFaceType face, CardSuitType suit);
     
     /**
-     * @brief 根据ID查找牌桌卡牌
+     * @brief 加入一张牌桌卡牌（放在最上层）
      * 
-     * @param cardId 要查找的卡牌ID
-     * @return 返回找到的卡牌指针，如果未找到则返回nullptr
+     * @param face 牌面
+     * @param suit 花色
+     * @param position 卡牌位置
+     * @return 分配的卡牌ID，超出容量或卡牌无效返回-1
      */
-    CardModel* findPlayfieldCardById(int cardId);
+    int addPlayfieldCard(CardFaceType face, CardSuitType suit, const GameVec2& position);
     
     /**
      * @brief 移除牌桌卡牌
@@ -62,10 +86,29 @@ struct GameModel {
      */
     bool removePlayfieldCard(int cardId);
     
+    /**
+     * @brief 获取当前得分
+     */
+    int getScore() const { return state.score; }
+    
+    /**
+     * @brief 生成视图使用的手牌列表
+     * 
+     * @param out 输出列表，会先被清空；调用方可复用同一个列表避免重复分配
+     */
+    void exportHandCards(std::vector<CardModel>& out) const;
+    
+    /**
+     * @brief 生成视图使用的牌桌卡牌列表
+     * 
+     * @param out 输出列表，会先被清空；调用方可复用同一个列表避免重复分配
+     */
+    void exportPlayfieldCards(std::vector<CardModel>& out) const;
+    
     /**
      * @brief 重置游戏状态
      * 
-     * 将游戏模型恢复到初始状态，清空所有卡牌和重置分数
+     * 将游戏模型恢复到初始状态，清空所有卡牌、布局和分数
      */
     void reset();
     
@@ -82,6 +125,34 @@ struct GameModel {
      * @return 满足失败条件返回true，否则返回false
      */
     bool checkLoseCondition() const;
+    
+    /**
+     * @brief 计算游戏状态的哈希值
+     * 
+     * 对手牌顺序、按卡牌ID排列的牌桌卡牌、分数、胜负标志和非经典的规则集做FNV-1a哈希，
+     * 与槽位映射内部的排列无关，因此经不同撤销路径到达的相同状态哈希值相同
+     * 用于输入回放时逐位校验对局结果
+     * @return 64位哈希值
+     */
+    uint64_t computeStateHash() const;
+    
+private:
+    /**
+     * @brief 检查牌面和花色是否有效
+     */
+    static bool isValidCard(CardFaceType face, CardSuitType suit);
+    
+    /**
+     * @brief 分配新的卡牌ID并记录位置
+     * 
+     * @return 分配的卡牌ID，超出容量返回-1
+     */
+    int allocateCardId(const GameVec2& position);
+    
+    /**
+     * @brief 由打包卡牌生成视图使用的卡牌模型
+     */
+    CardModel makeCardModel(PackedCard card, int cardId) const;
 };
 
-#endif // __GAME_MODEL_H__
\ No newline at end of file
+#endif // __GAME_MODEL_H__
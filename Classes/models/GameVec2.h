@@ -0,0 +1,32 @@
+﻿#ifndef __GAME_VEC2_H__
+#define __GAME_VEC2_H__
+
+/**
+ * @struct GameVec2
+ * @brief 游戏核心使用的二维向量
+ *
+ * 只包含坐标数据和最基本的运算，使游戏规则代码不依赖cocos2d::Vec2
+ * 视图层需要cocos2d::Vec2时按x、y分量转换
+ */
+struct GameVec2 {
+    float x;    ///< x坐标
+    float y;    ///< y坐标
+
+    /**
+     * @brief 构造零向量
+     */
+    GameVec2() : x(0.0f), y(0.0f) {}
+
+    /**
+     * @brief 由坐标构造向量
+     */
+    GameVec2(float xx, float yy) : x(xx), y(yy) {}
+
+    GameVec2 operator+(const GameVec2& other) const { return GameVec2(x + other.x, y + other.y); }
+    GameVec2 operator-(const GameVec2& other) const { return GameVec2(x - other.x, y - other.y); }
+    GameVec2 operator*(float scale) const { return GameVec2(x * scale, y * scale); }
+    bool operator==(const GameVec2& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const GameVec2& other) const { return !(*this == other); }
+};
+
+#endif // __GAME_VEC2_H__
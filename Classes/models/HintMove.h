@@ -0,0 +1,35 @@
+﻿#ifndef __HINT_MOVE_H__
+#define __HINT_MOVE_H__
+
+/**
+ * @struct HintOptions
+ * @brief 提示搜索参数
+ */
+struct HintOptions {
+    static const int DEFAULT_MAX_DEPTH = 3;     ///< 默认前瞻步数，50张牌桌卡牌时同步计算在1毫秒内
+
+    int maxDepth;           ///< 最多前瞻的步数（一步为一次匹配，可能先切换手牌）
+    int timeBudgetMicros;   ///< 时间预算（微秒），超时返回已完成的最深一层结果；0表示不限
+
+    HintOptions() : maxDepth(DEFAULT_MAX_DEPTH), timeBudgetMicros(0) {}
+};
+
+/**
+ * @struct HintMove
+ * @brief 提示的下一步操作
+ */
+struct HintMove {
+    int handCardId;         ///< 需要先切换到顶部的手牌ID，顶部手牌可直接匹配时为-1
+    int playfieldCardId;    ///< 建议匹配的牌桌卡牌ID，没有可行操作时为-1
+    int depth;              ///< 得出该结果的前瞻步数
+    int value;              ///< 前瞻评估值，越大越好
+
+    HintMove() : handCardId(-1), playfieldCardId(-1), depth(0), value(0) {}
+
+    /**
+     * @brief 检查是否给出了可行操作
+     */
+    bool isValid() const { return playfieldCardId >= 0; }
+};
+
+#endif // __HINT_MOVE_H__
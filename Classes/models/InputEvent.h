@@ -0,0 +1,31 @@
+﻿#ifndef __INPUT_EVENT_H__
+#define __INPUT_EVENT_H__
+
+#include <cstdint>
+
+/**
+ * @enum InputOp
+ * @brief 玩家输入类型
+ *
+ * 与MoveLogOp不同，输入记录的是玩家的每一次点击，包括被规则拒绝的点击
+ */
+enum InputOp
+{
+    IO_HAND_CLICK,          ///< 点击手牌
+    IO_PLAYFIELD_CLICK,     ///< 点击牌桌卡牌
+    IO_UNDO,                ///< 点击撤销按钮
+    IO_REDO,                ///< 点击重做按钮
+    IO_NUM_OPS              ///< 输入类型数量
+};
+
+/**
+ * @struct InputEvent
+ * @brief 带帧序号的单次玩家输入
+ */
+struct InputEvent {
+    uint32_t frame;         ///< 输入发生的帧序号，从录制开始时计为0
+    uint8_t op;             ///< 输入类型（InputOp）
+    uint8_t cardId;         ///< 被点击的卡牌ID，撤销和重做时为0
+};
+
+#endif // __INPUT_EVENT_H__
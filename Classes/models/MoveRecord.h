@@ -0,0 +1,40 @@
+﻿#ifndef __MOVE_RECORD_H__
+#define __MOVE_RECORD_H__
+
+#include "PackedGameState.h"
+#include <cstdint>
+
+/**
+ * @enum MoveType
+ * @brief 玩家操作类型枚举
+ */
+enum MoveType
+{
+    MT_HAND_REPLACE,        ///< 点击手牌，将其移到顶部
+    MT_PLAYFIELD_MATCH      ///< 点击牌桌卡牌，与顶部手牌匹配
+};
+
+/**
+ * @struct MoveRecord
+ * @brief 单步操作的可逆增量记录
+ *
+ * 只记录撤销和重做一步操作所需的最少信息，不复制整个游戏状态
+ * 结构体为POD类型，可直接存放在预分配的环形缓冲区中
+ *
+ * 字段含义：
+ * - MT_HAND_REPLACE：sourceIndex为被点击手牌原来的下标
+ * - MT_PLAYFIELD_MATCH：previousTopCard/previousTopId为被替换掉的顶部手牌，
+ *   scoreDelta为本步得分；牌桌卡牌以ID为键存放，sourceIndex不使用
+ */
+struct MoveRecord {
+    uint8_t type;                 ///< 操作类型（MoveType）
+    uint8_t cardId;               ///< 被点击的卡牌ID
+    uint8_t sourceIndex;          ///< 手牌在原手牌中的下标
+    uint8_t previousTopId;        ///< 操作前的顶部手牌ID
+    PackedCard previousTopCard;   ///< 操作前的顶部手牌
+    int32_t scoreDelta;           ///< 本步操作的得分变化
+};
+
+static_assert(std::is_trivially_copyable<MoveRecord>::value, "MoveRecord must be memcpy-able");
+
+#endif // __MOVE_RECORD_H__
@@ -0,0 +1,211 @@
+﻿#ifndef __PACKED_GAME_STATE_H__
+#define __PACKED_GAME_STATE_H__
+
+#include "../configs/CardTypes.h"
+#include "../configs/RuleSetType.h"
+#include "FaceMatchIndex.h"
+#include "../utils/SlotMap.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @struct PackedCard
+ * @brief 单字节卡牌
+ *
+ * 低4位保存牌面（0-12），第4、5位保存花色（0-3）
+ * 用于核心游戏状态中的紧凑存储和快速比较
+ */
+struct PackedCard {
+    uint8_t bits;   ///< 打包后的卡牌数据
+
+    /**
+     * @brief 由牌面和花色打包一张卡牌
+     *
+     * @param face 牌面
+     * @param suit 花色
+     * @return 打包后的卡牌
+     */
+    static PackedCard make(CardFaceType face, CardSuitType suit) {
+        PackedCard card;
+        card.bits = static_cast<uint8_t>(((static_cast<int>(suit) & 0x03) << 4) | (static_cast<int>(face) & 0x0F));
+        return card;
+    }
+
+    /**
+     * @brief 获取牌面
+     */
+    CardFaceType face() const { return static_cast<CardFaceType>(bits & 0x0F); }
+
+    /**
+     * @brief 获取花色
+     */
+    CardSuitType suit() const { return static_cast<CardSuitType>((bits >> 4) & 0x03); }
+
+    bool operator==(const PackedCard& other) const { return bits == other.bits; }
+    bool operator!=(const PackedCard& other) const { return bits != other.bits; }
+};
+
+/**
+ * @struct PackedGameState
+ * @brief 紧凑的核心游戏状态
+ *
+ * 手牌以定长的结构数组（SoA）形式保存：牌面和卡牌ID分列存放，每张卡牌各占一个字节
+ * 牌桌卡牌保存在以卡牌ID为键的槽位映射中，按ID查找和移除都是O(1)
+ * 卡牌ID即卡牌在布局表中的下标，位置信息不在此结构中
+ * 整个结构可以直接memcpy，用作撤销快照或模拟对局的状态
+ *
+ * 卡牌的增删都要通过本结构的方法进行，以便同步维护内嵌的牌面匹配索引
+ *
+ * 手牌数组末尾的卡牌为顶部手牌；牌桌卡牌在槽位映射中的顺序不固定，
+ * 层级由卡牌ID决定（按关卡配置顺序分配，ID越大越在上层）
+ *
+ * ruleSet为关卡的规则集，匹配、计分和结束判断按它分派到对应的规则实例
+ */
+struct PackedGameState {
+    static const int MAX_HAND_CARDS = 64;        ///< 手牌最大数量
+    static const int MAX_PLAYFIELD_CARDS = 128;  ///< 牌桌卡牌最大数量
+    static const int MAX_CARDS = MAX_HAND_CARDS + MAX_PLAYFIELD_CARDS; ///< 一局中的卡牌总数上限
+
+    PackedCard handCards[MAX_HAND_CARDS];            ///< 手牌牌面
+    uint8_t handIds[MAX_HAND_CARDS];                 ///< 手牌ID
+    SlotMap<PackedCard, MAX_PLAYFIELD_CARDS, MAX_CARDS> playfield; ///< 牌桌卡牌，以卡牌ID为键
+    uint8_t handCount;                               ///< 手牌数量
+    uint8_t ruleSet;                                 ///< 规则集（RuleSetType）
+    int32_t score;                                   ///< 当前得分
+    FaceMatchIndex faceIndex;                        ///< 牌面匹配索引
+
+    /**
+     * @brief 清空所有卡牌和得分，规则集回到经典规则
+     */
+    void clear() {
+        handCount = 0;
+        ruleSet = RST_CLASSIC;
+        playfield.clear();
+        score = 0;
+        faceIndex.clear();
+    }
+
+    /**
+     * @brief 检查是否有顶部手牌
+     */
+    bool hasTopHandCard() const { return handCount > 0; }
+
+    /**
+     * @brief 获取顶部手牌，调用前需确认手牌不为空
+     */
+    PackedCard topHandCard() const { return handCards[handCount - 1]; }
+
+    /**
+     * @brief 获取顶部手牌ID，调用前需确认手牌不为空
+     */
+    int topHandId() const { return handIds[handCount - 1]; }
+
+    /**
+     * @brief 根据ID查找手牌下标
+     *
+     * @param cardId 卡牌ID
+     * @return 找到返回下标，否则返回-1
+     */
+    int findHandIndex(int cardId) const {
+        for (int i = 0; i < handCount; ++i) {
+            if (handIds[i] == cardId) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief 在手牌顶部加入一张卡牌
+     *
+     * @return 成功返回true，手牌已满返回false
+     */
+    bool pushHandCard(PackedCard card, int cardId) {
+        if (handCount >= MAX_HAND_CARDS) {
+            return false;
+        }
+        handCards[handCount] = card;
+        handIds[handCount] = static_cast<uint8_t>(cardId);
+        handCount++;
+        faceIndex.addHandCard(card.face());
+        return true;
+    }
+
+    /**
+     * @brief 替换顶部手牌，调用前需确认手牌不为空
+     */
+    void setTopHandCard(PackedCard card, int cardId) {
+        faceIndex.removeHandCard(handCards[handCount - 1].face());
+        handCards[handCount - 1] = card;
+        handIds[handCount - 1] = static_cast<uint8_t>(cardId);
+        faceIndex.addHandCard(card.face());
+    }
+
+    /**
+     * @brief 获取牌桌卡牌数量
+     */
+    int playfieldCount() const { return playfield.size(); }
+
+    /**
+     * @brief 在牌桌加入一张卡牌
+     *
+     * @return 成功返回true，牌桌已满或ID已存在返回false
+     */
+    bool pushPlayfieldCard(PackedCard card, int cardId) {
+        if (playfield.size() >= MAX_PLAYFIELD_CARDS || playfield.contains(cardId)) {
+            return false;
+        }
+        playfield.insert(cardId, card);
+        faceIndex.addPlayfieldCard(card.face(), cardId);
+        return true;
+    }
+
+    /**
+     * @brief 移除一张牌桌卡牌
+     *
+     * @param handle 卡牌句柄，调试构建下句柄失效会触发断言
+     * @return 移除成功返回true，句柄失效返回false
+     */
+    bool removePlayfieldCard(SlotHandle handle) {
+        const PackedCard* card = playfield.get(handle);
+        if (!card) {
+            return false;
+        }
+        faceIndex.removePlayfieldCard(card->face(), handle.key);
+        return playfield.erase(handle);
+    }
+
+    /**
+     * @brief 将指定下标的手牌移到顶部，其余手牌保持相对顺序
+     */
+    void moveHandCardToTop(int index) {
+        PackedCard card = handCards[index];
+        uint8_t cardId = handIds[index];
+        int tail = handCount - index - 1;
+        std::memmove(&handCards[index], &handCards[index + 1], tail * sizeof(PackedCard));
+        std::memmove(&handIds[index], &handIds[index + 1], tail * sizeof(uint8_t));
+        handCards[handCount - 1] = card;
+        handIds[handCount - 1] = cardId;
+    }
+
+    /**
+     * @brief 将顶部手牌移回指定下标，是moveHandCardToTop的逆操作
+     */
+    void moveTopHandCardTo(int index) {
+        PackedCard card = handCards[handCount - 1];
+        uint8_t cardId = handIds[handCount - 1];
+        int tail = handCount - index - 1;
+        std::memmove(&handCards[index + 1], &handCards[index], tail * sizeof(PackedCard));
+        std::memmove(&handIds[index + 1], &handIds[index], tail * sizeof(uint8_t));
+        handCards[index] = card;
+        handIds[index] = cardId;
+    }
+
+};
+
+static_assert(PackedGameState::MAX_CARDS <= FaceMatchIndex::MAX_CARD_IDS, "FaceMatchIndex must cover every card id");
+static_assert(sizeof(PackedCard) == 1, "PackedCard must stay one byte");
+static_assert(std::is_trivially_copyable<PackedGameState>::value, "PackedGameState must be memcpy-able");
+
+#endif // __PACKED_GAME_STATE_H__
@@ -0,0 +1,54 @@
+﻿#ifndef __SCORE_EVENT_H__
+#define __SCORE_EVENT_H__
+
+#include <cstdint>
+
+/**
+ * @enum ScoreEventType
+ * @brief 计分事件类型
+ */
+enum ScoreEventType
+{
+    SET_MATCH,              ///< 一次成功的匹配，携带规则给出的匹配得分
+    SET_SWAP,               ///< 把一张手牌换到顶部，打断连击
+    SET_UNDO,               ///< 撤销最近一步，连同其奖励一起回退
+    SET_MISS,               ///< 被规则拒绝的牌桌点击，此后不再是完美对局
+    SET_WIN,                ///< 清空牌桌，结算完成奖励和时间奖励
+    SET_NUM_TYPES           ///< 事件类型数量
+};
+
+/**
+ * @struct ScoreEvent
+ * @brief 带帧序号的计分事件
+ *
+ * 帧序号与输入录制使用同一个计数，客户端和服务端据此算出相同的用时
+ */
+struct ScoreEvent {
+    uint32_t frame;         ///< 事件发生的帧序号
+    uint8_t type;           ///< 事件类型（ScoreEventType）
+    int32_t matchPoints;    ///< SET_MATCH的匹配得分，其余类型为0
+
+    ScoreEvent() : frame(0), type(SET_SWAP), matchPoints(0) {}
+    ScoreEvent(uint32_t eventFrame, ScoreEventType eventType, int32_t points = 0)
+        : frame(eventFrame), type(static_cast<uint8_t>(eventType)), matchPoints(points) {}
+};
+
+/**
+ * @struct ScoreBreakdown
+ * @brief 按来源分开的得分
+ */
+struct ScoreBreakdown {
+    int32_t matchPoints;        ///< 匹配得分之和，与核心状态中的分数相同
+    int32_t comboBonus;         ///< 连击奖励之和
+    int32_t timeBonus;          ///< 时间奖励
+    int32_t completionBonus;    ///< 完成奖励
+
+    ScoreBreakdown() : matchPoints(0), comboBonus(0), timeBonus(0), completionBonus(0) {}
+
+    /**
+     * @brief 获取总分
+     */
+    int32_t total() const { return matchPoints + comboBonus + timeBonus + completionBonus; }
+};
+
+#endif // __SCORE_EVENT_H__
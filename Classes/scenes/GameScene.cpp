@@ -1,17 +1,51 @@
 ﻿#include "GameScene.h"
 #include "HelloWorldScene.h"
 #include "../utils/GameUtils.h"
-#include "../configs/LevelConfig.h"
 #include "../configs/CardTypes.h"
+#include "../services/GameService.h"
+#include "../services/LevelGenerationService.h"
 #include "ui/CocosGUI.h"
 
 USING_NS_CC;
 
+// 操作日志写出间隔（秒）和定时器的键
+static const float MOVE_LOG_FLUSH_INTERVAL = 0.25f;
+static const char* MOVE_LOG_FLUSH_KEY = "move_log_flush";
+
+// 关卡使用固定布局，暂无发牌随机种子；回退关卡也由该种子生成，恢复会话时牌面不变
+static const uint32_t LEVEL_SEED = 0;
+
+// 关卡包文件；没有关卡包时只使用默认关卡文件
+static const char* LEVEL_PACK_FILE = "levels/levels.cglp";
+static const char* DEFAULT_LEVEL_FILE = "levels/level1.json";
+static const int DEFAULT_LEVEL_ID = 1;
+
 // 创建场景
 Scene* GameScene::createScene() {
     return GameScene::create();
 }
 
+// 构造函数
+GameScene::GameScene()
+    : m_gameContext(nullptr), m_gameModel(nullptr), m_gameController(nullptr), m_gameView(nullptr)
+    , m_moveLog(nullptr), m_inputRecorder(nullptr), m_levelCatalogue(nullptr), m_levelIndex(0) {
+}
+
+// 析构函数
+GameScene::~GameScene() {
+    if (m_moveLog) {
+        getScheduler()->unschedule(MOVE_LOG_FLUSH_KEY, m_moveLog);
+    }
+    
+    // 控制器和关卡目录先于视图销毁，其存活标记失效后，回到主线程的提示和预取结果不再访问视图
+    CC_SAFE_DELETE(m_gameController);
+    CC_SAFE_DELETE(m_levelCatalogue);
+    CC_SAFE_DELETE(m_inputRecorder);
+    CC_SAFE_DELETE(m_moveLog);
+    CC_SAFE_DELETE(m_gameContext);
+    m_gameModel = nullptr;
+}
+
 // 初始化
 bool GameScene::init() {
     if (!Scene::init()) {
@@ -26,19 +60,40 @@ bool GameScene::init() {
     // 创建UI
     createUI();
     
-    // 创建测试数据
-    createTestData();
+    // 先加载上次未完成的对局所在的关卡，没有可恢复的日志时从第一关开始
+    loadLevel(getLoggedLevelIndex());
+    
+    // 恢复上次未完成的对局
+    resumeOrStartSession();
+    
+    // 有待写出的操作时才定期写入文件，静止的牌桌不被写出定时器唤醒
+    getScheduler()->schedule([this](float) {
+        flushMoveLog();
+    }, m_moveLog, MOVE_LOG_FLUSH_INTERVAL, true, MOVE_LOG_FLUSH_KEY);
+    m_moveLog->setPendingCallback([this]() {
+        getScheduler()->resumeTarget(m_moveLog);
+    });
     
     return true;
 }
 
+// 离开场景
+void GameScene::onExit() {
+    if (m_moveLog) {
+        m_moveLog->close();
+    }
+    saveInputRecording();
+    Scene::onExit();
+}
+
 // 初始化游戏组件
 bool GameScene::initGameComponents() {
-    // 创建游戏数据模型
-    m_gameModel = new (std::nothrow) GameModel();
-    if (!m_gameModel) {
+    // 创建本局游戏的上下文
+    m_gameContext = new (std::nothrow) GameContext(LEVEL_SEED);
+    if (!m_gameContext) {
         return false;
     }
+    m_gameModel = &m_gameContext->getModel();
     
     // 创建游戏视图
     m_gameView = GameView::create();
@@ -49,18 +104,34 @@ bool GameScene::initGameComponents() {
     
     // 创建游戏控制器
     m_gameController = new (std::nothrow) GameController();
-    if (!m_gameController || !m_gameController->init(m_gameModel, m_gameView)) {
+    if (!m_gameController || !m_gameController->init(m_gameContext, m_gameView)) {
         return false;
     }
     
-    // 创建撤销管理器
-    m_undoManager = new (std::nothrow) UndoManager();
-    if (!m_undoManager || !m_undoManager->init(m_gameModel)) {
+    // 创建操作日志
+    m_moveLog = new (std::nothrow) MoveLog();
+    if (!m_moveLog) {
         return false;
     }
+    m_gameController->setMoveLog(m_moveLog);
     
-    // 设置控制器的撤销管理器
-    m_gameController->setUndoManager(m_undoManager);
+    // 创建输入录制器
+    m_inputRecorder = new (std::nothrow) InputRecorder();
+    if (!m_inputRecorder) {
+        return false;
+    }
+    m_gameController->setInputRecorder(m_inputRecorder);
+    
+    // 打开关卡目录，后续关卡预取完成时按其卡牌数预热卡牌视图池，切换关卡时不再创建卡牌节点
+    m_levelCatalogue = new (std::nothrow) LevelCatalogue();
+    if (!m_levelCatalogue) {
+        return false;
+    }
+    m_levelCatalogue->open(LEVEL_PACK_FILE, std::vector<std::string>(1, DEFAULT_LEVEL_FILE));
+    m_levelCatalogue->setReadyCallback([this](int index, const PreparedLevel& level) {
+        m_gameView->prewarmCardViews(level.config.playfield.size() + level.config.stack.size());
+    });
+    m_levelIndex = 0;
     
     // 设置游戏结束回调
     m_gameController->setGameEndCallback([this](bool isWin) {
@@ -80,48 +151,37 @@ bool GameScene::initGameComponents() {
         m_gameController->onUndoButtonClicked();
     });
     
+    m_gameView->setRedoButtonClickCallback([this]() {
+        m_gameController->onRedoButtonClicked();
+    });
+    
+    m_gameView->setHintButtonClickCallback([this]() {
+        m_gameController->onHintButtonClicked();
+    });
+    
     return true;
 }
 
-// 创建测试数据
-void GameScene::createTestData() {
-    if (!m_gameModel) {
+// 加载关卡
+void GameScene::loadLevel(int index) {
+    if (!m_gameContext) {
         return;
     }
     
-    // 清除现有数据
-    m_gameModel->reset();
-    
-    // 加载关卡配置
-    auto levelManager = LevelConfigManager::getInstance();
-    if (!levelManager->loadLevel("levels/level1.json")) {
+    // 已预取的关卡只需把模型拷入上下文，否则同步读取
+    m_levelIndex = index;
+    if (!m_levelCatalogue->takeLevel(index, *m_gameContext)) {
         CCLOG("Failed to load level configuration, using default data");
         createDefaultData();
-        return;
     }
+    m_levelCatalogue->prefetch(index);
     
-    const auto& levelConfig = levelManager->getCurrentLevel();
+    // 按关卡卡牌总数预热卡牌视图池，游戏过程中不再创建卡牌节点
+    const LevelConfig& loadedLevel = m_gameContext->getLevelConfig();
+    m_gameView->prewarmCardViews(loadedLevel.playfield.size() + loadedLevel.stack.size());
     
-    // 从堆叠配置创建手牌
-    for (const auto& cardConfig : levelConfig.stack) {
-        CardModel card;
-        card.id = GameUtils::generateUniqueCardId();
-        card.face = static_cast<CardFaceType>(cardConfig.cardFace);
-        card.suit = static_cast<CardSuitType>(cardConfig.cardSuit);
-        card.isFaceUp = true;
-        m_gameModel->handCards.push_back(card);
-    }
-    
-    // 从牌桌配置创建牌桌卡牌
-    for (const auto& cardConfig : levelConfig.playfield) {
-        CardModel card;
-        card.id = GameUtils::generateUniqueCardId();
-        card.face = static_cast<CardFaceType>(cardConfig.cardFace);
-        card.suit = static_cast<CardSuitType>(cardConfig.cardSuit);
-        card.isFaceUp = true;
-        card.position = cardConfig.position;
-        m_gameModel->playfieldCards.push_back(card);
-    }
+    // 旧关卡的提示结果不再有用
+    m_gameController->clearHintCache();
     
     // 刷新视图
     m_gameController->refreshView();
@@ -129,30 +189,124 @@ void GameScene::createTestData() {
 
 // 创建默认数据（回退）
 void GameScene::createDefaultData() {
-    // 创建手牌
-    for (int i = 0; i < 5; i++) {
-        CardModel card;
-        card.id = GameUtils::generateUniqueCardId();
-        card.face = static_cast<CardFaceType>(i + 1);
-        card.suit = CST_HEARTS;
-        card.isFaceUp = true;
-        m_gameModel->handCards.push_back(card);
+    // 沿用原先的布局：5张手牌，3张牌桌卡牌横向排开，牌面由生成器给出以保证可解
+    LevelConfig layout;
+    layout.stack.resize(5);
+    layout.playfield.resize(3);
+    for (int i = 0; i < 3; i++) {
+        layout.playfield[i].position = GameVec2(i * 120.0f, 0.0f);
     }
     
-    // 创建牌桌卡牌
-    for (int i = 0; i < 3; i++) {
-        CardModel card;
-        card.id = GameUtils::generateUniqueCardId();
-        card.face = static_cast<CardFaceType>(i + 2);
-        card.suit = CST_SPADES;
-        card.isFaceUp = true;
-        card.position = Vec2(i * 120, 0);
-        m_gameModel->playfieldCards.push_back(card);
+    // 每次都从种子的初始状态生成，重新开始时得到同一个关卡
+    LevelConfig level;
+    m_gameContext->resetRandom();
+    LevelGenerationService::generateLevel(layout, LevelGenerationParams(), m_gameContext->getRandom(), level);
+    m_gameContext->loadLevel(level, DEFAULT_LEVEL_ID);
+}
+
+// 获取日志所属的关卡下标
+int GameScene::getLoggedLevelIndex() const {
+    MoveLogHeader header;
+    if (!MoveLog::readHeader(getMoveLogPath(), header)) {
+        return 0;
     }
+    
+    // 关卡目录已变化时日志中的关卡可能不存在，此时从第一关开始，会话随后被新建
+    int index = LevelCatalogue::getLevelIndex(header.levelId);
+    if (index < 0 || index >= m_levelCatalogue->getLevelCount()) {
+        return 0;
+    }
+    return index;
+}
+
+// 恢复或新建会话
+void GameScene::resumeOrStartSession() {
+    // 日志没有时间信息，恢复的操作按当前帧计分
+    m_gameContext->getScoringEngine().setClock(getFramesPerSecond(), Director::getInstance()->getTotalFrames());
+    
+    std::string path = getMoveLogPath();
+    std::string error;
+    bool resumed = m_moveLog->resumeSession(path, m_gameModel->currentLevel, m_gameContext->getSeed(),
+        [this](const MoveLogEntry& entry) {
+            return m_gameController->replayLoggedMove(entry);
+        }, &error);
+    
+    if (resumed) {
+        if (m_moveLog->getDroppedEntryCount() > 0) {
+            CCLOG("Move log %s: %d entries could not be replayed, truncated", path.c_str(),
+                  static_cast<int>(m_moveLog->getDroppedEntryCount()));
+        }
+        CCLOG("Move log resumed: %d moves replayed in %.1f us", static_cast<int>(m_moveLog->getEntryCount()),
+              m_moveLog->getLastReplayMicroseconds());
+        
+        // 恢复的对局没有从关卡开始的输入，本次不录制
+        m_inputRecorder->stop();
+        m_gameController->onSessionRestored();
+    } else {
+        CCLOG("Move log %s: %s, starting a new session", path.c_str(), error.c_str());
+        startNewSession();
+    }
+}
+
+// 新建会话
+void GameScene::startNewSession() {
+    std::string error;
+    if (!m_moveLog->startSession(getMoveLogPath(), m_gameModel->currentLevel, m_gameContext->getSeed(), &error)) {
+        CCLOG("Move log unavailable (%s), this session will not be resumable", error.c_str());
+    }
+    
+    // 从关卡初始状态开始录制输入，计分的用时与录制使用同一个帧计数
+    uint32_t startFrame = Director::getInstance()->getTotalFrames();
+    int fps = getFramesPerSecond();
+    m_inputRecorder->begin(InputRecorder::makeHeader(m_gameModel, m_gameContext->getSeed(),
+                                                     m_gameContext->getUndoManager().getMaxUndoSteps(), fps),
+                           startFrame);
+    m_gameContext->getScoringEngine().setClock(fps, startFrame);
+}
+
+// 获取帧率
+int GameScene::getFramesPerSecond() const {
+    return static_cast<int>(1.0f / Director::getInstance()->getAnimationInterval() + 0.5f);
+}
+
+// 写出操作日志
+void GameScene::flushMoveLog() {
+    if (!m_moveLog->update()) {
+        CCLOG("Failed to write move log");
+    }
+    
+    // 已全部写出并同步，暂停定时器直到下一次追加
+    if (!m_moveLog->hasPendingWrites()) {
+        getScheduler()->pauseTarget(m_moveLog);
+    }
+}
+
+// 获取操作日志路径
+std::string GameScene::getMoveLogPath() const {
+    return FileUtils::getInstance()->getWritablePath() + "session.cglog";
+}
+
+// 保存输入录制
+void GameScene::saveInputRecording() {
+    // 回放录制时模型状态不属于正在录制的对局
+    if (!m_inputRecorder || !m_inputRecorder->isRecording() || m_gameController->isReplayingInput()) {
+        return;
+    }
+    if (!m_inputRecorder->saveToFile(getInputRecordingPath(), m_gameModel->computeStateHash(),
+                                     m_gameContext->getScoringEngine().getTotalScore())) {
+        CCLOG("Failed to save the input recording");
+    }
+}
+
+// 获取输入录制路径
+std::string GameScene::getInputRecordingPath() const {
+    return FileUtils::getInstance()->getWritablePath() + "last_session.cgir";
 }
 
 // 游戏结束回调
 void GameScene::onGameEnd(bool isWin) {
+    saveInputRecording();
+
     if (m_gameView) {
         m_gameView->showGameEndDialog(isWin);
     }
@@ -164,11 +318,27 @@ void GameScene::restartGame() {
         m_gameView->hideGameEndDialog();
     }
     
-    if (m_undoManager) {
-        m_undoManager->clear();
+    // 按上下文中保存的关卡配置重新发牌，不再读取关卡文件
+    m_gameController->startNewGame();
+    startNewSession();
+}
+
+// 进入下一关
+void GameScene::goToNextLevel() {
+    int levelCount = m_levelCatalogue->getLevelCount();
+    if (levelCount == 0) {
+        restartGame();
+        return;
     }
     
-    createTestData();
+    if (m_gameView) {
+        m_gameView->hideGameEndDialog();
+    }
+    
+    // 结束当前对局的录制，再切换到已在后台预取好的下一关
+    saveInputRecording();
+    loadLevel((m_levelIndex + 1) % levelCount);
+    startNewSession();
 }
 
 // 创建UI元素
@@ -211,6 +381,24 @@ void GameScene::createUI() {
         }
     });
     this->addChild(restartButton);
+    
+    // 下一关按钮背景
+    auto nextBg = LayerColor::create(Color4B(50, 50, 150, 200), 150, 60);
+    nextBg->setPosition(Vec2(origin.x + visibleSize.width - 380, origin.y + visibleSize.height - 100));
+    this->addChild(nextBg);
+    
+    // 下一关按钮
+    auto nextButton = ui::Button::create();
+    nextButton->setTitleText("Next");
+    nextButton->setTitleFontSize(32);
+    nextButton->setTitleColor(Color3B::WHITE);
+    nextButton->setPosition(Vec2(origin.x + visibleSize.width - 305, origin.y + visibleSize.height - 70));
+    nextButton->addTouchEventListener([this](Ref* sender, ui::Widget::TouchEventType type) {
+        if (type == ui::Widget::TouchEventType::ENDED) {
+            onNextLevelClicked(sender);
+        }
+    });
+    this->addChild(nextButton);
 }
 
 // 返回菜单按钮回调
@@ -222,4 +410,9 @@ void GameScene::onBackToMenuClicked(Ref* sender) {
 // 重启按钮回调
 void GameScene::onRestartClicked(Ref* sender) {
     restartGame();
+}
+
+// 下一关按钮回调
+void GameScene::onNextLevelClicked(Ref* sender) {
+    goToNextLevel();
 }
\ No newline at end of file
@@ -5,7 +5,10 @@
 #include "../models/GameModel.h"
 #include "../controllers/GameController.h"
 #include "../views/GameView.h"
-#include "../managers/UndoManager.h"
+#include "../managers/GameContext.h"
+#include "../managers/MoveLog.h"
+#include "../managers/InputRecording.h"
+#include "../managers/LevelCatalogue.h"
 
 // Game scene class
 class GameScene : public cocos2d::Scene {
@@ -13,33 +16,72 @@ public:
     // Create scene
     static cocos2d::Scene* createScene();
     
+    GameScene();
+    
+    // Delete the game components; their background tasks see the expired tokens and drop their results
+    virtual ~GameScene();
+    
     // Initialize
     virtual bool init() override;
     
+    // Flush and close the move log and save the input recording when leaving the scene
+    virtual void onExit() override;
+    
     // Implement create function
     CREATE_FUNC(GameScene);
     
 private:
-    GameModel* m_gameModel;           // Game data model
+    GameContext* m_gameContext;       // Per-game state: level config, model, undo history and RNG
+    GameModel* m_gameModel;           // Game data model, owned by the game context
     GameController* m_gameController; // Game controller
     GameView* m_gameView;            // Game view
-    UndoManager* m_undoManager;      // Undo manager
+    MoveLog* m_moveLog;              // Append-only move log of the current session
+    InputRecorder* m_inputRecorder;  // Input recording of the current session, for bug reports and replays
+    LevelCatalogue* m_levelCatalogue; // Index of all levels, prefetches the next ones in the background
+    int m_levelIndex;                // Catalogue index of the current level
     
     // Initialize game components
     bool initGameComponents();
     
-    // Create test data
-    void createTestData();
+    // Load a catalogue level into the game context, prefetch the levels after it and refresh the view
+    void loadLevel(int index);
     
     // Create default data (fallback)
     void createDefaultData();
     
+    // Catalogue index of the level the move log belongs to, 0 if there is no usable log
+    int getLoggedLevelIndex() const;
+    
+    // Resume the logged session, or start a new one if there is none
+    void resumeOrStartSession();
+    
+    // Start a new move log session for the current level
+    void startNewSession();
+    
+    // Frame rate used for input recording and score timing
+    int getFramesPerSecond() const;
+    
+    // Write out the move log, and stop the flush timer once nothing is pending
+    void flushMoveLog();
+    
+    // Path of the move log file
+    std::string getMoveLogPath() const;
+    
+    // Save the input recording together with the current state hash and total score
+    void saveInputRecording();
+    
+    // Path of the input recording file
+    std::string getInputRecordingPath() const;
+    
     // Game end callback
     void onGameEnd(bool isWin);
     
     // Restart game
     void restartGame();
     
+    // Move on to the next level in the catalogue
+    void goToNextLevel();
+    
     // Create UI elements
     void createUI();
     
@@ -48,6 +90,9 @@ private:
     
     // Restart button callback
     void onRestartClicked(cocos2d::Ref* sender);
+    
+    // Next level button callback
+    void onNextLevelClicked(cocos2d::Ref* sender);
 };
 
 #endif // __GAME_SCENE_H__
\ No newline at end of file
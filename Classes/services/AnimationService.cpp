@@ -39,27 +39,6 @@ float AnimationService::calculatePlayfieldToHandDuration(int cardId,
     return std::max(0.08f, std::min(duration, 0.6f));
 }
 
-// 创建卡牌移动动画序列
-Action* AnimationService::createCardMoveAnimation(Node* node,
-                                                 const Vec2& targetPos,
-                                                 float duration,
-                                                 const std::function<void()>& onComplete) {
-    if (!node) {
-        return nullptr;
-    }
-    
-    // 创建移动动作，使用缓动效果
-    auto moveAction = EaseOut::create(MoveTo::create(duration, targetPos), 2.0f);
-    
-    if (onComplete) {
-        // 添加完成回调
-        auto callbackAction = CallFunc::create(onComplete);
-        return Sequence::create(moveAction, callbackAction, nullptr);
-    }
-    
-    return moveAction;
-}
-
 // 创建卡牌淡入淡出动画
 Action* AnimationService::createCardFadeAnimation(Node* node,
                                                  bool fadeIn,
@@ -35,19 +35,6 @@ public:
                                                   const cocos2d::Vec2& currentPos, 
                                                   const cocos2d::Vec2& targetPos);
     
-    /**
-     * 创建卡牌移动动画序列
-     * @param node 要动画的节点
-     * @param targetPos 目标位置
-     * @param duration 动画持续时间
-     * @param onComplete 完成回调
-     * @return 动画动作
-     */
-    static cocos2d::Action* createCardMoveAnimation(cocos2d::Node* node,
-                                                   const cocos2d::Vec2& targetPos,
-                                                   float duration,
-                                                   const std::function<void()>& onComplete = nullptr);
-    
     /**
      * 创建卡牌淡入淡出动画
      * @param node 要动画的节点
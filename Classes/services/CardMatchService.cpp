@@ -1,14 +1,45 @@
 ﻿#include "CardMatchService.h"
+#include "RuleEngine.h"
+#include "RuleRegistry.h"
 #include "../utils/GameUtils.h"
 #include <algorithm>
 #include <cmath>
 
+namespace {
+
+/**
+ * @brief 以指定规则列出可匹配的牌桌卡牌
+ */
+template <typename Rules>
+struct MatchableCardsOp {
+    static int run(const PackedGameState& state, PackedCard card, uint8_t* ids) {
+        return RuleEngine<Rules>::collectMatchableCards(state, card, ids);
+    }
+};
+
+/**
+ * @brief 以指定规则检查是否有任意手牌能匹配
+ */
+template <typename Rules>
+struct AnyMatchOp {
+    static bool run(const PackedGameState& state) {
+        return RuleEngine<Rules>::anyHandCanMatch(state);
+    }
+};
+
+} // namespace
+
 // 检查两张卡牌是否可以匹配
 bool CardMatchService::canMatch(const CardModel& card1, const CardModel& card2) {
     // 使用现有的GameUtils匹配逻辑
     return GameUtils::canMatch(card1, card2);
 }
 
+// 检查两张打包卡牌是否可以匹配
+bool CardMatchService::canMatch(PackedCard card1, PackedCard card2) {
+    return ClassicMatch::canMatch(card1, card2);
+}
+
 // 查找所有可以与指定卡牌匹配的卡牌
 std::vector<int> CardMatchService::findMatchableCards(const CardModel& targetCard, 
                                                      const std::vector<CardModel>& candidateCards) {
@@ -23,6 +54,14 @@ std::vector<int> CardMatchService::findMatchableCards(const CardModel& targetCar
     return matchableCardIds;
 }
 
+// 查找牌桌上可以与指定卡牌匹配的卡牌
+std::vector<int> CardMatchService::findMatchableCards(PackedCard targetCard, const PackedGameState& state) {
+    // 只遍历可匹配牌面的桶
+    uint8_t ids[PackedGameState::MAX_PLAYFIELD_CARDS];
+    int count = RuleRegistry::dispatch<MatchableCardsOp>(state.ruleSet, state, targetCard, ids);
+    return std::vector<int>(ids, ids + count);
+}
+
 // 检查是否还有可能的匹配
 bool CardMatchService::hasAnyPossibleMatch(const std::vector<CardModel>& handCards,
                                           const std::vector<CardModel>& playfieldCards) {
@@ -38,6 +77,11 @@ bool CardMatchService::hasAnyPossibleMatch(const std::vector<CardModel>& handCar
     return false;
 }
 
+// 检查核心状态中是否还有可能的匹配
+bool CardMatchService::hasAnyPossibleMatch(const PackedGameState& state) {
+    return RuleRegistry::dispatch<AnyMatchOp>(state.ruleSet, state);
+}
+
 // 获取匹配难度系数
 float CardMatchService::getMatchDifficulty(const CardModel& card1, const CardModel& card2) {
     int faceDiff = calculateFaceDifference(card1, card2);
@@ -2,6 +2,7 @@
 #define __CARD_MATCH_SERVICE_H__
 
 #include "../models/CardModel.h"
+#include "../models/PackedGameState.h"
 #include <vector>
 
 /**
@@ -21,6 +22,14 @@ public:
      */
     static bool canMatch(const CardModel& card1, const CardModel& card2);
     
+    /**
+     * 检查两张打包卡牌按经典规则是否可以匹配
+     * @param card1 第一张卡牌
+     * @param card2 第二张卡牌
+     * @return 是否可以匹配
+     */
+    static bool canMatch(PackedCard card1, PackedCard card2);
+    
     /**
      * 查找所有可以与指定卡牌匹配的卡牌
      * @param targetCard 目标卡牌
@@ -30,6 +39,16 @@ public:
     static std::vector<int> findMatchableCards(const CardModel& targetCard, 
                                                const std::vector<CardModel>& candidateCards);
     
+    /**
+     * 查找牌桌上所有可以与指定卡牌匹配的卡牌
+     * 
+     * 按核心状态的规则集只遍历可匹配牌面的桶，耗时与这些桶中的卡牌数成正比
+     * @param targetCard 目标卡牌
+     * @param state 核心游戏状态
+     * @return 可匹配的牌桌卡牌ID列表，按牌面分组，组内顺序不定
+     */
+    static std::vector<int> findMatchableCards(PackedCard targetCard, const PackedGameState& state);
+    
     /**
      * 检查是否还有可能的匹配
      * @param handCards 手牌列表
@@ -39,6 +58,15 @@ public:
     static bool hasAnyPossibleMatch(const std::vector<CardModel>& handCards,
                                    const std::vector<CardModel>& playfieldCards);
     
+    /**
+     * 检查核心状态中是否还有可能的匹配
+     * 
+     * 按核心状态的规则集判断；只看牌面的规则使用牌面掩码在常数时间内判断
+     * @param state 核心游戏状态
+     * @return 是否有任意手牌能与任意牌桌卡牌匹配
+     */
+    static bool hasAnyPossibleMatch(const PackedGameState& state);
+    
     /**
      * 获取匹配难度系数
      * @param card1 第一张卡牌
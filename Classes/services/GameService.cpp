@@ -1,60 +1,320 @@
 ﻿#include "GameService.h"
 #include "CardMatchService.h"
 #include "ScoreService.h"
+#include "RuleEngine.h"
+#include "RuleRegistry.h"
+#include "../managers/HintCache.h"
+#include "../managers/UndoManager.h"
+#include "../solver/FaceState.h"
 #include "../utils/GameUtils.h"
 #include <algorithm>
+#include <chrono>
 
-// 执行手牌替换逻辑
-bool GameService::executeHandCardReplacement(GameModel* gameModel, int cardId) {
-    if (!gameModel || gameModel->handCards.empty()) {
+namespace {
+
+const int HINT_MATCH_GAIN = 2;          ///< 每次匹配的得分
+const int HINT_SWITCH_COST = 1;         ///< 每次切换手牌的扣分
+const int HINT_WIN_VALUE = 1000;        ///< 前瞻内清空牌桌的得分
+const int HINT_DEAD_VALUE = -100;       ///< 前瞻内走入死局的得分
+const int HINT_DEADLINE_CHECK_MASK = 255; ///< 每展开多少个节点检查一次时间
+
+/**
+ * @class HintSearch
+ * @brief 一次提示计算的有界前瞻搜索，以匹配规则实例化
+ */
+template <typename Match>
+class HintSearch {
+public:
+    HintSearch(HintCache& cache, int timeBudgetMicros)
+        : m_cache(cache)
+        , m_hasDeadline(timeBudgetMicros > 0)
+        , m_deadline(std::chrono::steady_clock::now() + std::chrono::microseconds(timeBudgetMicros))
+        , m_nodes(0)
+        , m_aborted(false) {
+    }
+    
+    bool isAborted() const { return m_aborted; }
+    
+    /**
+     * @brief 评估状态在剩余depth步内能达到的最好结果
+     *
+     * @param best 输出最佳的一步，可为空；没有可行步时handKind为FaceStep::NONE
+     */
+    int evaluate(const FaceState<Match>& state, int depth, FaceStep* best) {
+        if (best) {
+            best->handKind = FaceStep::NONE;
+        }
+        if (state.remaining == 0) {
+            // 越早清空越好
+            return HINT_WIN_VALUE + depth;
+        }
+        if (state.isDead()) {
+            return HINT_DEAD_VALUE;
+        }
+        if (depth == 0) {
+            return 0;
+        }
+        
+        HintCacheEntry entry;
+        if (m_cache.find(state.hash, depth, entry)) {
+            if (best) {
+                *best = entry.best;
+            }
+            return entry.value;
+        }
+        
+        if ((++m_nodes & HINT_DEADLINE_CHECK_MASK) == 0 && m_hasDeadline &&
+            std::chrono::steady_clock::now() > m_deadline) {
+            m_aborted = true;
+        }
+        if (m_aborted) {
+            return 0;
+        }
+        
+        FaceStep steps[FaceState<Match>::MAX_STEPS];
+        int stepCount = state.generateSteps(steps);
+        entry.hash = state.hash;
+        entry.depth = static_cast<uint8_t>(depth);
+        entry.value = 0;
+        entry.best = steps[0];
+        int bestValue = 0;
+        for (int i = 0; i < stepCount; ++i) {
+            int gain = HINT_MATCH_GAIN - (state.needsSwitch(steps[i]) ? HINT_SWITCH_COST : 0);
+            int value = gain + evaluate(state.apply(steps[i]), depth - 1, nullptr);
+            if (m_aborted) {
+                return 0;
+            }
+            if (i == 0 || value > bestValue) {
+                bestValue = value;
+                entry.best = steps[i];
+            }
+        }
+        
+        // 只缓存完整评估的结果
+        entry.value = static_cast<int16_t>(bestValue);
+        m_cache.store(entry);
+        if (best) {
+            *best = entry.best;
+        }
+        return bestValue;
+    }
+    
+private:
+    HintCache& m_cache;
+    bool m_hasDeadline;
+    std::chrono::steady_clock::time_point m_deadline;
+    uint32_t m_nodes;
+    bool m_aborted;
+};
+
+/**
+ * @brief 以指定规则计算提示
+ */
+template <typename Rules>
+struct ComputeHintOp {
+    static bool run(const PackedGameState& state, HintCache& cache, HintMove& hint, const HintOptions& options) {
+        typedef FaceState<typename Rules::MatchRule> State;
+        State root = State::fromPacked(state);
+        HintSearch<typename Rules::MatchRule> search(cache, options.timeBudgetMicros);
+        
+        // 逐层加深，超时时保留已完成的最深一层
+        FaceStep bestStep;
+        bestStep.handKind = FaceStep::NONE;
+        for (int depth = 1; depth <= options.maxDepth; ++depth) {
+            FaceStep step;
+            int value = search.evaluate(root, depth, &step);
+            if (search.isAborted()) {
+                break;
+            }
+            bestStep = step;
+            hint.depth = depth;
+            hint.value = value;
+        }
+        
+        if (bestStep.handKind == FaceStep::NONE) {
+            return false;
+        }
+        return State::resolveStep(state, bestStep, hint.handCardId, hint.playfieldCardId);
+    }
+};
+
+/**
+ * @brief 以指定规则执行桌面卡牌匹配
+ */
+template <typename Rules>
+struct PlayfieldMatchOp {
+    static bool run(PackedGameState& state, int cardId, MoveRecord* record) {
+        return RuleEngine<Rules>::executePlayfieldCardMatch(state, cardId, record);
+    }
+};
+
+/**
+ * @brief 以指定规则检查游戏是否结束
+ */
+template <typename Rules>
+struct GameEndOp {
+    static int run(const PackedGameState& state) {
+        return RuleEngine<Rules>::checkGameEnd(state);
+    }
+};
+
+} // namespace
+
+// 按关卡配置重建游戏数据
+bool GameService::loadLevel(GameModel* gameModel, const LevelConfig& level) {
+    if (!gameModel) {
         return false;
     }
     
-    // 查找被点击的卡牌
-    auto it = std::find_if(gameModel->handCards.begin(), gameModel->handCards.end(),
-        [cardId](const CardModel& card) { return card.id == cardId; });
+    gameModel->reset();
     
-    if (it != gameModel->handCards.end()) {
-        // 将被点击的卡牌移动到顶部位置（向量末尾）
-        CardModel clickedCard = *it;
-        gameModel->handCards.erase(it);
-        gameModel->handCards.push_back(clickedCard);
-        return true;
+    // 规则集无效时按经典规则加载，并报告失败
+    bool allAdded = RuleRegistry::isValid(level.ruleSet);
+    if (allAdded) {
+        gameModel->state.ruleSet = static_cast<uint8_t>(level.ruleSet);
     }
     
-    return false;
+    // 从堆叠配置创建手牌，最后一张为顶部手牌
+    for (const auto& cardConfig : level.stack) {
+        allAdded &= gameModel->addHandCard(static_cast<CardFaceType>(cardConfig.cardFace),
+                                           static_cast<CardSuitType>(cardConfig.cardSuit)) >= 0;
+    }
+    
+    // 从牌桌配置创建牌桌卡牌
+    for (const auto& cardConfig : level.playfield) {
+        allAdded &= gameModel->addPlayfieldCard(static_cast<CardFaceType>(cardConfig.cardFace),
+                                                static_cast<CardSuitType>(cardConfig.cardSuit),
+                                                cardConfig.position) >= 0;
+    }
+    
+    return allAdded;
 }
 
-// 执行桌面卡牌匹配逻辑
-bool GameService::executePlayfieldCardMatch(GameModel* gameModel, int cardId) {
-    if (!gameModel) {
+// 从关卡包加载关卡
+bool GameService::loadLevel(GameModel* gameModel, const LevelPack& pack, int index) {
+    if (!gameModel || index < 0 || index >= pack.getLevelCount()) {
         return false;
     }
     
-    // 获取桌面卡牌
-    CardModel* playfieldCard = gameModel->findPlayfieldCardById(cardId);
-    CardModel* topHandCard = gameModel->getTopHandCard();
+    gameModel->reset();
+    
+    // 规则集已在打开关卡包时校验
+    const LevelPackEntry& entry = pack.getEntry(index);
+    const LevelPackCard* cards = pack.getCards(index);
+    bool allAdded = true;
+    gameModel->state.ruleSet = entry.ruleSet;
+    
+    // 记录顺序与关卡配置一致：先手牌堆叠，再牌桌卡牌
+    for (int i = 0; i < entry.stackCount; ++i) {
+        allAdded &= gameModel->addHandCard(static_cast<CardFaceType>(cards[i].face),
+                                           static_cast<CardSuitType>(cards[i].suit)) >= 0;
+    }
+    cards += entry.stackCount;
+    for (int i = 0; i < entry.playfieldCount; ++i) {
+        allAdded &= gameModel->addPlayfieldCard(static_cast<CardFaceType>(cards[i].face),
+                                                static_cast<CardSuitType>(cards[i].suit),
+                                                pack.decodePosition(cards[i])) >= 0;
+    }
     
-    if (!playfieldCard || !topHandCard) {
+    return allAdded;
+}
+
+// 执行手牌替换逻辑
+bool GameService::executeHandCardReplacement(GameModel* gameModel, int cardId, MoveRecord* record) {
+    return gameModel && executeHandCardReplacement(gameModel->state, cardId, record);
+}
+
+// 执行手牌替换逻辑（核心状态）
+bool GameService::executeHandCardReplacement(PackedGameState& state, int cardId, MoveRecord* record) {
+    if (!state.hasTopHandCard()) {
         return false;
     }
     
-    // 验证匹配规则
-    if (!CardMatchService::canMatch(*playfieldCard, *topHandCard)) {
+    // 查找被点击的卡牌
+    int index = state.findHandIndex(cardId);
+    if (index < 0) {
         return false;
     }
     
-    // 执行匹配：用桌面卡牌替换顶部手牌
-    if (!gameModel->handCards.empty()) {
-        gameModel->handCards.back() = *playfieldCard;
+    if (record) {
+        record->type = MT_HAND_REPLACE;
+        record->cardId = static_cast<uint8_t>(cardId);
+        record->sourceIndex = static_cast<uint8_t>(index);
+        record->previousTopId = static_cast<uint8_t>(state.topHandId());
+        record->previousTopCard = state.topHandCard();
+        record->scoreDelta = 0;
+    }
+    
+    // 将被点击的卡牌移动到顶部位置（数组末尾）
+    state.moveHandCardToTop(index);
+    return true;
+}
+
+// 执行桌面卡牌匹配逻辑
+bool GameService::executePlayfieldCardMatch(GameModel* gameModel, int cardId, MoveRecord* record) {
+    return gameModel && executePlayfieldCardMatch(gameModel->state, cardId, record);
+}
+
+// 执行桌面卡牌匹配逻辑（核心状态）
+bool GameService::executePlayfieldCardMatch(PackedGameState& state, int cardId, MoveRecord* record) {
+    return RuleRegistry::dispatch<PlayfieldMatchOp>(state.ruleSet, state, cardId, record);
+}
+
+// 撤销一步操作
+void GameService::revertMove(GameModel* gameModel, const MoveRecord& record) {
+    if (!gameModel || !gameModel->state.hasTopHandCard()) {
+        return;
     }
     
-    // 移除桌面卡牌
-    gameModel->removePlayfieldCard(cardId);
+    PackedGameState& state = gameModel->state;
     
-    // 增加分数
-    gameModel->score += calculateScore(*playfieldCard);
+    if (record.type == MT_HAND_REPLACE) {
+        // 将顶部手牌移回原来的位置
+        state.moveTopHandCardTo(record.sourceIndex);
+    } else if (record.type == MT_PLAYFIELD_MATCH) {
+        // 当前顶部手牌就是被匹配的牌桌卡牌，放回牌桌
+        state.pushPlayfieldCard(state.topHandCard(), state.topHandId());
+        
+        // 恢复被替换的顶部手牌和分数
+        state.setTopHandCard(record.previousTopCard, record.previousTopId);
+        state.score -= record.scoreDelta;
+    }
     
+    gameModel->isGameOver = false;
+    gameModel->isGameWon = false;
+}
+
+// 重做一步操作
+bool GameService::replayMove(GameModel* gameModel, const MoveRecord& record) {
+    if (record.type == MT_HAND_REPLACE) {
+        return executeHandCardReplacement(gameModel, record.cardId);
+    }
+    if (record.type == MT_PLAYFIELD_MATCH) {
+        return executePlayfieldCardMatch(gameModel, record.cardId);
+    }
+    return false;
+}
+
+// 计算提示
+bool GameService::computeHint(const GameModel* gameModel, HintCache& cache, HintMove& hint,
+                              const HintOptions& options) {
+    hint = HintMove();
+    if (!gameModel || gameModel->isGameOver) {
+        return false;
+    }
+    
+    return computeHint(gameModel->state, cache, hint, options);
+}
+
+// 计算提示（核心状态）
+bool GameService::computeHint(const PackedGameState& state, HintCache& cache, HintMove& hint,
+                              const HintOptions& options) {
+    hint = HintMove();
+    std::lock_guard<std::mutex> lock(cache.getMutex());
+    if (!RuleRegistry::dispatch<ComputeHintOp>(state.ruleSet, state, cache, hint, options)) {
+        hint = HintMove();
+        return false;
+    }
     return true;
 }
 
@@ -64,32 +324,64 @@ int GameService::checkGameEndCondition(const GameModel* gameModel) {
         return 0; // 继续游戏
     }
     
-    // 检查胜利条件：所有桌面卡牌都被清除
-    if (gameModel->playfieldCards.empty()) {
-        return 1; // 胜利
+    // 胜利：所有桌面卡牌都被清除；失败：无法再匹配且没有其他手牌可切换，由关卡规则判断
+    return RuleRegistry::dispatch<GameEndOp>(gameModel->state.ruleSet, gameModel->state);
+}
+
+// 更新游戏结束标志
+int GameService::updateGameEndState(GameModel* gameModel) {
+    int status = checkGameEndCondition(gameModel);
+    if (gameModel && status != 0) {
+        gameModel->isGameOver = true;
+        gameModel->isGameWon = (status == 1);
     }
-    
-    // 检查失败条件：无法进行任何匹配
-    if (gameModel->handCards.empty()) {
-        return -1; // 失败
+    return status;
+}
+
+// 应用玩家输入
+bool GameService::applyInput(GameModel* gameModel, UndoManager* undoManager, InputOp op, int cardId,
+                             MoveRecord* record) {
+    if (!gameModel) {
+        return false;
     }
     
-    const CardModel* topHandCard = &gameModel->handCards.back();
-    if (!topHandCard) {
-        return -1; // 失败
+    // 撤销在游戏结束后仍然可用，其余输入在游戏结束后一律忽略
+    if (op == IO_UNDO) {
+        return undoManager && undoManager->undo();
     }
-    
-    // 检查是否还有可匹配的桌面卡牌
-    if (CardMatchService::hasAnyPossibleMatch(gameModel->handCards, gameModel->playfieldCards)) {
-        return 0; // 还可以继续游戏
+    if (gameModel->isGameOver) {
+        return false;
     }
     
-    // 如果没有可匹配的卡牌，检查手牌是否还有其他选择
-    if (gameModel->handCards.size() > 1) {
-        return 0; // 还可以切换手牌
+    MoveRecord localRecord;
+    MoveRecord& move = record ? *record : localRecord;
+    bool applied = false;
+    switch (op) {
+        case IO_HAND_CLICK:
+            applied = executeHandCardReplacement(gameModel, cardId, &move);
+            break;
+        case IO_PLAYFIELD_CLICK:
+            applied = executePlayfieldCardMatch(gameModel, cardId, &move);
+            break;
+        case IO_REDO:
+            // 重做由撤销管理器自行取回记录，再经move输出给调用方
+            if (!undoManager || !undoManager->redo(&move)) {
+                return false;
+            }
+            updateGameEndState(gameModel);
+            return true;
+        default:
+            return false;
     }
     
-    return -1; // 失败
+    if (!applied) {
+        return false;
+    }
+    if (undoManager) {
+        undoManager->recordMove(move);
+    }
+    updateGameEndState(gameModel);
+    return true;
 }
 
 // 验证卡牌匹配规则
@@ -102,4 +394,9 @@ bool GameService::validateCardMatch(const CardModel& card1, const CardModel& car
 int GameService::calculateScore(const CardModel& matchedCard) {
     // 使用ScoreService计算得分
     return ScoreService::calculateMatchScore(matchedCard);
+}
+
+// 计算得分（打包卡牌）
+int GameService::calculateScore(PackedCard matchedCard) {
+    return ScoreService::calculateMatchScore(matchedCard);
 }
\ No newline at end of file
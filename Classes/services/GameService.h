@@ -3,9 +3,17 @@
 
 #include "../models/CardModel.h"
 #include "../models/GameModel.h"
+#include "../models/MoveRecord.h"
+#include "../models/HintMove.h"
+#include "../models/InputEvent.h"
+#include "../configs/LevelData.h"
+#include "../configs/LevelPack.h"
 #include <vector>
 #include <functional>
 
+class HintCache;
+class UndoManager;
+
 /**
  * 游戏服务层 - 处理游戏业务逻辑
  * 特点：
@@ -13,24 +21,107 @@
  * - 处理业务逻辑，不管理数据生命周期
  * - 可以加工数据但不持有数据
  * - 提供静态方法
+ * - 匹配、计分、结束判断和提示按核心状态的规则集分派到预先编译的规则实例（见RuleRegistry）
  */
 class GameService {
 public:
+    /**
+     * 按关卡配置重建游戏数据，规则集随关卡设置
+     * @param gameModel 游戏数据模型，会先被重置
+     * @param level 关卡配置
+     * @return 所有卡牌都加入成功返回true，超出容量、卡牌无效或规则集无效（此时按经典规则加载）返回false
+     */
+    static bool loadLevel(GameModel* gameModel, const LevelConfig& level);
+    
+    /**
+     * 按关卡包中的关卡重建游戏数据，直接读取映射的卡牌记录，不经过关卡配置
+     * @param gameModel 游戏数据模型，会先被重置
+     * @param pack 已打开的关卡包
+     * @param index 关卡下标
+     * @return 下标有效且所有卡牌都加入成功返回true
+     */
+    static bool loadLevel(GameModel* gameModel, const LevelPack& pack, int index);
+    
     /**
      * 执行手牌替换逻辑
      * @param gameModel 游戏数据模型
      * @param cardId 被点击的卡牌ID
+     * @param record 执行成功时输出本步操作的增量记录，可为空
+     * @return 是否成功执行替换
+     */
+    static bool executeHandCardReplacement(GameModel* gameModel, int cardId, MoveRecord* record = nullptr);
+    
+    /**
+     * 执行手牌替换逻辑（直接作用于核心状态）
+     * 供模拟对局等只复制PackedGameState的场合使用
+     * @param state 核心游戏状态
+     * @param cardId 被点击的卡牌ID
+     * @param record 执行成功时输出本步操作的增量记录，可为空
      * @return 是否成功执行替换
      */
-    static bool executeHandCardReplacement(GameModel* gameModel, int cardId);
+    static bool executeHandCardReplacement(PackedGameState& state, int cardId, MoveRecord* record = nullptr);
     
     /**
      * 执行桌面卡牌匹配逻辑
      * @param gameModel 游戏数据模型
      * @param cardId 被点击的桌面卡牌ID
+     * @param record 执行成功时输出本步操作的增量记录，可为空
      * @return 是否成功执行匹配
      */
-    static bool executePlayfieldCardMatch(GameModel* gameModel, int cardId);
+    static bool executePlayfieldCardMatch(GameModel* gameModel, int cardId, MoveRecord* record = nullptr);
+    
+    /**
+     * 执行桌面卡牌匹配逻辑（直接作用于核心状态），按核心状态的规则集判断匹配和计分
+     * @param state 核心游戏状态
+     * @param cardId 被点击的桌面卡牌ID
+     * @param record 执行成功时输出本步操作的增量记录，可为空
+     * @return 是否成功执行匹配
+     */
+    static bool executePlayfieldCardMatch(PackedGameState& state, int cardId, MoveRecord* record = nullptr);
+    
+    /**
+     * 撤销一步操作
+     * @param gameModel 游戏数据模型
+     * @param record 要撤销的操作记录，必须是最近一次在该模型上执行的操作
+     */
+    static void revertMove(GameModel* gameModel, const MoveRecord& record);
+    
+    /**
+     * 重做一步已撤销的操作
+     * @param gameModel 游戏数据模型
+     * @param record 要重做的操作记录
+     * @return 是否成功重做
+     */
+    static bool replayMove(GameModel* gameModel, const MoveRecord& record);
+    
+    /**
+     * 计算提示：前瞻若干步，给出最佳的下一步操作
+     * 
+     * 以牌面级状态做有界深度优先搜索，每次匹配得2分、每次切换手牌扣1分，
+     * 前瞻内清空牌桌得高分、走入死局扣分，即偏好不切换手牌就能连续匹配最长的路线
+     * 从1步起逐层加深，超出时间预算时返回已完成的最深一层的结果
+     * 每个被完整评估的状态都写入缓存，走一步或撤销后再次求提示大多直接命中
+     * 
+     * @param gameModel 游戏数据模型
+     * @param cache 前瞻结果缓存，计算期间持有其互斥锁
+     * @param hint 输出的提示
+     * @param options 搜索参数
+     * @return 存在可行操作返回true
+     */
+    static bool computeHint(const GameModel* gameModel, HintCache& cache, HintMove& hint,
+                            const HintOptions& options = HintOptions());
+    
+    /**
+     * 计算提示（直接作用于核心状态）
+     * 供后台线程只复制PackedGameState的场合使用，调用方须确认对局尚未结束
+     * @param state 核心游戏状态
+     * @param cache 前瞻结果缓存，计算期间持有其互斥锁
+     * @param hint 输出的提示
+     * @param options 搜索参数
+     * @return 存在可行操作返回true
+     */
+    static bool computeHint(const PackedGameState& state, HintCache& cache, HintMove& hint,
+                            const HintOptions& options = HintOptions());
     
     /**
      * 检查游戏是否结束
@@ -39,6 +130,29 @@ public:
      */
     static int checkGameEndCondition(const GameModel* gameModel);
     
+    /**
+     * 按检查结果更新模型的游戏结束标志
+     * @param gameModel 游戏数据模型
+     * @return 与checkGameEndCondition相同的结束状态
+     */
+    static int updateGameEndState(GameModel* gameModel);
+    
+    /**
+     * 应用一次玩家输入
+     * 
+     * 这是玩家点击与规则之间的唯一入口：控制器和无界面的输入回放都经由此处，
+     * 游戏结束后的点击和重做被忽略，成功的操作写入撤销管理器，并随后更新游戏结束标志
+     * 
+     * @param gameModel 游戏数据模型
+     * @param undoManager 撤销管理器，可为空（此时撤销和重做总是失败）
+     * @param op 输入类型
+     * @param cardId 被点击的卡牌ID，撤销和重做时忽略
+     * @param record 点击或重做成功时输出本步操作的增量记录，可为空
+     * @return 输入改变了游戏状态返回true，被规则拒绝返回false
+     */
+    static bool applyInput(GameModel* gameModel, UndoManager* undoManager, InputOp op, int cardId,
+                           MoveRecord* record = nullptr);
+    
     /**
      * 验证卡牌匹配规则
      * @param card1 第一张卡牌
@@ -54,6 +168,13 @@ public:
      */
     static int calculateScore(const CardModel& matchedCard);
     
+    /**
+     * 计算得分
+     * @param matchedCard 匹配的打包卡牌
+     * @return 获得的分数
+     */
+    static int calculateScore(PackedCard matchedCard);
+    
 private:
     // 私有构造函数，防止实例化
     GameService() = delete;
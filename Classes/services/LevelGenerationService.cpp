@@ -0,0 +1,84 @@
+﻿#include "LevelGenerationService.h"
+#include "../configs/CardTypes.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief 取[0, bound)中的随机整数，直接取模使不同标准库下的结果一致
+ */
+int pickIndex(LevelGenerationService::Random& random, int bound) {
+    return static_cast<int>(random() % static_cast<uint32_t>(bound));
+}
+
+/**
+ * @brief 以[0, 1)的概率判定
+ */
+bool chance(LevelGenerationService::Random& random, float probability) {
+    return (random() >> 8) * (1.0f / 16777216.0f) < probability;
+}
+
+/**
+ * @brief 随机取一个与指定牌面相差1的牌面
+ */
+int adjacentFace(LevelGenerationService::Random& random, int face) {
+    if (face == CFT_ACE) {
+        return CFT_TWO;
+    }
+    if (face == CFT_KING) {
+        return CFT_QUEEN;
+    }
+    return (random() & 1) ? face + 1 : face - 1;
+}
+
+} // namespace
+
+void LevelGenerationService::generateLevel(const LevelConfig& layout, const LevelGenerationParams& params,
+                                           Random& random, LevelConfig& level) {
+    int stackCount = params.stackCount > 0 ? params.stackCount : static_cast<int>(layout.stack.size());
+    if (stackCount <= 0) {
+        stackCount = 1;
+    }
+    int playfieldCount = static_cast<int>(layout.playfield.size());
+    
+    level.stack.resize(stackCount);
+    level.playfield.resize(playfieldCount);
+    
+    // 随机手牌，最后一张为初始顶部手牌
+    for (int i = 0; i < stackCount; ++i) {
+        CardConfig& card = level.stack[i];
+        card.cardFace = pickIndex(random, CFT_NUM_CARD_FACE_TYPES);
+        card.cardSuit = pickIndex(random, CST_NUM_CARD_SUIT_TYPES);
+        if (!layout.stack.empty()) {
+            card.position = layout.stack[std::min(i, static_cast<int>(layout.stack.size()) - 1)].position;
+        } else {
+            card.position = GameVec2();
+        }
+    }
+    
+    // 按解法依次放出牌桌卡牌；unused中是尚未用过的非顶部手牌牌面
+    std::vector<int> unused;
+    unused.reserve(stackCount);
+    for (int i = 0; i < stackCount - 1; ++i) {
+        unused.push_back(level.stack[i].cardFace);
+    }
+    int top = level.stack[stackCount - 1].cardFace;
+    for (int i = 0; i < playfieldCount; ++i) {
+        if (!unused.empty() && chance(random, params.switchChance)) {
+            // 切换手牌：原顶部手牌留在手牌中，可以之后再切换回来
+            std::swap(top, unused[pickIndex(random, static_cast<int>(unused.size()))]);
+        }
+        top = adjacentFace(random, top);
+        level.playfield[i].cardFace = top;
+        level.playfield[i].cardSuit = pickIndex(random, CST_NUM_CARD_SUIT_TYPES);
+    }
+    
+    // 打乱叠放顺序，位置按模板顺序分配
+    for (int i = playfieldCount - 1; i > 0; --i) {
+        std::swap(level.playfield[i], level.playfield[pickIndex(random, i + 1)]);
+    }
+    for (int i = 0; i < playfieldCount; ++i) {
+        level.playfield[i].position = layout.playfield[i].position;
+    }
+}
@@ -0,0 +1,54 @@
+﻿#ifndef __LEVEL_GENERATION_SERVICE_H__
+#define __LEVEL_GENERATION_SERVICE_H__
+
+#include "../configs/LevelData.h"
+#include <random>
+
+/**
+ * @struct LevelGenerationParams
+ * @brief 关卡生成参数
+ */
+struct LevelGenerationParams {
+    int stackCount;         ///< 手牌数量，不大于0时沿用布局模板中的数量
+    float switchChance;     ///< 解法中每一步先切换手牌的概率，越大越需要使用手牌
+
+    LevelGenerationParams() : stackCount(0), switchChance(0.25f) {}
+};
+
+/**
+ * 关卡生成服务 - 批量生成保证可解的关卡
+ * 特点：
+ * - 无状态服务，随机数引擎由调用方持有
+ * - 先随机走出一条解法，再按解法倒推出牌桌卡牌，因此生成的关卡一定可解，无需求解器过滤
+ * - 位置取自布局模板，任何现有关卡都可以作为模板
+ */
+class LevelGenerationService {
+public:
+    /**
+     * 随机数引擎，与PlayoutService相同
+     */
+    typedef std::mt19937 Random;
+
+    /**
+     * 生成一个关卡
+     *
+     * 牌桌卡牌数量和位置与模板的牌桌相同；手牌位置沿用模板中的手牌位置，不够时取最后一个
+     * 解法：从初始顶部手牌出发，每步以switchChance的概率切换到另一张手牌，
+     * 再放一张与顶部牌面相差1的牌桌卡牌并让它成为顶部手牌；最后打乱牌桌卡牌的叠放顺序
+     *
+     * @param layout 布局模板，只使用其中的位置
+     * @param params 生成参数
+     * @param random 随机数引擎
+     * @param level 输出的关卡配置，会先被清空
+     */
+    static void generateLevel(const LevelConfig& layout, const LevelGenerationParams& params,
+                              Random& random, LevelConfig& level);
+
+private:
+    LevelGenerationService() = delete;
+    ~LevelGenerationService() = delete;
+    LevelGenerationService(const LevelGenerationService&) = delete;
+    LevelGenerationService& operator=(const LevelGenerationService&) = delete;
+};
+
+#endif // __LEVEL_GENERATION_SERVICE_H__
@@ -0,0 +1,160 @@
+﻿#include "PlayoutService.h"
+#include "GameService.h"
+#include "RuleEngine.h"
+#include "RuleRegistry.h"
+
+namespace {
+
+/**
+ * @brief 取[0, bound)中的随机整数
+ *
+ * 直接取模而不用std::uniform_int_distribution，使不同标准库下的结果一致
+ */
+int pickIndex(PlayoutService::Random& random, int bound) {
+    return static_cast<int>(random() % static_cast<uint32_t>(bound));
+}
+
+/**
+ * @brief 在能与指定卡牌匹配的牌桌卡牌中随机选一张
+ *
+ * 只看牌面的规则按牌面计数直接定位，不逐张列出卡牌
+ */
+template <typename Rules>
+int pickPlayfieldCard(const PackedGameState& state, PackedCard card, PlayoutService::Random& random) {
+    typedef typename Rules::MatchRule Match;
+    if (Match::SAME_SUIT) {
+        uint8_t ids[PackedGameState::MAX_PLAYFIELD_CARDS];
+        int count = RuleEngine<Rules>::collectMatchableCards(state, card, ids);
+        return ids[pickIndex(random, count)];
+    }
+    
+    const FaceMatchIndex& index = state.faceIndex;
+    uint16_t targets = Match::matchingFaces(card.face()) & index.playfieldMask;
+    int total = 0;
+    for (int f = 0; f < CFT_NUM_CARD_FACE_TYPES; ++f) {
+        if (targets & (1 << f)) {
+            total += index.playfieldCounts[f];
+        }
+    }
+    
+    int pick = pickIndex(random, total);
+    for (int f = 0; f < CFT_NUM_CARD_FACE_TYPES; ++f) {
+        if (!(targets & (1 << f))) {
+            continue;
+        }
+        if (pick >= index.playfieldCounts[f]) {
+            pick -= index.playfieldCounts[f];
+            continue;
+        }
+        uint8_t id = index.bucketHead[f];
+        while (pick-- > 0) {
+            id = index.bucketNext[id];
+        }
+        return id;
+    }
+    return -1;
+}
+
+/**
+ * @brief 以指定规则执行一局模拟
+ *
+ * 整局都使用同一个规则实例，循环中不再按规则集分派
+ */
+template <typename Rules>
+PlayoutResult runPlayoutWithRules(const PackedGameState& initial, PlayoutPolicy policy, PlayoutService::Random& random) {
+    typedef RuleEngine<Rules> Engine;
+    PackedGameState state = initial;
+    PlayoutResult result;
+    result.moves = 0;
+    
+    uint8_t candidates[PackedGameState::MAX_HAND_CARDS];
+    while (!state.playfield.empty() && state.hasTopHandCard()) {
+        // 选出要使用的手牌
+        int handIndex = state.handCount - 1;
+        if (policy == PP_RANDOM || !Engine::playfieldCanMatch(state, state.topHandCard())) {
+            int candidateCount = 0;
+            for (int i = 0; i < state.handCount; ++i) {
+                if (Engine::playfieldCanMatch(state, state.handCards[i])) {
+                    candidates[candidateCount++] = static_cast<uint8_t>(i);
+                }
+            }
+            if (candidateCount == 0) {
+                break;
+            }
+            handIndex = candidates[pickIndex(random, candidateCount)];
+        }
+        
+        // 需要时先切换顶部手牌
+        if (handIndex != state.handCount - 1) {
+            GameService::executeHandCardReplacement(state, state.handIds[handIndex]);
+            result.moves++;
+        }
+        
+        int cardId = pickPlayfieldCard<Rules>(state, state.topHandCard(), random);
+        if (!Engine::executePlayfieldCardMatch(state, cardId, nullptr)) {
+            break;
+        }
+        result.moves++;
+    }
+    
+    result.won = state.playfield.empty();
+    result.cardsLeft = state.playfieldCount();
+    return result;
+}
+
+/**
+ * @brief 以指定规则执行一局模拟
+ */
+template <typename Rules>
+struct PlayoutOp {
+    static PlayoutResult run(const PackedGameState& initial, PlayoutPolicy policy, PlayoutService::Random& random) {
+        return runPlayoutWithRules<Rules>(initial, policy, random);
+    }
+};
+
+/**
+ * @brief 以指定规则执行多局模拟
+ */
+template <typename Rules>
+struct PlayoutsOp {
+    static void run(const PackedGameState& initial, PlayoutPolicy policy, int playouts, uint32_t seed,
+                    PlayoutStats& stats) {
+        PlayoutService::Random random(seed);
+        for (int i = 0; i < playouts; ++i) {
+            stats.add(runPlayoutWithRules<Rules>(initial, policy, random));
+        }
+    }
+};
+
+} // namespace
+
+void PlayoutStats::add(const PlayoutResult& result) {
+    playouts++;
+    totalMoves += result.moves;
+    if (result.won) {
+        wins++;
+        winMoves += result.moves;
+    } else {
+        deadEndMoves += result.moves;
+        deadEndCardsLeft += result.cardsLeft;
+    }
+}
+
+void PlayoutStats::merge(const PlayoutStats& other) {
+    playouts += other.playouts;
+    wins += other.wins;
+    totalMoves += other.totalMoves;
+    winMoves += other.winMoves;
+    deadEndMoves += other.deadEndMoves;
+    deadEndCardsLeft += other.deadEndCardsLeft;
+}
+
+PlayoutResult PlayoutService::runPlayout(const PackedGameState& initial, PlayoutPolicy policy, Random& random) {
+    return RuleRegistry::dispatch<PlayoutOp>(initial.ruleSet, initial, policy, random);
+}
+
+void PlayoutService::runPlayouts(const PackedGameState& initial, PlayoutPolicy policy,
+                                 int playouts, uint32_t seed, PlayoutStats& stats) {
+    // 在循环外分派一次
+    RuleRegistry::dispatch<PlayoutsOp>(initial.ruleSet, initial, policy, playouts, seed, stats);
+}
@@ -0,0 +1,95 @@
+﻿#ifndef __PLAYOUT_SERVICE_H__
+#define __PLAYOUT_SERVICE_H__
+
+#include "../models/PackedGameState.h"
+#include <cstdint>
+#include <random>
+
+/**
+ * @enum PlayoutPolicy
+ * @brief 模拟对局的出牌策略
+ */
+enum PlayoutPolicy {
+    PP_RANDOM,      ///< 在所有能匹配的手牌中随机选一张（需要时先切换），再随机匹配一张牌桌卡牌
+    PP_GREEDY       ///< 顶部手牌能匹配时不切换手牌，否则随机切换到一张能匹配的手牌
+};
+
+/**
+ * @struct PlayoutResult
+ * @brief 单局模拟的结果
+ */
+struct PlayoutResult {
+    bool won;               ///< 是否清空牌桌
+    int moves;              ///< 执行的操作数（切换手牌和匹配各算一步）
+    int cardsLeft;          ///< 结束时剩余的牌桌卡牌数
+};
+
+/**
+ * @struct PlayoutStats
+ * @brief 多局模拟的汇总
+ *
+ * 各字段都是可直接相加的总和，多个线程的结果用merge合并
+ */
+struct PlayoutStats {
+    uint64_t playouts;          ///< 模拟局数
+    uint64_t wins;              ///< 胜利局数
+    uint64_t totalMoves;        ///< 所有局的操作数之和
+    uint64_t winMoves;          ///< 胜利局的操作数之和
+    uint64_t deadEndMoves;      ///< 失败局走入死局前的操作数之和
+    uint64_t deadEndCardsLeft;  ///< 失败局剩余牌桌卡牌数之和
+
+    PlayoutStats() : playouts(0), wins(0), totalMoves(0), winMoves(0), deadEndMoves(0), deadEndCardsLeft(0) {}
+
+    /**
+     * @brief 计入一局结果
+     */
+    void add(const PlayoutResult& result);
+
+    /**
+     * @brief 合并另一组汇总
+     */
+    void merge(const PlayoutStats& other);
+};
+
+/**
+ * 模拟对局服务 - 在核心状态上快速随机对局，用于估计关卡难度
+ * 特点：
+ * - 无状态服务，随机数引擎由调用方持有
+ * - 只复制PackedGameState，按状态的规则集分派一次后以该规则的实例执行整局，与游戏规则一致
+ * - 给定种子时结果可复现
+ */
+class PlayoutService {
+public:
+    /**
+     * 随机数引擎，与cocos2d的RandomHelper相同，便于用同一个种子复现
+     */
+    typedef std::mt19937 Random;
+
+    /**
+     * 执行一局模拟
+     * @param initial 初始状态，不会被修改
+     * @param policy 出牌策略
+     * @param random 随机数引擎
+     * @return 模拟结果
+     */
+    static PlayoutResult runPlayout(const PackedGameState& initial, PlayoutPolicy policy, Random& random);
+
+    /**
+     * 执行多局模拟并汇总
+     * @param initial 初始状态，不会被修改
+     * @param policy 出牌策略
+     * @param playouts 模拟局数
+     * @param seed 随机种子，相同种子得到相同结果
+     * @param stats 累加输出的汇总
+     */
+    static void runPlayouts(const PackedGameState& initial, PlayoutPolicy policy,
+                            int playouts, uint32_t seed, PlayoutStats& stats);
+
+private:
+    PlayoutService() = delete;
+    ~PlayoutService() = delete;
+    PlayoutService(const PlayoutService&) = delete;
+    PlayoutService& operator=(const PlayoutService&) = delete;
+};
+
+#endif // __PLAYOUT_SERVICE_H__
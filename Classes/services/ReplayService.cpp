@@ -0,0 +1,111 @@
+﻿#include "ReplayService.h"
+#include "GameService.h"
+#include <chrono>
+#include <thread>
+
+// 录制中没有帧率时按此帧率实时回放
+static const int DEFAULT_REPLAY_FPS = 60;
+
+// 回放录制的输入
+ReplayVerdict ReplayService::replay(GameModel* gameModel, const InputRecording& recording, ReplaySpeed speed,
+                                    ReplayResult& result) {
+    UndoManager undoManager;
+    ScoringEngine scoring;
+    return replay(gameModel, recording, speed, undoManager, scoring, result);
+}
+
+// 使用调用方的撤销管理器和计分引擎回放
+ReplayVerdict ReplayService::replay(GameModel* gameModel, const InputRecording& recording, ReplaySpeed speed,
+                                    UndoManager& undoManager, ScoringEngine& scoring, ReplayResult& result) {
+    result = ReplayResult();
+    if (!matchesInitialState(gameModel, recording)) {
+        result.verdict = RV_LEVEL_MISMATCH;
+        return result.verdict;
+    }
+    
+    undoManager.init(gameModel);
+    undoManager.clear();
+    undoManager.setMaxUndoSteps(recording.header.maxUndoSteps);
+    prepareScoring(gameModel, recording, scoring);
+    MoveRecord record;
+    
+    int fps = recording.header.framesPerSecond > 0 ? recording.header.framesPerSecond : DEFAULT_REPLAY_FPS;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < recording.events.size(); ++i) {
+        const InputEvent& event = recording.events[i];
+        if (speed == RS_REAL_TIME) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds(
+                static_cast<int64_t>(event.frame) * 1000000 / fps));
+        }
+        
+        InputOp op = static_cast<InputOp>(event.op);
+        bool applied = GameService::applyInput(gameModel, &undoManager, op, event.cardId, &record);
+        scoring.onInput(op, applied, record, *gameModel, event.frame);
+        if (applied) {
+            result.appliedInputs++;
+        } else {
+            result.rejectedInputs++;
+        }
+    }
+    
+    return verifyFinalState(gameModel, scoring, recording, result);
+}
+
+// 检查初始状态
+bool ReplayService::matchesInitialState(const GameModel* gameModel, const InputRecording& recording) {
+    return gameModel && gameModel->computeStateHash() == recording.header.initialStateHash;
+}
+
+// 按录制设置计分引擎
+void ReplayService::prepareScoring(const GameModel* gameModel, const InputRecording& recording,
+                                   ScoringEngine& scoring) {
+    scoring.setMaxUndoSteps(recording.header.maxUndoSteps);
+    scoring.setClock(recording.header.framesPerSecond, 0);
+    scoring.reset(*gameModel);
+}
+
+// 校验最终状态
+ReplayVerdict ReplayService::verifyFinalState(const GameModel* gameModel, const ScoringEngine& scoring,
+                                              const InputRecording& recording, ReplayResult& result) {
+    result.finalStateHash = gameModel->computeStateHash();
+    result.score = scoring.getBreakdown();
+    
+    // 旧版录制只记下了匹配得分
+    if (recording.header.version >= InputRecording::SCORED_VERSION) {
+        result.finalScore = scoring.getTotalScore();
+    } else {
+        result.finalScore = gameModel->getScore();
+    }
+    
+    if (!recording.hasResult) {
+        result.verdict = RV_UNVERIFIED;
+    } else if (result.finalScore != recording.finalScore) {
+        result.verdict = RV_SCORE_MISMATCH;
+    } else if (result.finalStateHash != recording.finalStateHash) {
+        result.verdict = RV_HASH_MISMATCH;
+    } else {
+        result.verdict = RV_VERIFIED;
+    }
+    return result.verdict;
+}
+
+// 获取结论名称
+const char* ReplayService::getVerdictName(ReplayVerdict verdict) {
+    switch (verdict) {
+        case RV_VERIFIED:
+            return "verified";
+        case RV_UNVERIFIED:
+            return "unverified";
+        case RV_LEVEL_MISMATCH:
+            return "level_mismatch";
+        case RV_SCORE_MISMATCH:
+            return "score_mismatch";
+        case RV_HASH_MISMATCH:
+            return "hash_mismatch";
+        case RV_MALFORMED:
+            return "malformed";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,127 @@
+﻿#ifndef __REPLAY_SERVICE_H__
+#define __REPLAY_SERVICE_H__
+
+#include "../models/GameModel.h"
+#include "../managers/InputRecording.h"
+#include "../managers/ScoringEngine.h"
+#include "../managers/UndoManager.h"
+#include <cstdint>
+
+/**
+ * @enum ReplaySpeed
+ * @brief 输入回放的速度
+ */
+enum ReplaySpeed {
+    RS_MAX_SPEED,       ///< 不等待，依次应用全部输入
+    RS_REAL_TIME        ///< 按录制时的帧序号和帧率等待到对应时刻再应用
+};
+
+/**
+ * @enum ReplayVerdict
+ * @brief 输入回放的结论
+ */
+enum ReplayVerdict {
+    RV_VERIFIED,        ///< 最终状态哈希和得分都与录制一致
+    RV_UNVERIFIED,      ///< 录制没有结果，已回放但无法校验
+    RV_LEVEL_MISMATCH,  ///< 初始状态与录制不符，未回放
+    RV_SCORE_MISMATCH,  ///< 最终得分与录制不符
+    RV_HASH_MISMATCH,   ///< 得分一致但最终状态哈希与录制不符
+    RV_MALFORMED,       ///< 录制数据无法解析，由解析录制的调用方给出
+    RV_NUM_VERDICTS     ///< 结论数量
+};
+
+/**
+ * @struct ReplayResult
+ * @brief 一次输入回放的结果
+ */
+struct ReplayResult {
+    ReplayVerdict verdict;      ///< 结论
+    uint32_t appliedInputs;     ///< 改变了状态的输入数
+    uint32_t rejectedInputs;    ///< 被规则拒绝的输入数
+    uint64_t finalStateHash;    ///< 回放后的状态哈希
+    int32_t finalScore;         ///< 回放后与录制比较的得分，版本1的录制为匹配得分，此后为总分
+    ScoreBreakdown score;       ///< 回放后重新计算的分项得分
+
+    ReplayResult()
+        : verdict(RV_UNVERIFIED), appliedInputs(0), rejectedInputs(0), finalStateHash(0), finalScore(0) {}
+};
+
+/**
+ * 输入回放服务 - 不依赖界面重放录制的玩家输入并校验结果
+ * 特点：
+ * - 无状态服务，每次回放使用自己的或调用方复用的撤销管理器和计分引擎，最大撤销步数取自录制
+ * - 每条输入都经由GameService::applyInput，与对局中的控制器走同一条规则路径
+ * - 每条输入的结果连同帧序号交给计分引擎重新计分，奖励与客户端逐位相同
+ * - 结果以状态哈希和得分逐位比较
+ */
+class ReplayService {
+public:
+    /**
+     * 回放录制的输入
+     * @param gameModel 已加载好录制所用关卡的游戏数据模型，回放后为最终状态
+     * @param recording 输入录制
+     * @param speed 回放速度
+     * @param result 输出的回放结果
+     * @return 结论，与result.verdict相同
+     */
+    static ReplayVerdict replay(GameModel* gameModel, const InputRecording& recording, ReplaySpeed speed,
+                                ReplayResult& result);
+    
+    /**
+     * 使用调用方的撤销管理器和计分引擎回放录制的输入
+     * 
+     * 两者在回放前按录制重新设置，批量校验时可在多次回放间复用，避免每次重新分配缓冲区
+     * @param gameModel 已加载好录制所用关卡的游戏数据模型，回放后为最终状态
+     * @param recording 输入录制
+     * @param speed 回放速度
+     * @param undoManager 撤销管理器
+     * @param scoring 计分引擎
+     * @param result 输出的回放结果
+     * @return 结论，与result.verdict相同
+     */
+    static ReplayVerdict replay(GameModel* gameModel, const InputRecording& recording, ReplaySpeed speed,
+                                UndoManager& undoManager, ScoringEngine& scoring, ReplayResult& result);
+    
+    /**
+     * 检查模型的初始状态是否与录制一致
+     * @param gameModel 游戏数据模型
+     * @param recording 输入录制
+     * @return 一致返回true
+     */
+    static bool matchesInitialState(const GameModel* gameModel, const InputRecording& recording);
+    
+    /**
+     * 将模型的当前状态与录制的结果比较，填写结果的哈希、得分和结论
+     * 
+     * 供自行驱动回放的调用方（如控制器的界面回放）在最后一条输入之后调用
+     * @param gameModel 回放后的游戏数据模型
+     * @param scoring 回放时使用的计分引擎
+     * @param recording 输入录制
+     * @param result 输出的回放结果，输入计数保持不变
+     * @return 结论
+     */
+    static ReplayVerdict verifyFinalState(const GameModel* gameModel, const ScoringEngine& scoring,
+                                          const InputRecording& recording, ReplayResult& result);
+    
+    /**
+     * 按录制设置计分引擎：重置计分，最大撤销步数和时钟与录制时一致，帧序号从0算起
+     * @param gameModel 处于录制开始状态的游戏数据模型
+     * @param recording 输入录制
+     * @param scoring 计分引擎
+     */
+    static void prepareScoring(const GameModel* gameModel, const InputRecording& recording, ScoringEngine& scoring);
+    
+    /**
+     * 获取结论的名称
+     */
+    static const char* getVerdictName(ReplayVerdict verdict);
+    
+private:
+    // 私有构造函数，防止实例化
+    ReplayService() = delete;
+    ~ReplayService() = delete;
+    ReplayService(const ReplayService&) = delete;
+    ReplayService& operator=(const ReplayService&) = delete;
+};
+
+#endif // __REPLAY_SERVICE_H__
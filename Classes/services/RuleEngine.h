@@ -0,0 +1,141 @@
+﻿#ifndef __RULE_ENGINE_H__
+#define __RULE_ENGINE_H__
+
+#include "RulePolicies.h"
+#include "../models/MoveRecord.h"
+#include "../models/PackedGameState.h"
+#include <cstdint>
+
+/**
+ * @class RuleEngine
+ * @brief 以一套规则实例化的核心状态操作
+ *
+ * 只看牌面的规则直接使用牌面匹配索引的掩码，常数时间判断；
+ * 同花色规则先用牌面掩码排除，再只遍历相关牌面的桶核对花色，牌面匹配索引不为此增加字段，
+ * 经典规则的状态大小和快照开销不受影响
+ *
+ * GameService按核心状态的规则集分派到这里；模拟对局等热循环在入口分派一次后直接调用
+ */
+template <typename Rules>
+class RuleEngine {
+public:
+    typedef typename Rules::MatchRule Match;
+    typedef typename Rules::ScoreRule Score;
+    typedef typename Rules::EndRule End;
+
+    /**
+     * @brief 检查牌桌中是否有能与指定卡牌匹配的卡牌
+     */
+    static bool playfieldCanMatch(const PackedGameState& state, PackedCard card) {
+        const FaceMatchIndex& index = state.faceIndex;
+        uint16_t faces = Match::matchingFaces(card.face()) & index.playfieldMask;
+        if (!Match::SAME_SUIT || faces == 0) {
+            return faces != 0;
+        }
+        for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face) {
+            if (!(faces & (1 << face))) {
+                continue;
+            }
+            for (uint8_t id = index.bucketHead[face]; id != FaceMatchIndex::NO_CARD; id = index.bucketNext[id]) {
+                if (Match::canMatch(*state.playfield.find(id), card)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 检查是否有任意手牌能与任意牌桌卡牌匹配
+     */
+    static bool anyHandCanMatch(const PackedGameState& state) {
+        const FaceMatchIndex& index = state.faceIndex;
+        if ((Match::matchingFacesOf(index.handMask) & index.playfieldMask) == 0) {
+            return false;
+        }
+        if (!Match::SAME_SUIT) {
+            return true;
+        }
+        for (int i = 0; i < state.handCount; ++i) {
+            if (playfieldCanMatch(state, state.handCards[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 列出能与指定卡牌匹配的牌桌卡牌
+     *
+     * @param ids 输出数组，至少PackedGameState::MAX_PLAYFIELD_CARDS个元素；按牌面分组，组内为桶的顺序
+     * @return 卡牌数
+     */
+    static int collectMatchableCards(const PackedGameState& state, PackedCard card, uint8_t* ids) {
+        const FaceMatchIndex& index = state.faceIndex;
+        uint16_t faces = Match::matchingFaces(card.face()) & index.playfieldMask;
+        int count = 0;
+        for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face) {
+            if (!(faces & (1 << face))) {
+                continue;
+            }
+            for (uint8_t id = index.bucketHead[face]; id != FaceMatchIndex::NO_CARD; id = index.bucketNext[id]) {
+                if (!Match::SAME_SUIT || Match::canMatch(*state.playfield.find(id), card)) {
+                    ids[count++] = id;
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief 用顶部手牌匹配一张牌桌卡牌
+     *
+     * @param record 执行成功时输出本步操作的增量记录，可为空
+     * @return 卡牌在牌桌上且能与顶部手牌匹配时执行并返回true
+     */
+    static bool executePlayfieldCardMatch(PackedGameState& state, int cardId, MoveRecord* record) {
+        if (!state.playfield.contains(cardId) || !state.hasTopHandCard()) {
+            return false;
+        }
+
+        SlotHandle handle = state.playfield.handleOf(cardId);
+        PackedCard playfieldCard = *state.playfield.get(handle);
+        PackedCard topCard = state.topHandCard();
+        if (!Match::canMatch(playfieldCard, topCard)) {
+            return false;
+        }
+
+        int32_t scoreDelta = Score::matchScore(playfieldCard, topCard);
+        if (record) {
+            record->type = MT_PLAYFIELD_MATCH;
+            record->cardId = static_cast<uint8_t>(cardId);
+            record->sourceIndex = 0;
+            record->previousTopId = static_cast<uint8_t>(state.topHandId());
+            record->previousTopCard = topCard;
+            record->scoreDelta = scoreDelta;
+        }
+
+        // 用桌面卡牌替换顶部手牌，再移除桌面卡牌
+        state.setTopHandCard(playfieldCard, cardId);
+        state.removePlayfieldCard(handle);
+        state.score += scoreDelta;
+        return true;
+    }
+
+    /**
+     * @brief 检查对局是否结束
+     *
+     * @return 0-继续，1-胜利，-1-失败
+     */
+    static int checkGameEnd(const PackedGameState& state) {
+        return End::template check<RuleEngine>(state);
+    }
+
+private:
+    RuleEngine() = delete;
+    ~RuleEngine() = delete;
+    RuleEngine(const RuleEngine&) = delete;
+    RuleEngine& operator=(const RuleEngine&) = delete;
+};
+
+#endif // __RULE_ENGINE_H__
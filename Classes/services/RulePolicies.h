@@ -0,0 +1,280 @@
+﻿#ifndef __RULE_POLICIES_H__
+#define __RULE_POLICIES_H__
+
+#include "ScoreService.h"
+#include "../configs/CardTypes.h"
+#include "../models/PackedGameState.h"
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @file RulePolicies.h
+ * @brief 编译期规则策略
+ *
+ * 一套规则由三个策略组成：
+ * - MatchRule：哪些牌面（以及花色）可以匹配，提供单张卡牌和牌面掩码两种判断
+ * - ScoreRule：一次匹配的得分
+ * - EndRule：对局何时结束
+ * 策略只有静态方法，查找表在编译期生成；GameService、求解器和模拟对局以规则为模板参数实例化，
+ * 每个变体都编译成独立的、可内联的代码，运行时只在入口按关卡的规则集选一次实例（见RuleRegistry）
+ */
+
+namespace RuleTables {
+
+/**
+ * @brief 把可能越界的牌面绕回0-12
+ */
+constexpr int wrapFace(int face) {
+    return (face % CFT_NUM_CARD_FACE_TYPES + CFT_NUM_CARD_FACE_TYPES) % CFT_NUM_CARD_FACE_TYPES;
+}
+
+/**
+ * @brief 单个牌面的位，越界的牌面为0
+ */
+constexpr uint32_t faceBitOrZero(int face) {
+    return face >= 0 && face < CFT_NUM_CARD_FACE_TYPES ? (1u << face) : 0u;
+}
+
+/**
+ * @brief 与牌面相差distance到maxDistance的牌面掩码
+ */
+constexpr uint16_t matchingFaces(int face, int distance, int maxDistance, bool wrap) {
+    return distance > maxDistance ? static_cast<uint16_t>(0) : static_cast<uint16_t>(
+        (wrap ? (1u << wrapFace(face - distance)) | (1u << wrapFace(face + distance))
+              : faceBitOrZero(face - distance) | faceBitOrZero(face + distance)) |
+        matchingFaces(face, distance + 1, maxDistance, wrap));
+}
+
+/**
+ * @brief 把得分限制为至少1分
+ */
+constexpr int32_t atLeastOne(int32_t score) {
+    return score > 1 ? score : 1;
+}
+
+/**
+ * @brief 匹配一张牌面的得分，A、J、Q、K另加特殊牌奖励
+ */
+constexpr int32_t faceScore(int face, int base, int faceBonus) {
+    return atLeastOne(base + ((face == CFT_ACE || face >= CFT_JACK) ? faceBonus : 0));
+}
+
+} // namespace RuleTables
+
+/**
+ * @struct FaceDistance
+ * @brief 按牌面距离匹配：牌面相差1到MaxDistance即可匹配，Wrap时K与A相邻
+ *
+ * MASKS为每个牌面可匹配的牌面掩码，编译期生成
+ */
+template <int MaxDistance, bool Wrap>
+struct FaceDistance {
+    static_assert(MaxDistance >= 1 && MaxDistance * 2 < CFT_NUM_CARD_FACE_TYPES, "FaceDistance: distance out of range");
+
+    static const int MAX_DISTANCE = MaxDistance;                 ///< 最大牌面距离
+    static const int MAX_MATCHING_FACES = MaxDistance * 2;       ///< 一个牌面最多可匹配的牌面数
+    static constexpr uint16_t MASKS[CFT_NUM_CARD_FACE_TYPES] = {
+        RuleTables::matchingFaces(0, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(1, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(2, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(3, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(4, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(5, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(6, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(7, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(8, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(9, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(10, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(11, 1, MaxDistance, Wrap),
+        RuleTables::matchingFaces(12, 1, MaxDistance, Wrap)
+    };
+
+    /**
+     * @brief 获取能与指定牌面匹配的牌面掩码
+     */
+    static uint16_t matchingFaces(int face) { return MASKS[face]; }
+
+    /**
+     * @brief 获取能与牌面集合中任一牌面匹配的牌面掩码
+     *
+     * 掩码按距离左右移位（Wrap时在13位内循环移位），循环次数是编译期常量
+     */
+    static uint16_t matchingFacesOf(uint16_t mask) {
+        uint32_t faces = 0;
+        for (int distance = 1; distance <= MaxDistance; ++distance) {
+            faces |= (static_cast<uint32_t>(mask) << distance) | (static_cast<uint32_t>(mask) >> distance);
+            if (Wrap) {
+                faces |= (static_cast<uint32_t>(mask) << (CFT_NUM_CARD_FACE_TYPES - distance)) |
+                         (static_cast<uint32_t>(mask) >> (CFT_NUM_CARD_FACE_TYPES - distance));
+            }
+        }
+        return static_cast<uint16_t>(faces & FaceMatchIndex::ALL_FACES);
+    }
+
+    /**
+     * @brief 检查两个牌面是否可以匹配
+     */
+    static bool canMatchFaces(int face1, int face2) {
+        return ((MASKS[face1] >> face2) & 1) != 0;
+    }
+};
+
+template <int MaxDistance, bool Wrap>
+constexpr uint16_t FaceDistance<MaxDistance, Wrap>::MASKS[CFT_NUM_CARD_FACE_TYPES];
+
+/**
+ * @struct AnySuitMatch
+ * @brief 只看牌面的匹配规则
+ *
+ * 求解器中的状态种类即牌面：13种，掩码16位
+ */
+template <typename Faces>
+struct AnySuitMatch : Faces {
+    typedef uint16_t KindMask;                                  ///< 种类掩码
+
+    static const bool SAME_SUIT = false;                        ///< 是否要求同花色
+    static const int KIND_COUNT = CFT_NUM_CARD_FACE_TYPES;      ///< 求解器中卡牌的种类数
+
+    /**
+     * @brief 检查两张卡牌是否可以匹配
+     */
+    static bool canMatch(PackedCard card1, PackedCard card2) {
+        return Faces::canMatchFaces(card1.face(), card2.face());
+    }
+
+    static int kindOf(PackedCard card) { return card.face(); }
+    static int faceOfKind(int kind) { return kind; }
+    static KindMask kindBit(int kind) { return static_cast<KindMask>(1u << kind); }
+    static KindMask matchingKinds(int kind) { return Faces::matchingFaces(kind); }
+    static KindMask matchingKindsOf(KindMask mask) { return Faces::matchingFacesOf(mask); }
+};
+
+/**
+ * @struct SameSuitMatch
+ * @brief 要求同花色的匹配规则
+ *
+ * 求解器中的状态种类为“花色×13+牌面”：52种，掩码64位，每种花色占连续的13位
+ */
+template <typename Faces>
+struct SameSuitMatch : Faces {
+    typedef uint64_t KindMask;                                  ///< 种类掩码
+
+    static const bool SAME_SUIT = true;                         ///< 是否要求同花色
+    static const int KIND_COUNT = CFT_NUM_CARD_FACE_TYPES * CST_NUM_CARD_SUIT_TYPES; ///< 求解器中卡牌的种类数
+
+    /**
+     * @brief 检查两张卡牌是否可以匹配，两个条件按位与，不产生分支
+     */
+    static bool canMatch(PackedCard card1, PackedCard card2) {
+        return Faces::canMatchFaces(card1.face(), card2.face()) & (card1.suit() == card2.suit());
+    }
+
+    static int kindOf(PackedCard card) { return card.suit() * CFT_NUM_CARD_FACE_TYPES + card.face(); }
+    static int faceOfKind(int kind) { return kind % CFT_NUM_CARD_FACE_TYPES; }
+    static KindMask kindBit(int kind) { return static_cast<KindMask>(1) << kind; }
+
+    static KindMask matchingKinds(int kind) {
+        int face = kind % CFT_NUM_CARD_FACE_TYPES;
+        return static_cast<KindMask>(Faces::matchingFaces(face)) << (kind - face);
+    }
+
+    static KindMask matchingKindsOf(KindMask mask) {
+        KindMask kinds = 0;
+        for (int suit = 0; suit < CST_NUM_CARD_SUIT_TYPES; ++suit) {
+            int shift = suit * CFT_NUM_CARD_FACE_TYPES;
+            uint16_t faces = static_cast<uint16_t>((mask >> shift) & FaceMatchIndex::ALL_FACES);
+            kinds |= static_cast<KindMask>(Faces::matchingFacesOf(faces)) << shift;
+        }
+        return kinds;
+    }
+};
+
+typedef AnySuitMatch<FaceDistance<1, false> > ClassicMatch;     ///< 牌面相差1
+typedef AnySuitMatch<FaceDistance<1, true> > WraparoundMatch;   ///< 牌面相差1，K与A相邻
+typedef SameSuitMatch<FaceDistance<1, false> > SameSuitAdjacentMatch; ///< 牌面相差1且同花色
+typedef AnySuitMatch<FaceDistance<2, false> > WithinTwoMatch;   ///< 牌面相差不超过2
+
+/**
+ * @struct TableScore
+ * @brief 查表计分：每个牌面的得分编译期生成，同花色匹配另加SameSuitBonus
+ */
+template <int Base, int FaceBonus, int SameSuitBonus>
+struct TableScore {
+    static constexpr int32_t SCORES[CFT_NUM_CARD_FACE_TYPES] = {
+        RuleTables::faceScore(0, Base, FaceBonus),
+        RuleTables::faceScore(1, Base, FaceBonus),
+        RuleTables::faceScore(2, Base, FaceBonus),
+        RuleTables::faceScore(3, Base, FaceBonus),
+        RuleTables::faceScore(4, Base, FaceBonus),
+        RuleTables::faceScore(5, Base, FaceBonus),
+        RuleTables::faceScore(6, Base, FaceBonus),
+        RuleTables::faceScore(7, Base, FaceBonus),
+        RuleTables::faceScore(8, Base, FaceBonus),
+        RuleTables::faceScore(9, Base, FaceBonus),
+        RuleTables::faceScore(10, Base, FaceBonus),
+        RuleTables::faceScore(11, Base, FaceBonus),
+        RuleTables::faceScore(12, Base, FaceBonus)
+    };
+
+    /**
+     * @brief 计算一次匹配的得分
+     *
+     * @param matchedCard 被匹配的牌桌卡牌
+     * @param topCard 用来匹配的顶部手牌
+     */
+    static int32_t matchScore(PackedCard matchedCard, PackedCard topCard) {
+        return SCORES[matchedCard.face()] + SameSuitBonus * static_cast<int32_t>(matchedCard.suit() == topCard.suit());
+    }
+};
+
+template <int Base, int FaceBonus, int SameSuitBonus>
+constexpr int32_t TableScore<Base, FaceBonus, SameSuitBonus>::SCORES[CFT_NUM_CARD_FACE_TYPES];
+
+/// 标准计分，与ScoreService::calculateMatchScore相同
+typedef TableScore<ScoreService::BASE_MATCH_SCORE, ScoreService::SPECIAL_CARD_BONUS, 0> StandardScore;
+/// 标准计分加同花色奖励
+typedef TableScore<ScoreService::BASE_MATCH_SCORE, ScoreService::SPECIAL_CARD_BONUS, ScoreService::SAME_SUIT_BONUS> SuitBonusScore;
+
+/**
+ * @struct ClearPlayfieldEnd
+ * @brief 清空牌桌即胜利；没有手牌，或顶部手牌无法匹配且没有其他手牌可切换时失败
+ */
+struct ClearPlayfieldEnd {
+    /**
+     * @brief 检查对局是否结束
+     *
+     * @param Engine 提供anyHandCanMatch的规则引擎
+     * @return 0-继续，1-胜利，-1-失败
+     */
+    template <typename Engine>
+    static int check(const PackedGameState& state) {
+        if (state.playfield.empty()) {
+            return 1;
+        }
+        if (!state.hasTopHandCard()) {
+            return -1;
+        }
+        if (state.handCount > 1 || Engine::anyHandCanMatch(state)) {
+            return 0;
+        }
+        return -1;
+    }
+};
+
+/**
+ * @struct RulePolicy
+ * @brief 一套完整的规则
+ */
+template <typename Match, typename Score, typename End>
+struct RulePolicy {
+    typedef Match MatchRule;
+    typedef Score ScoreRule;
+    typedef End EndRule;
+};
+
+typedef RulePolicy<ClassicMatch, StandardScore, ClearPlayfieldEnd> ClassicRules;
+typedef RulePolicy<WraparoundMatch, StandardScore, ClearPlayfieldEnd> WraparoundRules;
+typedef RulePolicy<SameSuitAdjacentMatch, StandardScore, ClearPlayfieldEnd> SameSuitRules;
+typedef RulePolicy<WithinTwoMatch, SuitBonusScore, ClearPlayfieldEnd> BonusRules;
+
+#endif // __RULE_POLICIES_H__
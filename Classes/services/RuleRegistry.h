@@ -0,0 +1,55 @@
+﻿#ifndef __RULE_REGISTRY_H__
+#define __RULE_REGISTRY_H__
+
+#include "RulePolicies.h"
+#include "../configs/RuleSetType.h"
+#include <utility>
+
+/**
+ * @class RuleRegistry
+ * @brief 规则集注册表：把关卡的规则集类型对应到预先编译好的规则实例
+ *
+ * 调用方把要执行的操作写成以规则为参数的类模板Op，提供静态方法run；
+ * dispatch按规则集类型选出Op<Rules>::run并转发参数，分派只是一次switch，
+ * 热循环放在run内部，整段循环都以具体规则编译，不再经过分派
+ *
+ * 增加变体：在RuleSetType中追加枚举值和名称，在RulePolicies.h中组合出规则，
+ * 在dispatch中加一个分支；求解器的牌面级状态另需在FaceState.cpp中显式实例化新的匹配规则
+ * 无效的类型按经典规则处理
+ */
+class RuleRegistry {
+public:
+    /**
+     * @brief 检查规则集类型是否有效
+     */
+    static bool isValid(int ruleSet) { return ruleSet >= 0 && ruleSet < RST_NUM_RULE_SET_TYPES; }
+
+    /**
+     * @brief 以规则集对应的规则执行Op<Rules>::run
+     *
+     * @param ruleSet 规则集类型
+     * @param args 转发给run的参数
+     * @return run的返回值
+     */
+    template <template <typename> class Op, typename... Args>
+    static auto dispatch(int ruleSet, Args&&... args) -> decltype(Op<ClassicRules>::run(std::forward<Args>(args)...)) {
+        switch (ruleSet) {
+            case RST_WRAPAROUND:
+                return Op<WraparoundRules>::run(std::forward<Args>(args)...);
+            case RST_SAME_SUIT:
+                return Op<SameSuitRules>::run(std::forward<Args>(args)...);
+            case RST_BONUS:
+                return Op<BonusRules>::run(std::forward<Args>(args)...);
+            default:
+                return Op<ClassicRules>::run(std::forward<Args>(args)...);
+        }
+    }
+
+private:
+    RuleRegistry() = delete;
+    ~RuleRegistry() = delete;
+    RuleRegistry(const RuleRegistry&) = delete;
+    RuleRegistry& operator=(const RuleRegistry&) = delete;
+};
+
+#endif // __RULE_REGISTRY_H__
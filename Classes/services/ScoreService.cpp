@@ -1,13 +1,12 @@
 ﻿#include "ScoreService.h"
 #include "CardMatchService.h"
 #include <algorithm>
-#include <cmath>
 
 // 得分配置常量定义
-const int ScoreService::BASE_MATCH_SCORE = 10;
-const int ScoreService::SPECIAL_CARD_BONUS = 5;
-const int ScoreService::SAME_SUIT_BONUS = 3;
-const int ScoreService::PERFECT_GAME_MULTIPLIER = 2;
+const int ScoreService::BASE_MATCH_SCORE;
+const int ScoreService::SPECIAL_CARD_BONUS;
+const int ScoreService::SAME_SUIT_BONUS;
+const int ScoreService::PERFECT_GAME_MULTIPLIER;
 const float ScoreService::COMBO_MULTIPLIER = 1.5f;
 const float ScoreService::TIME_BONUS_FACTOR = 0.1f;
 
@@ -22,6 +21,14 @@ int ScoreService::calculateMatchScore(const CardModel& matchedCard, float diffic
     return std::max(1, totalScore); // 确保至少得1分
 }
 
+// 计算单次匹配得分（打包卡牌）
+int ScoreService::calculateMatchScore(PackedCard matchedCard, float difficulty) {
+    int specialBonus = isSpecialFace(matchedCard.face()) ? SPECIAL_CARD_BONUS : 0;
+    int totalScore = static_cast<int>((BASE_MATCH_SCORE + specialBonus) * difficulty);
+    
+    return std::max(1, totalScore); // 确保至少得1分
+}
+
 // 计算连击奖励
 int ScoreService::calculateComboBonus(int comboCount) {
     if (comboCount <= 1) {
@@ -29,7 +36,7 @@ int ScoreService::calculateComboBonus(int comboCount) {
     }
     
     // 连击奖励递增：2连击=2分，3连击=5分，4连击=9分...
-    int bonus = static_cast<int>(std::pow(comboCount - 1, 2) * COMBO_MULTIPLIER);
+    int bonus = static_cast<int>((comboCount - 1) * (comboCount - 1) * COMBO_MULTIPLIER);
     return std::min(bonus, 50); // 限制最大连击奖励
 }
 
@@ -96,8 +103,13 @@ int ScoreService::calculateSuitMatchBonus(const CardModel& card1, const CardMode
 
 // 判断是否为特殊卡牌
 bool ScoreService::isSpecialCard(const CardModel& card) {
-    return (card.face == CFT_ACE || 
-            card.face == CFT_KING || 
-            card.face == CFT_QUEEN || 
-            card.face == CFT_JACK);
+    return isSpecialFace(card.face);
+}
+
+// 判断是否为特殊牌面
+bool ScoreService::isSpecialFace(CardFaceType face) {
+    return (face == CFT_ACE || 
+            face == CFT_KING || 
+            face == CFT_QUEEN || 
+            face == CFT_JACK);
 }
\ No newline at end of file
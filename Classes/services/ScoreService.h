@@ -2,6 +2,7 @@
 #define __SCORE_SERVICE_H__
 
 #include "../models/CardModel.h"
+#include "../models/PackedGameState.h"
 #include <vector>
 
 /**
@@ -21,6 +22,14 @@ public:
      */
     static int calculateMatchScore(const CardModel& matchedCard, float difficulty = 1.0f);
     
+    /**
+     * 计算单次匹配得分
+     * @param matchedCard 被匹配的打包卡牌
+     * @param difficulty 匹配难度系数
+     * @return 得分
+     */
+    static int calculateMatchScore(PackedCard matchedCard, float difficulty = 1.0f);
+    
     /**
      * 计算连击奖励
      * @param comboCount 连击次数
@@ -67,11 +76,11 @@ public:
      */
     static int calculateSuitMatchBonus(const CardModel& card1, const CardModel& card2);
     
-    // 得分配置常量
-    static const int BASE_MATCH_SCORE;
-    static const int SPECIAL_CARD_BONUS;
-    static const int SAME_SUIT_BONUS;
-    static const int PERFECT_GAME_MULTIPLIER;
+    // 得分配置常量，整数常量在类内给出，可用作规则策略的模板参数
+    static const int BASE_MATCH_SCORE = 10;
+    static const int SPECIAL_CARD_BONUS = 5;
+    static const int SAME_SUIT_BONUS = 3;
+    static const int PERFECT_GAME_MULTIPLIER = 2;
     static const float COMBO_MULTIPLIER;
     static const float TIME_BONUS_FACTOR;
     
@@ -88,6 +97,13 @@ private:
      * @return 是否为特殊卡牌
      */
     static bool isSpecialCard(const CardModel& card);
+    
+    /**
+     * 判断牌面是否为特殊牌面（A、J、Q、K）
+     * @param face 牌面
+     * @return 是否为特殊牌面
+     */
+    static bool isSpecialFace(CardFaceType face);
 };
 
 #endif // __SCORE_SERVICE_H__
\ No newline at end of file
@@ -0,0 +1,194 @@
+﻿#include "FaceState.h"
+#include "../services/RulePolicies.h"
+#include <algorithm>
+#include <cstring>
+
+const uint8_t FaceStep::NONE;
+
+template <typename Match>
+const int FaceState<Match>::KIND_COUNT;
+template <typename Match>
+const int FaceState<Match>::MAX_STEPS;
+template <typename Match>
+const uint8_t FaceState<Match>::NO_TOP;
+
+namespace {
+
+const int MAX_KIND_COUNT = PackedGameState::MAX_CARDS;
+
+/**
+ * @struct ZobristKeys
+ * @brief Zobrist哈希的随机键
+ *
+ * 每个种类在牌桌和手牌中的每个数量各有一个键，顶部种类另有一组键
+ * 用固定种子的splitmix64生成，同一状态在不同运行中的哈希相同；种类数相同的规则共用一组键
+ */
+template <int KindCount>
+struct ZobristKeys {
+    uint64_t playfield[KindCount][MAX_KIND_COUNT + 1];
+    uint64_t hand[KindCount][MAX_KIND_COUNT + 1];
+    uint64_t top[KindCount + 1];
+
+    ZobristKeys() {
+        uint64_t seed = 0x2545F4914F6CDD1DULL;
+        for (int kind = 0; kind < KindCount; ++kind) {
+            for (int count = 0; count <= MAX_KIND_COUNT; ++count) {
+                playfield[kind][count] = next(seed);
+                hand[kind][count] = next(seed);
+            }
+        }
+        for (int kind = 0; kind <= KindCount; ++kind) {
+            top[kind] = next(seed);
+        }
+    }
+
+    static uint64_t next(uint64_t& seed) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+template <int KindCount>
+const ZobristKeys<KindCount>& zobrist() {
+    static const ZobristKeys<KindCount> keys;
+    return keys;
+}
+
+/**
+ * @brief 规则集混入哈希的值，经典规则为0，哈希与引入规则集之前相同
+ */
+uint64_t ruleSetKey(int ruleSet) {
+    if (ruleSet == RST_CLASSIC) {
+        return 0;
+    }
+    uint64_t seed = static_cast<uint64_t>(ruleSet);
+    return ZobristKeys<1>::next(seed);
+}
+
+} // namespace
+
+template <typename Match>
+FaceState<Match> FaceState<Match>::fromPacked(const PackedGameState& packed) {
+    const ZobristKeys<KIND_COUNT>& keys = zobrist<KIND_COUNT>();
+    FaceState state;
+    std::memset(state.playfield, 0, sizeof(state.playfield));
+    std::memset(state.hand, 0, sizeof(state.hand));
+    for (int i = 0; i < packed.handCount; ++i) {
+        state.hand[Match::kindOf(packed.handCards[i])]++;
+    }
+    for (int i = 0; i < packed.playfield.size(); ++i) {
+        state.playfield[Match::kindOf(packed.playfield.values[i])]++;
+    }
+
+    state.playfieldMask = 0;
+    state.handMask = 0;
+    state.top = packed.hasTopHandCard() ? static_cast<uint8_t>(Match::kindOf(packed.topHandCard())) : NO_TOP;
+    state.remaining = static_cast<uint8_t>(packed.playfieldCount());
+    state.hash = keys.top[state.top] ^ ruleSetKey(packed.ruleSet);
+    for (int kind = 0; kind < KIND_COUNT; ++kind) {
+        if (state.playfield[kind] > 0) {
+            state.playfieldMask |= Match::kindBit(kind);
+        }
+        if (state.hand[kind] > 0) {
+            state.handMask |= Match::kindBit(kind);
+        }
+        state.hash ^= keys.playfield[kind][state.playfield[kind]] ^ keys.hand[kind][state.hand[kind]];
+    }
+    return state;
+}
+
+template <typename Match>
+FaceState<Match> FaceState<Match>::apply(FaceStep step) const {
+    const ZobristKeys<KIND_COUNT>& keys = zobrist<KIND_COUNT>();
+    int h = step.handKind;
+    int p = step.playfieldKind;
+    FaceState next = *this;
+
+    // 顶部手牌被匹配的牌桌卡牌替换
+    next.hash ^= keys.hand[h][next.hand[h]];
+    if (--next.hand[h] == 0) {
+        next.handMask &= static_cast<KindMask>(~Match::kindBit(h));
+    }
+    next.hash ^= keys.hand[h][next.hand[h]];
+
+    next.hash ^= keys.hand[p][next.hand[p]];
+    next.hand[p]++;
+    next.handMask |= Match::kindBit(p);
+    next.hash ^= keys.hand[p][next.hand[p]];
+
+    next.hash ^= keys.playfield[p][next.playfield[p]];
+    if (--next.playfield[p] == 0) {
+        next.playfieldMask &= static_cast<KindMask>(~Match::kindBit(p));
+    }
+    next.hash ^= keys.playfield[p][next.playfield[p]];
+
+    next.hash ^= keys.top[next.top] ^ keys.top[p];
+    next.top = static_cast<uint8_t>(p);
+    next.remaining--;
+    return next;
+}
+
+template <typename Match>
+int FaceState<Match>::generateSteps(FaceStep* steps) const {
+    int count = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int h = 0; h < KIND_COUNT; ++h) {
+            if (hand[h] == 0 || (h == top) != (pass == 0)) {
+                continue;
+            }
+            KindMask targets = Match::matchingKinds(h) & playfieldMask;
+            for (int p = 0; targets != 0; ++p, targets >>= 1) {
+                if (targets & 1) {
+                    steps[count].handKind = static_cast<uint8_t>(h);
+                    steps[count].playfieldKind = static_cast<uint8_t>(p);
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+template <typename Match>
+bool FaceState<Match>::isDead() const {
+    return remaining > 0 && (Match::matchingKindsOf(handMask) & playfieldMask) == 0;
+}
+
+template <typename Match>
+bool FaceState<Match>::resolveStep(const PackedGameState& state, FaceStep step, int& handCardId, int& playfieldCardId) {
+    if (!state.hasTopHandCard()) {
+        return false;
+    }
+
+    handCardId = -1;
+    if (Match::kindOf(state.topHandCard()) != step.handKind) {
+        for (int i = state.handCount - 2; i >= 0; --i) {
+            if (Match::kindOf(state.handCards[i]) == step.handKind) {
+                handCardId = state.handIds[i];
+                break;
+            }
+        }
+        if (handCardId < 0) {
+            return false;
+        }
+    }
+
+    // 桶按牌面划分，同花色规则下还要核对种类
+    playfieldCardId = -1;
+    for (uint8_t id = state.faceIndex.bucketHead[Match::faceOfKind(step.playfieldKind)];
+         id != FaceMatchIndex::NO_CARD;
+         id = state.faceIndex.bucketNext[id]) {
+        if (Match::kindOf(*state.playfield.find(id)) == step.playfieldKind) {
+            playfieldCardId = std::max(playfieldCardId, static_cast<int>(id));
+        }
+    }
+    return playfieldCardId >= 0;
+}
+
+// 每个匹配规则一个实例，新增匹配规则时在此追加
+template struct FaceState<ClassicMatch>;
+template struct FaceState<WraparoundMatch>;
+template struct FaceState<SameSuitAdjacentMatch>;
+template struct FaceState<WithinTwoMatch>;
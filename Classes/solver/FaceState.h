@@ -0,0 +1,99 @@
+﻿#ifndef __FACE_STATE_H__
+#define __FACE_STATE_H__
+
+#include "../configs/CardTypes.h"
+#include "../models/PackedGameState.h"
+#include <cstdint>
+
+/**
+ * @struct FaceStep
+ * @brief 牌面级的一步：把某个种类的手牌作为顶部手牌（需要时先切换），再匹配某个种类的牌桌卡牌
+ *
+ * 种类由匹配规则决定：只看牌面的规则下即牌面，同花色规则下为“花色×13+牌面”
+ */
+struct FaceStep {
+    static const uint8_t NONE = 0xFF;   ///< 没有可行步时handKind的取值
+
+    uint8_t handKind;       ///< 用来匹配的手牌种类
+    uint8_t playfieldKind;  ///< 被匹配的牌桌卡牌种类
+};
+
+/**
+ * @struct FaceState
+ * @brief 牌面级的对局状态
+ *
+ * 匹配只看卡牌的种类（见FaceStep），因此只记录牌桌和手牌中每个种类的数量以及顶部手牌的种类，
+ * 同种类不同位置的卡牌在此视为等价
+ * 一步总会移除一张牌桌卡牌，由这些步组成的状态图无环
+ *
+ * 以匹配规则为模板参数，在FaceState.cpp中为每个匹配规则显式实例化
+ * 哈希为Zobrist哈希，随每一步增量更新，并混入非经典的规则集，不同规则的相同局面哈希不同；求解器和提示共用
+ */
+template <typename Match>
+struct FaceState {
+    typedef typename Match::KindMask KindMask;
+
+    static const int KIND_COUNT = Match::KIND_COUNT;                            ///< 种类数
+    static const int MAX_STEPS = KIND_COUNT * Match::MAX_MATCHING_FACES;        ///< 一个状态最多的可行步数
+    static const uint8_t NO_TOP = KIND_COUNT;                                   ///< 没有手牌时顶部种类的取值
+
+    uint8_t playfield[KIND_COUNT];  ///< 牌桌中每个种类的数量
+    uint8_t hand[KIND_COUNT];       ///< 手牌中每个种类的数量（含顶部手牌）
+    KindMask playfieldMask;         ///< 牌桌中出现的种类
+    KindMask handMask;              ///< 手牌中出现的种类
+    uint8_t top;                    ///< 顶部手牌的种类，没有手牌时为NO_TOP
+    uint8_t remaining;              ///< 剩余牌桌卡牌数
+    uint64_t hash;                  ///< Zobrist哈希
+
+    /**
+     * @brief 由核心状态生成牌面级状态
+     */
+    static FaceState fromPacked(const PackedGameState& state);
+
+    /**
+     * @brief 执行一步，返回新状态
+     */
+    FaceState apply(FaceStep step) const;
+
+    /**
+     * @brief 检查一步是否需要先切换顶部手牌
+     */
+    bool needsSwitch(FaceStep step) const { return step.handKind != top; }
+
+    /**
+     * @brief 检查顶部手牌能否匹配任意牌桌卡牌
+     */
+    bool topCanMatch() const {
+        return top != NO_TOP && (Match::matchingKinds(top) & playfieldMask) != 0;
+    }
+
+    /**
+     * @brief 列出所有可行的步，不需要切换手牌的排在前面
+     *
+     * @param steps 输出数组，至少MAX_STEPS个元素
+     * @return 步数
+     */
+    int generateSteps(FaceStep* steps) const;
+
+    /**
+     * @brief 检查是否已成死局：还有牌桌卡牌，但手牌种类与牌桌种类没有任何可匹配的
+     *
+     * 手牌只会因匹配而变化，死局之后不可能再匹配
+     */
+    bool isDead() const;
+
+    /**
+     * @brief 把牌面级的一步对应到具体卡牌
+     *
+     * 需要切换时选最靠近顶部的同种类手牌，匹配时选最上层（ID最大）的同种类牌桌卡牌
+     *
+     * @param state 当前核心状态
+     * @param step 要执行的步
+     * @param handCardId 输出要先切换到顶部的手牌ID，不需要切换时为-1
+     * @param playfieldCardId 输出要匹配的牌桌卡牌ID
+     * @return 核心状态中存在对应卡牌时返回true
+     */
+    static bool resolveStep(const PackedGameState& state, FaceStep step, int& handCardId, int& playfieldCardId);
+};
+
+#endif // __FACE_STATE_H__
@@ -0,0 +1,355 @@
+﻿#include "LevelSolver.h"
+#include "FaceState.h"
+#include "../services/GameService.h"
+#include "../services/RuleRegistry.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+const uint16_t TranspositionTable::DEAD_FLAG;
+const uint16_t TranspositionTable::COST_MASK;
+const int TranspositionTable::BUCKET_SIZE;
+const uint64_t TranspositionTable::VALUE_MASK;
+
+namespace {
+
+const int SPLIT_MIN_REMAINING = 6;          ///< 剩余牌桌卡牌不少于此数时才拆分子树
+const uint64_t NODE_FLUSH_INTERVAL = 1024;  ///< 每展开多少个节点汇总一次计数
+
+/**
+ * @brief 剩余代价的下界：每张牌桌卡牌一次匹配，顶部手牌无法匹配时至少再切换一次
+ */
+template <typename Match>
+int lowerBound(const FaceState<Match>& state) {
+    if (state.remaining == 0) {
+        return 0;
+    }
+    return state.remaining + (state.topCanMatch() ? 0 : 1);
+}
+
+/**
+ * @struct SearchTask
+ * @brief 可被其他线程窃取的子树
+ */
+template <typename Match>
+struct SearchTask {
+    FaceState<Match> state;
+    int cost;
+    std::vector<FaceStep> path;     ///< 从根到该状态的步骤
+};
+
+/**
+ * @struct SearchWorker
+ * @brief 工作线程的任务队列和计数
+ */
+template <typename Match>
+struct SearchWorker {
+    std::mutex mutex;
+    std::deque<SearchTask<Match> > tasks;   ///< 本线程从尾部取，其他线程从头部窃取
+    uint64_t nodes;                 ///< 已展开的节点数
+    uint64_t unflushedNodes;        ///< 尚未汇总到全局计数的节点数
+    uint64_t tableHits;             ///< 置换表剪枝次数
+
+    SearchWorker() : nodes(0), unflushedNodes(0), tableHits(0) {}
+};
+
+/**
+ * @class ParallelSearch
+ * @brief 一次求解的多线程搜索过程，以匹配规则实例化
+ */
+template <typename Match>
+class ParallelSearch {
+public:
+    typedef FaceState<Match> State;
+    typedef SearchTask<Match> Task;
+    typedef SearchWorker<Match> Worker;
+
+    ParallelSearch(TranspositionTable& table, int threadCount, uint64_t maxNodes)
+        : m_table(table)
+        , m_maxNodes(maxNodes)
+        , m_bestCost(INT_MAX)
+        , m_totalNodes(0)
+        , m_pendingTasks(0)
+        , m_idleWorkers(0)
+        , m_stopped(false) {
+        for (int i = 0; i < threadCount; ++i) {
+            m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+    }
+
+    /**
+     * @brief 从根状态开始搜索，所有线程结束后返回
+     */
+    void run(const State& root) {
+        Task task;
+        task.state = root;
+        task.cost = 0;
+        pushTask(0, task);
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < m_workers.size(); ++i) {
+            threads.push_back(std::thread(&ParallelSearch::workerLoop, this, static_cast<int>(i)));
+        }
+        workerLoop(0);
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+    }
+
+    bool foundSolution() const { return m_bestCost.load() != INT_MAX; }
+    bool stopped() const { return m_stopped.load(); }
+    const std::vector<FaceStep>& bestPath() const { return m_bestPath; }
+
+    uint64_t nodes() const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < m_workers.size(); ++i) {
+            total += m_workers[i]->nodes;
+        }
+        return total;
+    }
+
+    uint64_t tableHits() const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < m_workers.size(); ++i) {
+            total += m_workers[i]->tableHits;
+        }
+        return total;
+    }
+
+private:
+    void workerLoop(int index) {
+        Task task;
+        bool idle = false;
+        while (true) {
+            if (popTask(index, task)) {
+                if (idle) {
+                    m_idleWorkers--;
+                    idle = false;
+                }
+                search(index, task.state, task.cost, task.path);
+                m_pendingTasks--;
+                continue;
+            }
+            if (m_pendingTasks.load() == 0) {
+                break;
+            }
+            if (!idle) {
+                m_idleWorkers++;
+                idle = true;
+            }
+            std::this_thread::yield();
+        }
+        if (idle) {
+            m_idleWorkers--;
+        }
+    }
+
+    void pushTask(int index, const Task& task) {
+        m_pendingTasks++;
+        Worker& worker = *m_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(task);
+    }
+
+    /**
+     * @brief 先取本线程最近拆出的任务，没有则从其他线程窃取最早拆出的（最大的）子树
+     */
+    bool popTask(int index, Task& task) {
+        {
+            Worker& worker = *m_workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.tasks.empty()) {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+                return true;
+            }
+        }
+        int count = static_cast<int>(m_workers.size());
+        for (int offset = 1; offset < count; ++offset) {
+            Worker& victim = *m_workers[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void countNode(Worker& worker) {
+        worker.nodes++;
+        if (++worker.unflushedNodes >= NODE_FLUSH_INTERVAL) {
+            uint64_t total = m_totalNodes.fetch_add(worker.unflushedNodes) + worker.unflushedNodes;
+            worker.unflushedNodes = 0;
+            if (m_maxNodes != 0 && total >= m_maxNodes) {
+                m_stopped.store(true);
+            }
+        }
+    }
+
+    void recordSolution(int cost, const std::vector<FaceStep>& path) {
+        std::lock_guard<std::mutex> lock(m_bestMutex);
+        if (cost < m_bestCost.load()) {
+            m_bestPath = path;
+            m_bestCost.store(cost);
+        }
+    }
+
+    /**
+     * @brief 深度优先搜索一棵子树
+     *
+     * @param path 从根到当前状态的步骤，返回时恢复原样
+     * @return 子树被证明无解时返回true；被剪枝、拆分或中止时返回false
+     */
+    bool search(int index, const State& state, int cost, std::vector<FaceStep>& path) {
+        if (m_stopped.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (state.remaining == 0) {
+            recordSolution(cost, path);
+            return false;
+        }
+        if (state.isDead()) {
+            return true;
+        }
+        if (cost + lowerBound(state) >= m_bestCost.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        Worker& worker = *m_workers[index];
+        TranspositionTable::ProbeResult probe = m_table.visit(state.hash, static_cast<uint16_t>(cost));
+        if (probe != TranspositionTable::PR_NEW) {
+            worker.tableHits++;
+            return probe == TranspositionTable::PR_DEAD;
+        }
+        countNode(worker);
+
+        // 先尝试不需要切换手牌的步骤，使贪心路径尽早给出上界
+        FaceStep steps[State::MAX_STEPS];
+        int stepCount = state.generateSteps(steps);
+
+        bool split = state.remaining >= SPLIT_MIN_REMAINING && m_idleWorkers.load(std::memory_order_relaxed) > 0;
+        bool allDead = true;
+        for (int i = 0; i < stepCount; ++i) {
+            int stepCost = state.needsSwitch(steps[i]) ? 2 : 1;
+            path.push_back(steps[i]);
+            if (split && i > 0) {
+                Task task;
+                task.state = state.apply(steps[i]);
+                task.cost = cost + stepCost;
+                task.path = path;
+                pushTask(index, task);
+                allDead = false;
+            } else if (!search(index, state.apply(steps[i]), cost + stepCost, path)) {
+                allDead = false;
+            }
+            path.pop_back();
+        }
+
+        if (allDead) {
+            m_table.markDead(state.hash);
+        }
+        return allDead;
+    }
+
+    TranspositionTable& m_table;
+    uint64_t m_maxNodes;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<int> m_bestCost;
+    std::mutex m_bestMutex;
+    std::vector<FaceStep> m_bestPath;
+    std::atomic<uint64_t> m_totalNodes;
+    std::atomic<int> m_pendingTasks;
+    std::atomic<int> m_idleWorkers;
+    std::atomic<bool> m_stopped;
+};
+
+/**
+ * @brief 在对局副本上逐步执行牌面级的解，得到具体的卡牌操作
+ *
+ * 需要切换时选最靠近顶部的同种类手牌，匹配时选最上层的同种类牌桌卡牌
+ * @return 每一步都被GameService接受且最终清空牌桌时返回true
+ */
+template <typename Match>
+bool expandSolution(const GameModel& model, const std::vector<FaceStep>& path, std::vector<MoveRecord>& moves) {
+    GameModel replay = model;
+    PackedGameState& state = replay.state;
+    moves.clear();
+
+    for (size_t i = 0; i < path.size(); ++i) {
+        int handCardId = -1;
+        int playfieldCardId = -1;
+        if (!FaceState<Match>::resolveStep(state, path[i], handCardId, playfieldCardId)) {
+            return false;
+        }
+
+        MoveRecord record;
+        if (handCardId >= 0) {
+            if (!GameService::executeHandCardReplacement(state, handCardId, &record)) {
+                return false;
+            }
+            moves.push_back(record);
+        }
+        if (!GameService::executePlayfieldCardMatch(state, playfieldCardId, &record)) {
+            return false;
+        }
+        moves.push_back(record);
+    }
+
+    return replay.checkWinCondition();
+}
+
+/**
+ * @brief 以关卡规则的匹配规则搜索并展开解
+ */
+template <typename Rules>
+struct SolveOp {
+    static void run(const GameModel& model, TranspositionTable& table, int threadCount, uint64_t maxNodes,
+                    SolverResult& result) {
+        typedef typename Rules::MatchRule Match;
+        ParallelSearch<Match> search(table, threadCount, maxNodes);
+        search.run(FaceState<Match>::fromPacked(model.state));
+
+        result.complete = !search.stopped();
+        result.nodes = search.nodes();
+        result.tableHits = search.tableHits();
+        if (search.foundSolution()) {
+            result.solvable = expandSolution<Match>(model, search.bestPath(), result.moves);
+            assert(result.solvable && "LevelSolver: face-level solution rejected by GameService");
+            if (result.solvable) {
+                result.moveCount = static_cast<int>(result.moves.size());
+            } else {
+                result.moves.clear();
+                result.complete = false;
+            }
+        }
+    }
+};
+
+} // namespace
+
+LevelSolver::LevelSolver(const SolverOptions& options)
+    : m_options(options) {
+}
+
+SolverResult LevelSolver::solve(const GameModel& model) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    SolverResult result;
+
+    int threadCount = m_options.threadCount;
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    m_table.resize(m_options.tableSizeLog2);
+    RuleRegistry::dispatch<SolveOp>(model.state.ruleSet, model, m_table, threadCount, m_options.maxNodes, result);
+
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,83 @@
+﻿#ifndef __LEVEL_SOLVER_H__
+#define __LEVEL_SOLVER_H__
+
+#include "TranspositionTable.h"
+#include "../models/GameModel.h"
+#include "../models/MoveRecord.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct SolverOptions
+ * @brief 求解器参数
+ */
+struct SolverOptions {
+    int threadCount;        ///< 工作线程数，0表示使用硬件线程数
+    uint64_t maxNodes;      ///< 展开节点数上限，0表示不限
+    int tableSizeLog2;      ///< 置换表条目数的2的幂次
+
+    SolverOptions() : threadCount(0), maxNodes(0), tableSizeLog2(20) {}
+};
+
+/**
+ * @struct SolverResult
+ * @brief 求解结果
+ */
+struct SolverResult {
+    bool solvable;                  ///< 是否找到解
+    bool complete;                  ///< 搜索是否穷尽；为false时未找到解不代表关卡无解，找到的解也不一定最短
+    int moveCount;                  ///< 解的步数，无解为-1
+    std::vector<MoveRecord> moves;  ///< 解的操作序列，可逐步交给GameService::replayMove
+    uint64_t nodes;                 ///< 展开的状态数
+    uint64_t tableHits;             ///< 被置换表剪掉的状态数
+    double elapsedSeconds;          ///< 耗时（秒）
+
+    SolverResult() : solvable(false), complete(false), moveCount(-1), nodes(0), tableHits(0), elapsedSeconds(0.0) {}
+};
+
+/**
+ * @class LevelSolver
+ * @brief 关卡穷举求解器
+ *
+ * 判断关卡是否可解并给出步数最少的解
+ *
+ * 匹配只看卡牌的种类（牌面，同花色规则下为牌面和花色），因此搜索状态只记录牌桌和手牌中每个种类的数量
+ * 以及顶部手牌的种类，同种类不同位置的卡牌在搜索中等价
+ * 搜索按对局的规则集在入口分派一次，整个搜索以该规则的匹配规则编译
+ * 搜索的一步为“（需要时）切换顶部手牌，再匹配一张牌桌卡牌”，代价为1或2；
+ * 每一步都减少一张牌桌卡牌，状态图无环，深度不超过牌桌卡牌数
+ *
+ * 搜索为多线程分支定界深度优先：
+ * - 状态用Zobrist哈希，在无锁置换表中记录到达代价，以不更小的代价再次到达时剪枝
+ * - 已被证明无解的状态也记入置换表
+ * - 手牌和牌桌牌面掩码无法匹配时立即判定无解
+ * - 每个线程有自己的任务队列，有线程空闲时把浅层子树拆成任务供其窃取
+ *
+ * 找到的牌面级解最后在GameModel副本上逐步执行GameService得到具体操作，
+ * 因此结果中的操作序列与游戏规则一致
+ */
+class LevelSolver {
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param options 求解参数
+     */
+    explicit LevelSolver(const SolverOptions& options = SolverOptions());
+
+    /**
+     * @brief 求解一个对局状态
+     *
+     * 同一个求解器可依次求解多个关卡，置换表在每次求解前清空
+     *
+     * @param model 要求解的对局，不会被修改
+     * @return 求解结果
+     */
+    SolverResult solve(const GameModel& model);
+
+private:
+    SolverOptions m_options;            ///< 求解参数
+    TranspositionTable m_table;         ///< 置换表，多次求解间复用内存
+};
+
+#endif // __LEVEL_SOLVER_H__
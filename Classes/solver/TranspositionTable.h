@@ -0,0 +1,129 @@
+﻿#ifndef __TRANSPOSITION_TABLE_H__
+#define __TRANSPOSITION_TABLE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class TranspositionTable
+ * @brief 无锁置换表
+ *
+ * 以Zobrist哈希为键，记录到达每个状态的最小代价和该状态是否已被证明无解
+ * 每个条目是一个64位原子整数：高48位为哈希校验位，低16位为值
+ * 值的最高位为无解标记，其余15位为代价；条目为0表示空
+ *
+ * 多个工作线程并发读写，写入通过CAS完成，不加锁
+ * 表容量固定，冲突时按4个条目一组线性探测，组满则覆盖组内第一个条目；
+ * 丢失的条目只会让搜索多展开一些节点，不影响结果的正确性
+ */
+class TranspositionTable {
+public:
+    static const uint16_t DEAD_FLAG = 0x8000;   ///< 无解标记
+    static const uint16_t COST_MASK = 0x7FFF;   ///< 代价部分的掩码
+
+    /**
+     * @brief 探测结果
+     */
+    enum ProbeResult {
+        PR_NEW,         ///< 首次到达，或以更小的代价到达，已记录，需要展开
+        PR_VISITED,     ///< 已以不大于当前的代价到达过，可以剪枝
+        PR_DEAD         ///< 已被证明无解，可以剪枝
+    };
+
+    TranspositionTable() : m_mask(0) {}
+
+    /**
+     * @brief 按2的幂次分配并清空表
+     *
+     * @param sizeLog2 条目数的2的幂次
+     */
+    void resize(int sizeLog2) {
+        size_t size = static_cast<size_t>(1) << sizeLog2;
+        if (size != m_mask + 1 || !m_entries) {
+            m_entries.reset(new std::atomic<uint64_t>[size]);
+            m_mask = size - 1;
+        }
+        clear();
+    }
+
+    /**
+     * @brief 清空所有条目，不能与搜索并发调用
+     */
+    void clear() {
+        for (size_t i = 0; m_entries && i <= m_mask; ++i) {
+            m_entries[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 以指定代价到达一个状态
+     *
+     * 状态未记录或记录的代价更大时写入当前代价
+     *
+     * @param hash 状态的Zobrist哈希
+     * @param cost 到达该状态的代价
+     */
+    ProbeResult visit(uint64_t hash, uint16_t cost) {
+        uint64_t tag = makeTag(hash);
+        std::atomic<uint64_t>* bucket = bucketOf(hash);
+        for (int i = 0; i < BUCKET_SIZE; ++i) {
+            uint64_t entry = bucket[i].load(std::memory_order_acquire);
+            while (entry == 0 || (entry & ~VALUE_MASK) == tag) {
+                if (entry != 0) {
+                    uint16_t value = static_cast<uint16_t>(entry & VALUE_MASK);
+                    if (value & DEAD_FLAG) {
+                        return PR_DEAD;
+                    }
+                    if ((value & COST_MASK) <= cost) {
+                        return PR_VISITED;
+                    }
+                }
+                if (bucket[i].compare_exchange_weak(entry, tag | cost, std::memory_order_acq_rel)) {
+                    return PR_NEW;
+                }
+                // CAS失败时entry已更新为最新值，重新判断
+            }
+        }
+        bucket[0].store(tag | cost, std::memory_order_release);
+        return PR_NEW;
+    }
+
+    /**
+     * @brief 标记一个状态无解
+     */
+    void markDead(uint64_t hash) {
+        uint64_t tag = makeTag(hash);
+        std::atomic<uint64_t>* bucket = bucketOf(hash);
+        for (int i = 0; i < BUCKET_SIZE; ++i) {
+            uint64_t entry = bucket[i].load(std::memory_order_acquire);
+            while (entry == 0 || (entry & ~VALUE_MASK) == tag) {
+                if (bucket[i].compare_exchange_weak(entry, tag | DEAD_FLAG, std::memory_order_acq_rel)) {
+                    return;
+                }
+            }
+        }
+        bucket[0].store(tag | DEAD_FLAG, std::memory_order_release);
+    }
+
+private:
+    static const int BUCKET_SIZE = 4;
+    static const uint64_t VALUE_MASK = 0xFFFF;
+
+    /**
+     * @brief 取哈希高48位作为校验位，保证非零以区分空条目
+     */
+    static uint64_t makeTag(uint64_t hash) {
+        uint64_t tag = hash & ~VALUE_MASK;
+        return tag != 0 ? tag : (static_cast<uint64_t>(1) << 16);
+    }
+
+    std::atomic<uint64_t>* bucketOf(uint64_t hash) {
+        return &m_entries[(hash & m_mask) & ~static_cast<uint64_t>(BUCKET_SIZE - 1)];
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> m_entries;
+    size_t m_mask;
+};
+
+#endif // __TRANSPOSITION_TABLE_H__
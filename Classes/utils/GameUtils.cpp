@@ -1,18 +1,17 @@
 ﻿#include "GameUtils.h"
+#include "../services/RulePolicies.h"
 #include <cmath>
-
-USING_NS_CC;
-
-// 静态变量初始化
-int GameUtils::s_nextCardId = 1;
+#include <cstdlib>
 
 // 检查两张卡牌是否可以匹配
 bool GameUtils::canMatch(const CardModel& card1, const CardModel& card2) {
-    int face1 = static_cast<int>(card1.face);
-    int face2 = static_cast<int>(card2.face);
-    
-    // 牌面值相差1可以匹配
-    return std::abs(face1 - face2) == 1;
+    return canMatchFaces(card1.face, card2.face);
+}
+
+// 检查两个牌面是否可以匹配
+bool GameUtils::canMatchFaces(CardFaceType face1, CardFaceType face2) {
+    // 经典规则：牌面值相差1可以匹配
+    return ClassicMatch::canMatchFaces(face1, face2);
 }
 
 // 获取卡牌名称字符串
@@ -70,11 +69,6 @@ std::string GameUtils::getFaceName(CardFaceType face) {
     }
 }
 
-// 生成唯一卡牌ID
-int GameUtils::generateUniqueCardId() {
-    return s_nextCardId++;
-}
-
 // 获取卡牌图片资源名称
 std::string GameUtils::getCardImageName(const CardModel& card) {
     std::string colorPrefix;
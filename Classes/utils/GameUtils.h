@@ -1,7 +1,6 @@
 ﻿#ifndef __GAME_UTILS_H__
 #define __GAME_UTILS_H__
 
-#include "cocos2d.h"
 #include "../models/CardModel.h"
 #include <string>
 
@@ -37,6 +36,16 @@ public:
      */
     static bool canMatch(const CardModel& card1, const CardModel& card2);
     
+    /**
+     * @brief 检查两个牌面是否可以匹配
+     * 
+     * 匹配规则：牌面值相差1
+     * @param face1 第一个牌面
+     * @param face2 第二个牌面
+     * @return 可以匹配返回true，否则返回false
+     */
+    static bool canMatchFaces(CardFaceType face1, CardFaceType face2);
+    
     /**
      * @brief 获取卡牌名称字符串
      * 
@@ -61,13 +70,6 @@ public:
      */
     static std::string getFaceName(CardFaceType face);
     
-    /**
-     * @brief 生成唯一的卡牌ID
-     * 
-     * @return 新的唯一卡牌标识符
-     */
-    static int generateUniqueCardId();
-    
     /**
      * @brief 获取卡牌图片资源名称
      * 
@@ -82,9 +84,6 @@ public:
      * @return 卡牌背面的图片资源文件名
      */
     static std::string getCardBackImageName();
-    
-private:
-    static int s_nextCardId; ///< 用于生成唯一ID的静态计数器
 };
 
 #endif // __GAME_UTILS_H__
\ No newline at end of file
@@ -0,0 +1,197 @@
+﻿#ifndef __SLOT_MAP_H__
+#define __SLOT_MAP_H__
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct SlotHandle
+ * @brief 槽位映射中元素的句柄
+ *
+ * 由键和代数组成，键被移除后代数加一，旧句柄随之失效
+ */
+struct SlotHandle {
+    uint16_t key;           ///< 元素的键
+    uint16_t generation;    ///< 创建句柄时键的代数
+
+    bool operator==(const SlotHandle& other) const { return key == other.key && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @struct SlotMap
+ * @brief 定长的代数槽位映射
+ *
+ * 元素按调用方给定的键（如卡牌ID）存放，值紧密排列在数组前部便于遍历，
+ * 另有键到紧密下标的映射，因此查找、插入和删除都是O(1)
+ * 删除时把最后一个元素移到空位，紧密数组中的元素顺序因此不固定
+ *
+ * 结构体为POD类型，可直接memcpy；下标类型按容量自动选择8位或16位
+ * 调试构建（未定义NDEBUG）下会断言检查句柄和键的有效性
+ *
+ * @tparam T 元素类型，需可平凡复制
+ * @tparam Capacity 最多同时存放的元素个数
+ * @tparam KeyCount 键的取值范围[0, KeyCount)
+ */
+template <typename T, int Capacity, int KeyCount>
+struct SlotMap {
+    typedef typename std::conditional<(Capacity < 0xFF && KeyCount <= 0xFF), uint8_t, uint16_t>::type Index;
+
+    static const Index NO_SLOT = static_cast<Index>(~static_cast<Index>(0)); ///< 键不存在时的下标
+
+    T values[Capacity];             ///< 紧密排列的元素
+    Index keys[Capacity];           ///< 每个紧密下标对应的键
+    Index slots[KeyCount];          ///< 每个键对应的紧密下标，不存在时为NO_SLOT
+    uint16_t generations[KeyCount]; ///< 每个键的代数
+    Index count;                    ///< 元素个数
+
+    /**
+     * @brief 清空所有元素
+     *
+     * @param resetGenerations 是否同时重置代数；保留代数可使清空前的句柄继续被判为失效
+     */
+    void clear(bool resetGenerations = true) {
+        count = 0;
+        for (int key = 0; key < KeyCount; ++key) {
+            slots[key] = NO_SLOT;
+            if (resetGenerations) {
+                generations[key] = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief 获取元素个数
+     */
+    int size() const { return count; }
+
+    /**
+     * @brief 检查是否没有元素
+     */
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief 检查键是否存在
+     */
+    bool contains(int key) const {
+        return key >= 0 && key < KeyCount && slots[key] != NO_SLOT;
+    }
+
+    /**
+     * @brief 检查句柄是否仍然有效
+     */
+    bool isValid(SlotHandle handle) const {
+        return contains(handle.key) && generations[handle.key] == handle.generation;
+    }
+
+    /**
+     * @brief 获取键的当前句柄，调用前需确认键存在
+     */
+    SlotHandle handleOf(int key) const {
+        assert(contains(key) && "SlotMap: key not present");
+        SlotHandle handle;
+        handle.key = static_cast<uint16_t>(key);
+        handle.generation = generations[key];
+        return handle;
+    }
+
+    /**
+     * @brief 获取键对应的紧密下标
+     *
+     * @return 存在返回下标，否则返回-1
+     */
+    int indexOf(int key) const {
+        return contains(key) ? slots[key] : -1;
+    }
+
+    /**
+     * @brief 插入元素
+     *
+     * @param key 元素的键，不能已存在
+     * @param value 元素值
+     * @return 新元素的句柄
+     */
+    SlotHandle insert(int key, const T& value) {
+        assert(key >= 0 && key < KeyCount && "SlotMap: key out of range");
+        assert(!contains(key) && "SlotMap: key already present");
+        assert(count < Capacity && "SlotMap: capacity exceeded");
+        values[count] = value;
+        keys[count] = static_cast<Index>(key);
+        slots[key] = count;
+        count++;
+        return handleOf(key);
+    }
+
+    /**
+     * @brief 通过句柄获取元素
+     *
+     * 调试构建下句柄失效会触发断言，发布构建下返回nullptr
+     */
+    T* get(SlotHandle handle) {
+        assert(isValid(handle) && "SlotMap: stale handle");
+        return isValid(handle) ? &values[slots[handle.key]] : nullptr;
+    }
+
+    /**
+     * @brief 通过句柄获取元素（只读）
+     */
+    const T* get(SlotHandle handle) const {
+        assert(isValid(handle) && "SlotMap: stale handle");
+        return isValid(handle) ? &values[slots[handle.key]] : nullptr;
+    }
+
+    /**
+     * @brief 通过键查找元素
+     *
+     * @return 存在返回元素指针，否则返回nullptr；指针在下一次插入或删除后失效
+     */
+    T* find(int key) {
+        return contains(key) ? &values[slots[key]] : nullptr;
+    }
+
+    /**
+     * @brief 通过键查找元素（只读）
+     */
+    const T* find(int key) const {
+        return contains(key) ? &values[slots[key]] : nullptr;
+    }
+
+    /**
+     * @brief 通过句柄删除元素
+     *
+     * @return 删除成功返回true，句柄失效返回false
+     */
+    bool erase(SlotHandle handle) {
+        assert(isValid(handle) && "SlotMap: stale handle");
+        return isValid(handle) && erase(static_cast<int>(handle.key));
+    }
+
+    /**
+     * @brief 通过键删除元素
+     *
+     * 最后一个元素移到被删除元素的位置，键的代数加一
+     * @return 删除成功返回true，键不存在返回false
+     */
+    bool erase(int key) {
+        if (!contains(key)) {
+            return false;
+        }
+        Index index = slots[key];
+        Index last = static_cast<Index>(count - 1);
+        if (index != last) {
+            values[index] = values[last];
+            keys[index] = keys[last];
+            slots[keys[index]] = index;
+        }
+        slots[key] = NO_SLOT;
+        generations[key]++;
+        count--;
+        return true;
+    }
+};
+
+template <typename T, int Capacity, int KeyCount>
+const typename SlotMap<T, Capacity, KeyCount>::Index SlotMap<T, Capacity, KeyCount>::NO_SLOT;
+
+#endif // __SLOT_MAP_H__
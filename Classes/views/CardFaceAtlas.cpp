@@ -0,0 +1,214 @@
+﻿#include "CardFaceAtlas.h"
+#include "CardView.h"
+#include "../utils/GameUtils.h"
+
+USING_NS_CC;
+
+// 图集配置常量
+const int CardFaceAtlas::ATLAS_COLUMNS = 8;
+const float CardFaceAtlas::CELL_PADDING = 2.0f;
+
+// 静态变量初始化
+RenderTexture* CardFaceAtlas::s_renderTexture = nullptr;
+SpriteFrame* CardFaceAtlas::s_faceFrames[CST_NUM_CARD_SUIT_TYPES][CFT_NUM_CARD_FACE_TYPES] = {};
+SpriteFrame* CardFaceAtlas::s_backFrame = nullptr;
+
+// 烘焙牌面图集
+bool CardFaceAtlas::bake() {
+    if (isBaked()) {
+        return true;
+    }
+
+    // 52张牌面加一张牌背
+    const int cellCount = CST_NUM_CARD_SUIT_TYPES * CFT_NUM_CARD_FACE_TYPES + 1;
+    const int rows = (cellCount + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    const float cellWidth = CardView::CARD_WIDTH + CELL_PADDING * 2;
+    const float cellHeight = CardView::CARD_HEIGHT + CELL_PADDING * 2;
+    const int atlasWidth = static_cast<int>(cellWidth * ATLAS_COLUMNS);
+    const int atlasHeight = static_cast<int>(cellHeight * rows);
+
+    s_renderTexture = RenderTexture::create(atlasWidth, atlasHeight, Texture2D::PixelFormat::RGBA8888);
+    if (!s_renderTexture) {
+        CCLOG("Failed to create card atlas render texture (%d x %d)", atlasWidth, atlasHeight);
+        return false;
+    }
+    s_renderTexture->retain();
+
+    // 按格子摆放所有牌面，记录每格的中心位置
+    auto root = Node::create();
+    Vec2 centers[cellCount];
+    for (int i = 0; i < cellCount; ++i) {
+        int column = i % ATLAS_COLUMNS;
+        int row = i / ATLAS_COLUMNS;
+        centers[i] = Vec2(column * cellWidth + cellWidth / 2, row * cellHeight + cellHeight / 2);
+
+        Node* composite = nullptr;
+        if (i == cellCount - 1) {
+            composite = createBackComposite();
+        } else {
+            composite = createFaceComposite(static_cast<CardSuitType>(i / CFT_NUM_CARD_FACE_TYPES),
+                                            static_cast<CardFaceType>(i % CFT_NUM_CARD_FACE_TYPES));
+        }
+        // 帧缓冲的第一行对应纹理坐标的顶部，绘制时上下翻转使帧内图像保持正向
+        composite->setScaleY(-1.0f);
+        composite->setPosition(centers[i]);
+        root->addChild(composite);
+    }
+
+    s_renderTexture->beginWithClear(0, 0, 0, 0);
+    root->visit();
+    s_renderTexture->end();
+    // 立即执行绘制命令，保证首帧之前图集已就绪
+    Director::getInstance()->getRenderer()->render();
+
+    // 帧缓冲内容是预乘透明度的，精灵需使用预乘混合
+    Texture2D* texture = s_renderTexture->getSprite()->getTexture();
+    for (int i = 0; i < cellCount; ++i) {
+        Rect rect(centers[i].x - CardView::CARD_WIDTH / 2, centers[i].y - CardView::CARD_HEIGHT / 2,
+                  CardView::CARD_WIDTH, CardView::CARD_HEIGHT);
+        auto frame = SpriteFrame::createWithTexture(texture, rect);
+        frame->retain();
+        if (i == cellCount - 1) {
+            s_backFrame = frame;
+        } else {
+            s_faceFrames[i / CFT_NUM_CARD_FACE_TYPES][i % CFT_NUM_CARD_FACE_TYPES] = frame;
+        }
+    }
+
+    CCLOG("Card atlas baked: %d cards in %d x %d texture", cellCount, atlasWidth, atlasHeight);
+    return true;
+}
+
+// 检查图集是否已烘焙
+bool CardFaceAtlas::isBaked() {
+    return s_backFrame != nullptr;
+}
+
+// 释放图集
+void CardFaceAtlas::release() {
+    for (int suit = 0; suit < CST_NUM_CARD_SUIT_TYPES; ++suit) {
+        for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face) {
+            CC_SAFE_RELEASE_NULL(s_faceFrames[suit][face]);
+        }
+    }
+    CC_SAFE_RELEASE_NULL(s_backFrame);
+    CC_SAFE_RELEASE_NULL(s_renderTexture);
+}
+
+// 获取卡牌对应的精灵帧
+SpriteFrame* CardFaceAtlas::getFrame(const CardModel& card) {
+    if (!isBaked() && !bake()) {
+        return nullptr;
+    }
+    if (!card.isFaceUp) {
+        return s_backFrame;
+    }
+    if (card.suit < 0 || card.suit >= CST_NUM_CARD_SUIT_TYPES ||
+        card.face < 0 || card.face >= CFT_NUM_CARD_FACE_TYPES) {
+        return nullptr;
+    }
+    return s_faceFrames[card.suit][card.face];
+}
+
+// 获取牌背精灵帧
+SpriteFrame* CardFaceAtlas::getBackFrame() {
+    if (!isBaked() && !bake()) {
+        return nullptr;
+    }
+    return s_backFrame;
+}
+
+// 合成牌面节点
+Node* CardFaceAtlas::createFaceComposite(CardSuitType suit, CardFaceType face) {
+    auto composite = createBackComposite();
+    const float width = CardView::CARD_WIDTH;
+    const float height = CardView::CARD_HEIGHT;
+
+    // 大数字（卡牌中心）
+    auto bigNumber = Sprite::create(getBigNumberImagePath(suit, face));
+    if (bigNumber) {
+        bigNumber->setPosition(Vec2(0, 0));
+        bigNumber->setScale(0.6f);
+        composite->addChild(bigNumber, 1);
+    }
+
+    // 花色（左上角）
+    std::string suitPath = getSuitImagePath(suit);
+    auto suitSprite = Sprite::create(suitPath);
+    if (suitSprite) {
+        suitSprite->setPosition(Vec2(-width/2 + 20, height/2 - 30));
+        suitSprite->setScale(0.6f);
+        composite->addChild(suitSprite, 1);
+    }
+
+    // 小数字（左上角）
+    auto smallNumber = Sprite::create(getSmallNumberImagePath(suit, face));
+    if (smallNumber) {
+        smallNumber->setPosition(Vec2(-width/2 + 15, height/2 - 15));
+        smallNumber->setScale(0.5f);
+        composite->addChild(smallNumber, 1);
+    }
+
+    // 小花色（右下角，旋转180度）
+    auto smallSuit = Sprite::create(suitPath);
+    if (smallSuit) {
+        smallSuit->setPosition(Vec2(width/2 - 20, -height/2 + 50));
+        smallSuit->setRotation(180);
+        smallSuit->setScale(0.4f);
+        composite->addChild(smallSuit, 1);
+    }
+
+    return composite;
+}
+
+// 创建牌背节点
+Node* CardFaceAtlas::createBackComposite() {
+    auto composite = Node::create();
+    auto background = Sprite::create(GameUtils::getCardBackImageName());
+    if (background) {
+        background->setContentSize(Size(CardView::CARD_WIDTH, CardView::CARD_HEIGHT));
+        background->setColor(Color3B::WHITE);
+        composite->addChild(background, 0);
+    }
+    return composite;
+}
+
+// 获取大数字图片路径
+std::string CardFaceAtlas::getBigNumberImagePath(CardSuitType suit, CardFaceType face) {
+    std::string colorPrefix;
+    if (suit == CST_HEARTS || suit == CST_DIAMONDS) {
+        colorPrefix = "big_red_";
+    } else {
+        colorPrefix = "big_black_";
+    }
+
+    return "res/number/" + colorPrefix + GameUtils::getFaceName(face) + ".png";
+}
+
+// 获取小数字图片路径
+std::string CardFaceAtlas::getSmallNumberImagePath(CardSuitType suit, CardFaceType face) {
+    std::string colorPrefix;
+    if (suit == CST_HEARTS || suit == CST_DIAMONDS) {
+        colorPrefix = "small_red_";
+    } else {
+        colorPrefix = "small_black_";
+    }
+
+    return "res/number/" + colorPrefix + GameUtils::getFaceName(face) + ".png";
+}
+
+// 获取花色图片路径
+std::string CardFaceAtlas::getSuitImagePath(CardSuitType suit) {
+    switch (suit) {
+        case CST_HEARTS:
+            return "res/suits/heart.png";
+        case CST_DIAMONDS:
+            return "res/suits/diamond.png";
+        case CST_CLUBS:
+            return "res/suits/club.png";
+        case CST_SPADES:
+            return "res/suits/spade.png";
+        default:
+            return "res/suits/heart.png";
+    }
+}
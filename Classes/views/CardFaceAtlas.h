@@ -0,0 +1,104 @@
+﻿#ifndef __CARD_FACE_ATLAS_H__
+#define __CARD_FACE_ATLAS_H__
+
+#include "cocos2d.h"
+#include "../models/CardModel.h"
+#include <string>
+
+/**
+ * @class CardFaceAtlas
+ * @brief 卡牌牌面图集
+ *
+ * 启动时将52张牌面（背景、数字、花色合成后的完整牌面）和牌背
+ * 通过RenderTexture烘焙到同一张纹理中，并为每张牌生成对应的SpriteFrame
+ * 所有卡牌都只用一个四边形从同一张纹理绘制，使渲染器能够自动合批
+ *
+ * 职责：
+ * - 合成并烘焙所有牌面到一张图集纹理
+ * - 提供按花色和牌面查找精灵帧的接口
+ * - 持有图集纹理直到被显式释放
+ *
+ * 使用场景：
+ * - AppDelegate在创建首个场景前调用bake()
+ * - CardView绑定卡牌数据时获取对应的精灵帧
+ */
+class CardFaceAtlas {
+public:
+    /**
+     * @brief 烘焙牌面图集
+     *
+     * 需要在OpenGL上下文创建之后调用，重复调用直接返回
+     * @return 烘焙成功返回true，失败返回false
+     */
+    static bool bake();
+
+    /**
+     * @brief 检查图集是否已烘焙
+     */
+    static bool isBaked();
+
+    /**
+     * @brief 释放图集纹理和所有精灵帧
+     */
+    static void release();
+
+    /**
+     * @brief 获取卡牌对应的精灵帧
+     *
+     * 背面朝上的卡牌返回牌背帧；图集尚未烘焙时会先尝试烘焙
+     * @param card 卡牌数据
+     * @return 精灵帧指针，烘焙失败或卡牌数据无效时返回nullptr
+     */
+    static cocos2d::SpriteFrame* getFrame(const CardModel& card);
+
+    /**
+     * @brief 获取牌背精灵帧
+     */
+    static cocos2d::SpriteFrame* getBackFrame();
+
+    static const int ATLAS_COLUMNS;   ///< 图集每行的卡牌数
+    static const float CELL_PADDING;  ///< 图集中卡牌之间的间距，避免采样串色
+
+private:
+    // 私有构造函数，防止实例化
+    CardFaceAtlas() = delete;
+    ~CardFaceAtlas() = delete;
+    CardFaceAtlas(const CardFaceAtlas&) = delete;
+    CardFaceAtlas& operator=(const CardFaceAtlas&) = delete;
+
+    /**
+     * @brief 合成一张完整的牌面节点
+     *
+     * 节点以卡牌中心为原点，布局与原先CardView的多精灵显示一致
+     * @param suit 花色
+     * @param face 牌面
+     * @return 合成的节点
+     */
+    static cocos2d::Node* createFaceComposite(CardSuitType suit, CardFaceType face);
+
+    /**
+     * @brief 创建牌背节点
+     */
+    static cocos2d::Node* createBackComposite();
+
+    /**
+     * @brief 获取大数字图片路径
+     */
+    static std::string getBigNumberImagePath(CardSuitType suit, CardFaceType face);
+
+    /**
+     * @brief 获取小数字图片路径
+     */
+    static std::string getSmallNumberImagePath(CardSuitType suit, CardFaceType face);
+
+    /**
+     * @brief 获取花色图片路径
+     */
+    static std::string getSuitImagePath(CardSuitType suit);
+
+    static cocos2d::RenderTexture* s_renderTexture;  ///< 持有图集纹理的渲染纹理
+    static cocos2d::SpriteFrame* s_faceFrames[CST_NUM_CARD_SUIT_TYPES][CFT_NUM_CARD_FACE_TYPES]; ///< 牌面精灵帧
+    static cocos2d::SpriteFrame* s_backFrame;         ///< 牌背精灵帧
+};
+
+#endif // __CARD_FACE_ATLAS_H__
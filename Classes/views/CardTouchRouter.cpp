@@ -0,0 +1,157 @@
+﻿#include "CardTouchRouter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+USING_NS_CC;
+
+// 构造函数
+HitTestStats::HitTestStats()
+    : queryCount(0), hitCount(0), totalMicroseconds(0.0), maxMicroseconds(0.0), lastMicroseconds(0.0) {
+}
+
+// 获取平均耗时
+double HitTestStats::getAverageMicroseconds() const {
+    return queryCount > 0 ? totalMicroseconds / queryCount : 0.0;
+}
+
+// 构造函数
+CardTouchRouter::CardTouchRouter()
+    : m_origin(Vec2::ZERO), m_cellSize(Size::ZERO), m_columns(0), m_rows(0) {
+    m_cellStart.push_back(0);
+}
+
+// 开始重建索引
+void CardTouchRouter::beginRebuild() {
+    m_areas.clear();
+}
+
+// 登记卡牌区域
+void CardTouchRouter::addCard(int cardId, CardZone zone, const Rect& rect, int zOrder) {
+    CardArea area;
+    area.cardId = cardId;
+    area.zone = zone;
+    area.rect = rect;
+    area.zOrder = zOrder;
+    m_areas.push_back(area);
+}
+
+// 结束重建并生成网格
+void CardTouchRouter::endRebuild() {
+    m_cellStart.assign(1, 0);
+    m_cellEntries.clear();
+    m_columns = 0;
+    m_rows = 0;
+    if (m_areas.empty()) {
+        return;
+    }
+
+    // 网格覆盖所有卡牌的包围盒，格子尺寸取最大的卡牌尺寸，每张卡牌最多落在2x2个格子中
+    float minX = m_areas[0].rect.getMinX();
+    float minY = m_areas[0].rect.getMinY();
+    float maxX = m_areas[0].rect.getMaxX();
+    float maxY = m_areas[0].rect.getMaxY();
+    float cellWidth = 0.0f;
+    float cellHeight = 0.0f;
+    for (const auto& area : m_areas) {
+        minX = std::min(minX, area.rect.getMinX());
+        minY = std::min(minY, area.rect.getMinY());
+        maxX = std::max(maxX, area.rect.getMaxX());
+        maxY = std::max(maxY, area.rect.getMaxY());
+        cellWidth = std::max(cellWidth, area.rect.size.width);
+        cellHeight = std::max(cellHeight, area.rect.size.height);
+    }
+    m_origin = Vec2(minX, minY);
+    m_cellSize = Size(std::max(cellWidth, 1.0f), std::max(cellHeight, 1.0f));
+    m_columns = std::max(1, static_cast<int>(std::ceil((maxX - minX) / m_cellSize.width)));
+    m_rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) / m_cellSize.height)));
+
+    // 第一遍统计每个格子的卡牌数
+    m_cellStart.assign(m_columns * m_rows + 1, 0);
+    for (const auto& area : m_areas) {
+        int x0 = clampCell(area.rect.getMinX(), m_origin.x, m_cellSize.width, m_columns);
+        int x1 = clampCell(area.rect.getMaxX(), m_origin.x, m_cellSize.width, m_columns);
+        int y0 = clampCell(area.rect.getMinY(), m_origin.y, m_cellSize.height, m_rows);
+        int y1 = clampCell(area.rect.getMaxY(), m_origin.y, m_cellSize.height, m_rows);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                m_cellStart[y * m_columns + x + 1]++;
+            }
+        }
+    }
+    for (size_t i = 1; i < m_cellStart.size(); ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    // 第二遍填入卡牌下标
+    m_cellEntries.resize(m_cellStart.back());
+    m_cellFill.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < m_areas.size(); ++i) {
+        const CardArea& area = m_areas[i];
+        int x0 = clampCell(area.rect.getMinX(), m_origin.x, m_cellSize.width, m_columns);
+        int x1 = clampCell(area.rect.getMaxX(), m_origin.x, m_cellSize.width, m_columns);
+        int y0 = clampCell(area.rect.getMinY(), m_origin.y, m_cellSize.height, m_rows);
+        int y1 = clampCell(area.rect.getMaxY(), m_origin.y, m_cellSize.height, m_rows);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                m_cellEntries[m_cellFill[y * m_columns + x]++] = static_cast<int>(i);
+            }
+        }
+    }
+
+    // 格子内按层级从高到低排序，层级相同时后登记的在上
+    for (int cell = 0; cell < m_columns * m_rows; ++cell) {
+        std::sort(m_cellEntries.begin() + m_cellStart[cell], m_cellEntries.begin() + m_cellStart[cell + 1],
+            [this](int a, int b) {
+                if (m_areas[a].zOrder != m_areas[b].zOrder) {
+                    return m_areas[a].zOrder > m_areas[b].zOrder;
+                }
+                return a > b;
+            });
+    }
+}
+
+// 查询最上层卡牌
+bool CardTouchRouter::hitTest(const Vec2& point, CardHit& hit) {
+    auto start = std::chrono::steady_clock::now();
+    bool found = false;
+
+    if (m_columns > 0 && m_rows > 0 &&
+        point.x >= m_origin.x && point.y >= m_origin.y &&
+        point.x <= m_origin.x + m_cellSize.width * m_columns &&
+        point.y <= m_origin.y + m_cellSize.height * m_rows) {
+        int x = clampCell(point.x, m_origin.x, m_cellSize.width, m_columns);
+        int y = clampCell(point.y, m_origin.y, m_cellSize.height, m_rows);
+        int cell = y * m_columns + x;
+        for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+            const CardArea& area = m_areas[m_cellEntries[i]];
+            if (area.rect.containsPoint(point)) {
+                hit.cardId = area.cardId;
+                hit.zone = area.zone;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+    recordQuery(elapsed.count(), found);
+    return found;
+}
+
+// 计算格子坐标
+int CardTouchRouter::clampCell(float value, float origin, float cellSize, int count) {
+    int cell = static_cast<int>(std::floor((value - origin) / cellSize));
+    return std::max(0, std::min(cell, count - 1));
+}
+
+// 记录耗时
+void CardTouchRouter::recordQuery(double microseconds, bool hit) {
+    m_stats.queryCount++;
+    if (hit) {
+        m_stats.hitCount++;
+    }
+    m_stats.totalMicroseconds += microseconds;
+    m_stats.maxMicroseconds = std::max(m_stats.maxMicroseconds, microseconds);
+    m_stats.lastMicroseconds = microseconds;
+}
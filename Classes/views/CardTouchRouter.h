@@ -0,0 +1,146 @@
+﻿#ifndef __CARD_TOUCH_ROUTER_H__
+#define __CARD_TOUCH_ROUTER_H__
+
+#include "cocos2d.h"
+#include <vector>
+
+/**
+ * @enum CardZone
+ * @brief 卡牌所在区域
+ */
+enum CardZone
+{
+    CZ_HAND,        ///< 手牌区
+    CZ_PLAYFIELD    ///< 牌桌区
+};
+
+/**
+ * @struct CardHit
+ * @brief 命中测试结果
+ */
+struct CardHit {
+    int cardId;      ///< 命中的卡牌ID
+    CardZone zone;   ///< 命中卡牌所在区域
+};
+
+/**
+ * @struct HitTestStats
+ * @brief 命中测试耗时统计
+ */
+struct HitTestStats {
+    int queryCount;            ///< 命中测试次数
+    int hitCount;              ///< 命中卡牌的次数
+    double totalMicroseconds;  ///< 累计耗时（微秒）
+    double maxMicroseconds;    ///< 单次最大耗时（微秒）
+    double lastMicroseconds;   ///< 最近一次耗时（微秒）
+
+    /**
+     * @brief 构造函数
+     */
+    HitTestStats();
+
+    /**
+     * @brief 获取平均耗时（微秒）
+     */
+    double getAverageMicroseconds() const;
+};
+
+/**
+ * @class CardTouchRouter
+ * @brief 卡牌触摸路由器
+ *
+ * 用均匀网格对所有卡牌的矩形区域建立空间索引，
+ * 让GameView只用一个触摸监听器就能找到触点下最上层的卡牌，
+ * 取代每张卡牌一个透明按钮（一个监听器）的做法
+ *
+ * 职责：
+ * - 每次卡牌刷新后重建网格索引
+ * - 按层级返回触点下最上层的卡牌
+ * - 统计命中测试的耗时
+ *
+ * 使用场景：
+ * - GameView在卡牌刷新后登记卡牌区域
+ * - GameView的触摸监听器在按下和抬起时查询命中卡牌
+ */
+class CardTouchRouter {
+public:
+    /**
+     * @brief 构造函数
+     */
+    CardTouchRouter();
+
+    /**
+     * @brief 开始重建索引
+     *
+     * 清空已登记的卡牌，保留已分配的内存
+     */
+    void beginRebuild();
+
+    /**
+     * @brief 登记一张卡牌的点击区域
+     *
+     * @param cardId 卡牌ID
+     * @param zone 卡牌所在区域
+     * @param rect 卡牌矩形（GameView坐标系）
+     * @param zOrder 卡牌层级，越大越靠上
+     */
+    void addCard(int cardId, CardZone zone, const cocos2d::Rect& rect, int zOrder);
+
+    /**
+     * @brief 结束重建并生成网格索引
+     */
+    void endRebuild();
+
+    /**
+     * @brief 查询触点下最上层的卡牌
+     *
+     * @param point 触点（GameView坐标系）
+     * @param hit 命中时输出的结果
+     * @return 命中卡牌返回true，否则返回false
+     */
+    bool hitTest(const cocos2d::Vec2& point, CardHit& hit);
+
+    /**
+     * @brief 获取命中测试统计
+     */
+    const HitTestStats& getStats() const { return m_stats; }
+
+    /**
+     * @brief 获取已登记的卡牌数量
+     */
+    size_t getCardCount() const { return m_areas.size(); }
+
+private:
+    /**
+     * @struct CardArea
+     * @brief 已登记的卡牌区域
+     */
+    struct CardArea {
+        int cardId;             ///< 卡牌ID
+        CardZone zone;          ///< 所在区域
+        cocos2d::Rect rect;     ///< 卡牌矩形
+        int zOrder;             ///< 卡牌层级
+    };
+
+    std::vector<CardArea> m_areas;     ///< 所有卡牌区域
+    std::vector<int> m_cellStart;      ///< 每个格子在m_cellEntries中的起始下标，长度为格子数+1
+    std::vector<int> m_cellEntries;    ///< 按格子排列的卡牌区域下标，同一格子内按层级从高到低
+    std::vector<int> m_cellFill;       ///< 重建时的格子填充游标
+    cocos2d::Vec2 m_origin;            ///< 网格左下角
+    cocos2d::Size m_cellSize;          ///< 格子尺寸
+    int m_columns;                     ///< 网格列数
+    int m_rows;                        ///< 网格行数
+    HitTestStats m_stats;              ///< 命中测试统计
+
+    /**
+     * @brief 计算坐标所在的格子列号或行号，并限制在网格范围内
+     */
+    static int clampCell(float value, float origin, float cellSize, int count);
+
+    /**
+     * @brief 记录一次命中测试的耗时
+     */
+    void recordQuery(double microseconds, bool hit);
+};
+
+#endif // __CARD_TOUCH_ROUTER_H__
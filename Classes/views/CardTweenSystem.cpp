@@ -0,0 +1,276 @@
+﻿#include "CardTweenSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+USING_NS_CC;
+
+// 调度回调的键
+static const char* TWEEN_SCHEDULE_KEY = "card_tween_update";
+
+// 各缓动类型的多项式系数：e(t) = t * (c1 + t * (c2 + t * c3))，e(0) = 0，e(1) = 1
+static const float BACK_OVERSHOOT = 1.70158f;
+static const float EASING_COEFFICIENTS[TE_NUM_EASINGS][3] = {
+    { 1.0f, 0.0f, 0.0f },                                                       // TE_LINEAR: t
+    { 0.0f, 1.0f, 0.0f },                                                       // TE_QUAD_IN: t^2
+    { 2.0f, -1.0f, 0.0f },                                                      // TE_QUAD_OUT: 1 - (1 - t)^2
+    { 3.0f, -3.0f, 1.0f },                                                      // TE_CUBIC_OUT: 1 - (1 - t)^3
+    { 0.0f, 3.0f, -2.0f },                                                      // TE_SMOOTHSTEP: 3t^2 - 2t^3
+    { BACK_OVERSHOOT + 3.0f, -(2.0f * BACK_OVERSHOOT + 3.0f), BACK_OVERSHOOT + 1.0f }  // TE_BACK_OUT
+};
+
+// 静态常量定义
+const size_t CardTweenSystem::DEFAULT_CAPACITY;
+
+// 构造函数
+TweenFrameStats::TweenFrameStats()
+    : activeTweens(0), peakActiveTweens(0), lastCompleted(0), frameCount(0)
+    , totalMicroseconds(0.0), maxMicroseconds(0.0), lastMicroseconds(0.0) {
+}
+
+// 获取平均耗时
+double TweenFrameStats::getAverageMicroseconds() const {
+    return frameCount > 0 ? totalMicroseconds / frameCount : 0.0;
+}
+
+// 构造函数
+CardTweenSystem::CardTweenSystem()
+    : m_scheduler(nullptr), m_running(false), m_count(0) {
+}
+
+// 析构函数
+CardTweenSystem::~CardTweenSystem() {
+    if (m_scheduler) {
+        m_scheduler->unschedule(TWEEN_SCHEDULE_KEY, this);
+    }
+    for (size_t i = 0; i < m_count; ++i) {
+        m_nodes[i]->release();
+    }
+}
+
+// 初始化
+void CardTweenSystem::init(Scheduler* scheduler, size_t capacity) {
+    if (m_scheduler) {
+        m_scheduler->unschedule(TWEEN_SCHEDULE_KEY, this);
+    }
+
+    m_scheduler = scheduler;
+    reserve(std::max(capacity, m_count));
+
+    // 回调只登记一次，之后按有无补间暂停和恢复
+    m_running = false;
+    if (m_scheduler) {
+        m_scheduler->schedule([this](float dt) {
+            update(dt);
+        }, this, 0.0f, true, TWEEN_SCHEDULE_KEY);
+    }
+    updateRunning();
+}
+
+// 设置完成回调
+void CardTweenSystem::setCompletionCallback(const CompletionCallback& callback) {
+    m_completionCallback = callback;
+}
+
+// 启动位移补间
+bool CardTweenSystem::moveTo(Node* node, const Vec2& target, float duration, TweenEasing easing,
+                             int cardId, uint8_t flags) {
+    if (!node || easing < 0 || easing >= TE_NUM_EASINGS) {
+        return false;
+    }
+
+    size_t index = findIndex(node);
+    if (index == m_count) {
+        if (m_count == m_nodes.size()) {
+            reserve(m_nodes.empty() ? DEFAULT_CAPACITY : m_nodes.size() * 2);
+        }
+        node->retain();
+        m_nodes[index] = node;
+        m_count++;
+    }
+
+    const Vec2& position = node->getPosition();
+    m_cardIds[index] = cardId;
+    m_flags[index] = flags;
+    m_startX[index] = position.x;
+    m_startY[index] = position.y;
+    m_targetX[index] = target.x;
+    m_targetY[index] = target.y;
+    // 第一次更新不计帧间隔；持续时间为0的补间预置1秒，第一次更新即判定完成
+    m_elapsed[index] = duration > 0.0f ? 0.0f : 1.0f;
+    m_dtScale[index] = 0.0f;
+    m_invDuration[index] = duration > 0.0f ? 1.0f / duration : std::numeric_limits<float>::max();
+    m_c1[index] = EASING_COEFFICIENTS[easing][0];
+    m_c2[index] = EASING_COEFFICIENTS[easing][1];
+    m_c3[index] = EASING_COEFFICIENTS[easing][2];
+
+    updateRunning();
+    return true;
+}
+
+// 取消节点的补间
+bool CardTweenSystem::cancel(Node* node) {
+    size_t index = findIndex(node);
+    if (index == m_count) {
+        return false;
+    }
+
+    Node* removed = m_nodes[index];
+    removeAt(index);
+    removed->release();
+    updateRunning();
+    return true;
+}
+
+// 取消所有补间
+void CardTweenSystem::cancelAll() {
+    for (size_t i = 0; i < m_count; ++i) {
+        m_nodes[i]->release();
+    }
+    m_count = 0;
+    updateRunning();
+}
+
+// 推进所有补间
+void CardTweenSystem::update(float dt) {
+    if (m_count == 0) {
+        updateRunning();
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t count = m_count;
+
+    // 第一遍：推进时间并求缓动值，只读写浮点数组，没有分支
+    float* elapsed = m_elapsed.data();
+    float* dtScale = m_dtScale.data();
+    const float* invDuration = m_invDuration.data();
+    const float* c1 = m_c1.data();
+    const float* c2 = m_c2.data();
+    const float* c3 = m_c3.data();
+    float* eased = m_eased.data();
+    for (size_t i = 0; i < count; ++i) {
+        float e = elapsed[i] + dt * dtScale[i];
+        elapsed[i] = e;
+        dtScale[i] = 1.0f;
+        float t = std::min(e * invDuration[i], 1.0f);
+        eased[i] = t * (c1[i] + t * (c2[i] + t * c3[i]));
+    }
+
+    // 第二遍：写回节点位置，完成的补间直接落到终点；完成与否按第一遍相同的乘积判断
+    for (size_t i = 0; i < count; ++i) {
+        if (elapsed[i] * invDuration[i] >= 1.0f) {
+            m_nodes[i]->setPosition(m_targetX[i], m_targetY[i]);
+        } else {
+            m_nodes[i]->setPosition(m_startX[i] + (m_targetX[i] - m_startX[i]) * eased[i],
+                                    m_startY[i] + (m_targetY[i] - m_startY[i]) * eased[i]);
+        }
+    }
+
+    // 第三遍：倒序收集完成的补间，移除时用末尾的补间填补，不影响尚未检查的下标
+    m_completions.clear();
+    for (size_t i = count; i-- > 0; ) {
+        if (elapsed[i] * invDuration[i] < 1.0f) {
+            continue;
+        }
+        TweenCompletion completion;
+        completion.node = m_nodes[i];
+        completion.cardId = m_cardIds[i];
+        completion.flags = m_flags[i];
+        if (completion.flags & TF_HIDE_ON_COMPLETE) {
+            completion.node->setVisible(false);
+        }
+        m_completions.push_back(completion);
+        removeAt(i);
+    }
+
+    m_stats.lastCompleted = static_cast<int>(m_completions.size());
+    if (!m_completions.empty()) {
+        // 节点在回调结束后才释放，回调中可以安全访问
+        if (m_completionCallback) {
+            m_completionCallback(m_completions.data(), m_completions.size());
+        }
+        for (const TweenCompletion& completion : m_completions) {
+            completion.node->release();
+        }
+        m_completions.clear();
+    }
+
+    auto duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+    double microseconds = duration.count();
+    m_stats.frameCount++;
+    m_stats.totalMicroseconds += microseconds;
+    m_stats.maxMicroseconds = std::max(m_stats.maxMicroseconds, microseconds);
+    m_stats.lastMicroseconds = microseconds;
+
+    updateRunning();
+}
+
+// 查找节点的补间下标
+size_t CardTweenSystem::findIndex(const Node* node) const {
+    for (size_t i = 0; i < m_count; ++i) {
+        if (m_nodes[i] == node) {
+            return i;
+        }
+    }
+    return m_count;
+}
+
+// 调整各数组的容量
+void CardTweenSystem::reserve(size_t capacity) {
+    m_nodes.resize(capacity, nullptr);
+    m_cardIds.resize(capacity);
+    m_flags.resize(capacity);
+    m_startX.resize(capacity);
+    m_startY.resize(capacity);
+    m_targetX.resize(capacity);
+    m_targetY.resize(capacity);
+    m_elapsed.resize(capacity);
+    m_dtScale.resize(capacity);
+    m_invDuration.resize(capacity);
+    m_c1.resize(capacity);
+    m_c2.resize(capacity);
+    m_c3.resize(capacity);
+    m_eased.resize(capacity);
+    m_completions.reserve(capacity);
+}
+
+// 移除补间
+void CardTweenSystem::removeAt(size_t index) {
+    size_t last = m_count - 1;
+    if (index != last) {
+        m_nodes[index] = m_nodes[last];
+        m_cardIds[index] = m_cardIds[last];
+        m_flags[index] = m_flags[last];
+        m_startX[index] = m_startX[last];
+        m_startY[index] = m_startY[last];
+        m_targetX[index] = m_targetX[last];
+        m_targetY[index] = m_targetY[last];
+        m_elapsed[index] = m_elapsed[last];
+        m_dtScale[index] = m_dtScale[last];
+        m_invDuration[index] = m_invDuration[last];
+        m_c1[index] = m_c1[last];
+        m_c2[index] = m_c2[last];
+        m_c3[index] = m_c3[last];
+        m_eased[index] = m_eased[last];
+    }
+    m_nodes[last] = nullptr;
+    m_count = last;
+}
+
+// 按是否有补间暂停或恢复调度回调
+void CardTweenSystem::updateRunning() {
+    m_stats.activeTweens = static_cast<int>(m_count);
+    m_stats.peakActiveTweens = std::max(m_stats.peakActiveTweens, m_stats.activeTweens);
+
+    bool running = m_count > 0;
+    if (!m_scheduler || running == m_running) {
+        return;
+    }
+    if (running) {
+        m_scheduler->resumeTarget(this);
+    } else {
+        m_scheduler->pauseTarget(this);
+    }
+    m_running = running;
+}
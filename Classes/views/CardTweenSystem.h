@@ -0,0 +1,231 @@
+﻿#ifndef __CARD_TWEEN_SYSTEM_H__
+#define __CARD_TWEEN_SYSTEM_H__
+
+#include "cocos2d.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @enum TweenEasing
+ * @brief 补间缓动类型
+ *
+ * 每种缓动都是过原点的三次多项式e(t) = t * (c1 + t * (c2 + t * c3))，
+ * 更新时所有补间用同一个无分支的公式求值
+ */
+enum TweenEasing
+{
+    TE_LINEAR,              ///< 匀速
+    TE_QUAD_IN,             ///< 二次缓入
+    TE_QUAD_OUT,            ///< 二次缓出
+    TE_CUBIC_OUT,           ///< 三次缓出
+    TE_SMOOTHSTEP,          ///< 三次缓入缓出
+    TE_BACK_OUT,            ///< 越过终点再回弹，与EaseBackOut相同
+    TE_NUM_EASINGS          ///< 缓动类型数量
+};
+
+/**
+ * @enum TweenFlag
+ * @brief 补间完成时的附加处理
+ */
+enum TweenFlag
+{
+    TF_NONE = 0,                    ///< 无附加处理
+    TF_HIDE_ON_COMPLETE = 1 << 0    ///< 完成时隐藏节点
+};
+
+/**
+ * @struct TweenCompletion
+ * @brief 一个已完成的补间
+ */
+struct TweenCompletion {
+    cocos2d::Node* node;    ///< 被移动的节点，回调期间有效
+    int cardId;             ///< 启动补间时给出的卡牌ID
+    uint8_t flags;          ///< 启动补间时给出的标志（TweenFlag）
+};
+
+/**
+ * @struct TweenFrameStats
+ * @brief 补间更新的耗时统计
+ */
+struct TweenFrameStats {
+    int activeTweens;           ///< 当前进行中的补间数
+    int peakActiveTweens;       ///< 同时进行的补间数峰值
+    int lastCompleted;          ///< 最近一帧完成的补间数
+    int frameCount;             ///< 有补间进行的帧数
+    double totalMicroseconds;   ///< 累计更新耗时（微秒）
+    double maxMicroseconds;     ///< 单帧最大更新耗时（微秒）
+    double lastMicroseconds;    ///< 最近一帧的更新耗时（微秒）
+
+    /**
+     * @brief 构造函数
+     */
+    TweenFrameStats();
+
+    /**
+     * @brief 获取每帧平均更新耗时（微秒）
+     */
+    double getAverageMicroseconds() const;
+};
+
+/**
+ * @class CardTweenSystem
+ * @brief 卡牌位移补间系统
+ *
+ * 取代每次移动都新建MoveTo、EaseOut、Sequence和CallFunc的做法：
+ * 进行中的补间以结构数组保存在预分配的连续缓冲区中，由调度器中的一个回调统一推进
+ * 每帧先对全部补间计算进度和缓动值（纯浮点数组上的无分支循环，编译器可向量化），
+ * 再写回节点位置，最后把本帧完成的补间一次性交给完成回调
+ *
+ * 启动补间不分配内存（超过容量时按倍数扩容），补间期间节点被retain，完成或取消时释放
+ * 没有补间时调度回调处于暂停状态，静止的牌桌不占用每帧的更新
+ *
+ * 职责：
+ * - 启动、替换和取消节点的位移补间
+ * - 每帧推进全部补间并批量分发完成事件
+ * - 统计进行中的补间数和每帧更新耗时
+ *
+ * 使用场景：
+ * - GameView持有一个实例，刷新器在动画刷新时经它把卡牌移向新的布局位置
+ * - CardViewReconciler在直接摆放、移交或回收节点时取消其补间
+ */
+class CardTweenSystem {
+public:
+    /**
+     * 完成回调：参数为本帧完成的补间数组及其长度
+     */
+    typedef std::function<void(const TweenCompletion* completions, size_t count)> CompletionCallback;
+
+    static const size_t DEFAULT_CAPACITY = 128;    ///< 默认预分配的补间数
+
+    /**
+     * @brief 构造函数
+     */
+    CardTweenSystem();
+
+    /**
+     * @brief 析构函数
+     *
+     * 取消调度回调并释放所有补间持有的节点
+     */
+    ~CardTweenSystem();
+
+    /**
+     * @brief 初始化补间系统
+     *
+     * 在调度器中登记一个暂停状态的更新回调，并预分配缓冲区
+     * @param scheduler 调度器
+     * @param capacity 预分配的补间数
+     */
+    void init(cocos2d::Scheduler* scheduler, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief 设置完成回调
+     *
+     * 每帧最多调用一次，回调中可以启动新的补间
+     * @param callback 完成回调，可为空
+     */
+    void setCompletionCallback(const CompletionCallback& callback);
+
+    /**
+     * @brief 把节点从当前位置移动到目标位置
+     *
+     * 节点已有补间时从其当前位置重新开始，原补间不触发完成回调
+     * 与ActionInterval相同，补间从启动后的第一次更新开始计时，不计入启动前的帧间隔，
+     * 否则按需渲染时空闲等待后的第一帧会让补间直接跳到终点
+     * @param node 要移动的节点
+     * @param target 目标位置（父节点坐标系）
+     * @param duration 持续时间（秒），小于等于0时在下一帧到达
+     * @param easing 缓动类型
+     * @param cardId 卡牌ID，原样交给完成回调
+     * @param flags 完成时的附加处理（TweenFlag的组合）
+     * @return 启动成功返回true
+     */
+    bool moveTo(cocos2d::Node* node, const cocos2d::Vec2& target, float duration, TweenEasing easing,
+                int cardId = -1, uint8_t flags = TF_NONE);
+
+    /**
+     * @brief 取消节点的补间，节点停在当前位置，不触发完成回调
+     *
+     * @return 节点有补间时返回true
+     */
+    bool cancel(cocos2d::Node* node);
+
+    /**
+     * @brief 取消所有补间
+     */
+    void cancelAll();
+
+    /**
+     * @brief 检查节点是否有进行中的补间
+     */
+    bool isTweening(const cocos2d::Node* node) const { return findIndex(node) < m_count; }
+
+    /**
+     * @brief 获取进行中的补间数
+     */
+    size_t getActiveCount() const { return m_count; }
+
+    /**
+     * @brief 获取更新耗时统计
+     */
+    const TweenFrameStats& getStats() const { return m_stats; }
+
+    /**
+     * @brief 推进所有补间，由调度回调每帧调用
+     *
+     * @param dt 距上一帧的秒数
+     */
+    void update(float dt);
+
+private:
+    CardTweenSystem(const CardTweenSystem&) = delete;
+    CardTweenSystem& operator=(const CardTweenSystem&) = delete;
+
+    cocos2d::Scheduler* m_scheduler;            ///< 调度器
+    bool m_running;                             ///< 调度回调是否处于运行状态
+    size_t m_count;                             ///< 进行中的补间数，各数组的前m_count个元素有效
+
+    // 补间数据按字段分开存放，长度即容量
+    std::vector<cocos2d::Node*> m_nodes;        ///< 节点
+    std::vector<int> m_cardIds;                 ///< 卡牌ID
+    std::vector<uint8_t> m_flags;               ///< 完成标志
+    std::vector<float> m_startX;                ///< 起点X
+    std::vector<float> m_startY;                ///< 起点Y
+    std::vector<float> m_targetX;               ///< 终点X
+    std::vector<float> m_targetY;               ///< 终点Y
+    std::vector<float> m_elapsed;               ///< 已经过的秒数
+    std::vector<float> m_dtScale;               ///< 帧间隔的系数，启动后的第一帧为0，之后为1
+    std::vector<float> m_invDuration;           ///< 持续时间的倒数
+    std::vector<float> m_c1;                    ///< 缓动多项式一次项系数
+    std::vector<float> m_c2;                    ///< 缓动多项式二次项系数
+    std::vector<float> m_c3;                    ///< 缓动多项式三次项系数
+    std::vector<float> m_eased;                 ///< 本帧的缓动值，更新时的临时数据
+    std::vector<TweenCompletion> m_completions; ///< 本帧完成的补间，更新时的临时数据
+
+    CompletionCallback m_completionCallback;    ///< 完成回调
+    TweenFrameStats m_stats;                    ///< 更新耗时统计
+
+    /**
+     * @brief 查找节点的补间下标，没有时返回m_count
+     */
+    size_t findIndex(const cocos2d::Node* node) const;
+
+    /**
+     * @brief 调整各数组的容量
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * @brief 以最后一个补间填补被移除的补间，节点由调用方释放
+     */
+    void removeAt(size_t index);
+
+    /**
+     * @brief 按是否有补间暂停或恢复调度回调
+     */
+    void updateRunning();
+};
+
+#endif // __CARD_TWEEN_SYSTEM_H__
@@ -11,10 +11,11 @@
  * 负责单张卡牌的可视化显示
  * 继承自cocos2d::Node，提供完整的卡牌渲染功能
  * 支持正面和背面的显示切换
+ * 每张卡牌只用一个精灵绘制CardFaceAtlas中烘焙好的整张牌面
  * 
  * 职责：
  * - 渲染卡牌的视觉外观
- * - 管理卡牌的各个视觉元素（数字、花色、背景等）
+ * - 从牌面图集中选取对应的精灵帧
  * - 提供卡牌状态更新接口
  * - 维护卡牌的尺寸规范
  * 
@@ -48,6 +49,14 @@ public:
      */
     void updateCard(const CardModel& card);
     
+    /**
+     * @brief 将卡牌视图重新绑定到新的卡牌数据
+     * 
+     * 只切换精灵帧，不重新创建子节点，供对象池复用
+     * @param card 新的卡牌数据模型
+     */
+    void bindCard(const CardModel& card);
+    
     /**
      * @brief 获取卡牌数据模型
      * 
@@ -59,50 +68,8 @@ public:
     static const float CARD_HEIGHT;  ///< 卡牌标准高度
     
 private:
-    CardModel m_cardModel;                  ///< 卡牌数据模型
-    cocos2d::Sprite* m_backgroundSprite;    ///< 卡牌背景精灵
-    cocos2d::Sprite* m_bigNumberSprite;     ///< 大数字精灵
-    cocos2d::Sprite* m_smallNumberSprite;   ///< 小数字精灵
-    cocos2d::Sprite* m_suitSprite;          ///< 花色精灵
-    cocos2d::Sprite* m_smallSuitSprite;     ///< 小花色精灵
-    
-    /**
-     * @brief 创建卡牌正面显示
-     * 
-     * 创建并布局卡牌正面的所有视觉元素
-     */
-    void createCardDisplay();
-    
-    /**
-     * @brief 创建卡牌背面显示
-     * 
-     * 创建卡牌背面的视觉元素
-     */
-    void createCardBack();
-    
-    /**
-     * @brief 获取大数字图片路径
-     * 
-     * @param card 卡牌数据模型
-     * @return 大数字图片的资源路径
-     */
-    std::string getBigNumberImagePath(const CardModel& card);
-    
-    /**
-     * @brief 获取小数字图片路径
-     * 
-     * @param card 卡牌数据模型
-     * @return 小数字图片的资源路径
-     */
-    std::string getSmallNumberImagePath(const CardModel& card);
-    
-    /**
-     * @brief 获取花色图片路径
-     * 
-     * @param card 卡牌数据模型
-     * @return 花色图片的资源路径
-     */
-    std::string getSuitImagePath(const CardModel& card);
+    CardModel m_cardModel;           ///< 卡牌数据模型
+    cocos2d::Sprite* m_cardSprite;   ///< 卡牌精灵，显示图集中的整张牌面
 };
 
 #endif // __CARD_VIEW_H__
\ No newline at end of file
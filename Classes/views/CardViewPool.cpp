@@ -0,0 +1,82 @@
+﻿#include "CardViewPool.h"
+#include "CardView.h"
+
+USING_NS_CC;
+
+// 构造函数
+CardViewPool::CardViewPool()
+    : m_inUseCount(0), m_createdCount(0), m_missCount(0) {
+}
+
+// 析构函数
+CardViewPool::~CardViewPool() {
+    purge();
+}
+
+// 预热对象池
+void CardViewPool::prewarm(size_t count) {
+    CardModel placeholder;
+    m_freeViews.reserve(count);
+    while (m_freeViews.size() + m_inUseCount < count) {
+        auto view = createView(placeholder);
+        if (!view) {
+            break;
+        }
+        m_freeViews.pushBack(view);
+    }
+}
+
+// 取出卡牌视图
+CardView* CardViewPool::acquire(const CardModel& card) {
+    CardView* view = nullptr;
+    if (!m_freeViews.empty()) {
+        // 先retain再出列，避免视图在出列时被释放
+        view = m_freeViews.back();
+        view->retain();
+        m_freeViews.popBack();
+        view->bindCard(card);
+    } else {
+        view = createView(card);
+        if (!view) {
+            return nullptr;
+        }
+        view->retain();
+        m_missCount++;
+    }
+
+    // 恢复可能被动画修改过的显示状态
+    view->setVisible(true);
+    view->setScale(1.0f);
+    view->setOpacity(255);
+    m_inUseCount++;
+    return view;
+}
+
+// 归还卡牌视图
+void CardViewPool::release(CardView* view) {
+    if (!view) {
+        return;
+    }
+
+    view->stopAllActions();
+    view->removeFromParent();
+    m_freeViews.pushBack(view);
+    view->release();
+    if (m_inUseCount > 0) {
+        m_inUseCount--;
+    }
+}
+
+// 释放空闲视图
+void CardViewPool::purge() {
+    m_freeViews.clear();
+}
+
+// 创建卡牌视图
+CardView* CardViewPool::createView(const CardModel& card) {
+    auto view = CardView::create(card);
+    if (view) {
+        m_createdCount++;
+    }
+    return view;
+}
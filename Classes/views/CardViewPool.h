@@ -0,0 +1,102 @@
+﻿#ifndef __CARD_VIEW_POOL_H__
+#define __CARD_VIEW_POOL_H__
+
+#include "cocos2d.h"
+#include "../models/CardModel.h"
+
+class CardView;
+
+/**
+ * @class CardViewPool
+ * @brief 卡牌视图对象池
+ *
+ * 缓存可复用的CardView实例，取出时通过CardView::bindCard原地切换纹理，
+ * 归还时只从父节点摘下，避免游戏过程中反复创建和销毁节点
+ *
+ * 职责：
+ * - 按关卡卡牌数量预先创建卡牌视图
+ * - 分配与回收卡牌视图
+ * - 统计池命中和额外创建的次数
+ *
+ * 使用场景：
+ * - GameView持有一个实例，供手牌区和牌桌区的刷新器共用
+ * - 关卡加载完成后按卡牌总数预热
+ */
+class CardViewPool {
+public:
+    /**
+     * @brief 构造函数
+     */
+    CardViewPool();
+
+    /**
+     * @brief 析构函数
+     *
+     * 释放池中所有空闲的卡牌视图
+     */
+    ~CardViewPool();
+
+    /**
+     * @brief 预热对象池
+     *
+     * 创建卡牌视图直到池中管理的总数（空闲加使用中）不少于指定数量
+     * @param count 期望的卡牌视图总数
+     */
+    void prewarm(size_t count);
+
+    /**
+     * @brief 取出一个卡牌视图并绑定卡牌数据
+     *
+     * 池为空时会创建新的视图。返回的视图已被retain一次，
+     * 调用方负责通过release(CardView*)归还
+     * @param card 要绑定的卡牌数据
+     * @return 卡牌视图指针，创建失败返回nullptr
+     */
+    CardView* acquire(const CardModel& card);
+
+    /**
+     * @brief 归还卡牌视图
+     *
+     * 将视图从父节点摘下并放回空闲列表，同时释放调用方持有的引用
+     * @param view 要归还的卡牌视图
+     */
+    void release(CardView* view);
+
+    /**
+     * @brief 释放所有空闲的卡牌视图
+     */
+    void purge();
+
+    /**
+     * @brief 获取空闲视图数量
+     */
+    size_t getFreeCount() const { return m_freeViews.size(); }
+
+    /**
+     * @brief 获取使用中的视图数量
+     */
+    size_t getInUseCount() const { return m_inUseCount; }
+
+    /**
+     * @brief 获取池累计创建的视图数量（含预热）
+     */
+    int getCreatedCount() const { return m_createdCount; }
+
+    /**
+     * @brief 获取因池为空而额外创建的视图数量
+     */
+    int getMissCount() const { return m_missCount; }
+
+private:
+    cocos2d::Vector<CardView*> m_freeViews;  ///< 空闲的卡牌视图
+    size_t m_inUseCount;                     ///< 已取出尚未归还的视图数量
+    int m_createdCount;                      ///< 累计创建的视图数量
+    int m_missCount;                         ///< 池为空时额外创建的次数
+
+    /**
+     * @brief 创建一个新的卡牌视图
+     */
+    CardView* createView(const CardModel& card);
+};
+
+#endif // __CARD_VIEW_POOL_H__
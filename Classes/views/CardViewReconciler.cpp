@@ -0,0 +1,241 @@
+﻿#include "CardViewReconciler.h"
+#include "CardView.h"
+#include "CardViewPool.h"
+#include "CardTweenSystem.h"
+
+USING_NS_CC;
+
+// 构造函数
+CardRefreshStats::CardRefreshStats()
+    : nodesCreated(0), nodesDestroyed(0), nodesMoved(0), nodesUpdated(0), nodesKept(0) {
+}
+
+// 清零统计
+void CardRefreshStats::reset() {
+    nodesCreated = 0;
+    nodesDestroyed = 0;
+    nodesMoved = 0;
+    nodesUpdated = 0;
+    nodesKept = 0;
+}
+
+// 累加统计
+CardRefreshStats& CardRefreshStats::operator+=(const CardRefreshStats& other) {
+    nodesCreated += other.nodesCreated;
+    nodesDestroyed += other.nodesDestroyed;
+    nodesMoved += other.nodesMoved;
+    nodesUpdated += other.nodesUpdated;
+    nodesKept += other.nodesKept;
+    return *this;
+}
+
+// 构造函数
+CardViewReconciler::CardViewReconciler()
+    : m_container(nullptr), m_pool(nullptr), m_tweens(nullptr), m_mark(0) {
+}
+
+// 析构函数
+CardViewReconciler::~CardViewReconciler() {
+    clear();
+}
+
+// 初始化
+void CardViewReconciler::init(Node* container) {
+    clear();
+    m_container = container;
+}
+
+// 差量刷新
+const CardRefreshStats& CardViewReconciler::reconcile(const std::vector<CardModel>& cards, const LayoutFunc& layout,
+                                                      bool animate) {
+    m_lastStats.reset();
+    if (!m_container) {
+        return m_lastStats;
+    }
+
+    ++m_mark;
+
+    for (size_t i = 0; i < cards.size(); ++i) {
+        const CardModel& card = cards[i];
+        Vec2 position = layout ? layout(i, card) : Vec2(card.position.x, card.position.y);
+        // 后面的卡牌在上层
+        int zOrder = static_cast<int>(i);
+
+        auto it = m_entries.find(card.id);
+        if (it == m_entries.end()) {
+            CardNodeEntry entry;
+            if (createEntry(card, position, zOrder, entry)) {
+                entry.mark = m_mark;
+                m_entries.emplace(card.id, entry);
+                m_lastStats.nodesCreated++;
+            }
+            continue;
+        }
+
+        CardNodeEntry& entry = it->second;
+        entry.mark = m_mark;
+        bool changed = false;
+
+        if (!isSameFace(entry.view->getCardModel(), card)) {
+            entry.view->updateCard(card);
+            m_lastStats.nodesUpdated++;
+            changed = true;
+        }
+
+        // 目标不变的飞行中节点继续原来的补间；非动画刷新要求节点已在目标上
+        bool retarget = entry.transferred || !entry.target.equals(position) ||
+                        (!animate && !entry.view->getPosition().equals(position));
+        if (retarget) {
+            entry.target = position;
+            moveEntry(card.id, entry, animate);
+        }
+        if (retarget || entry.view->getLocalZOrder() != zOrder) {
+            entry.view->setLocalZOrder(zOrder);
+            m_lastStats.nodesMoved++;
+            changed = true;
+        }
+
+        if (!changed) {
+            m_lastStats.nodesKept++;
+        }
+    }
+
+    // 移除本次列表中已不存在的卡牌
+    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+        if (it->second.mark != m_mark) {
+            destroyEntry(it->second);
+            it = m_entries.erase(it);
+            m_lastStats.nodesDestroyed++;
+        } else {
+            ++it;
+        }
+    }
+
+    m_totalStats += m_lastStats;
+    return m_lastStats;
+}
+
+// 根据ID查找卡牌视图
+CardView* CardViewReconciler::findCardView(int cardId) const {
+    auto it = m_entries.find(cardId);
+    if (it == m_entries.end()) {
+        return nullptr;
+    }
+    return it->second.view;
+}
+
+// 交出卡牌节点
+CardView* CardViewReconciler::detach(int cardId) {
+    auto it = m_entries.find(cardId);
+    if (it == m_entries.end()) {
+        return nullptr;
+    }
+    CardView* view = it->second.view;
+    m_entries.erase(it);
+    return view;
+}
+
+// 接收移交的节点
+bool CardViewReconciler::adopt(int cardId, CardView* view) {
+    if (!view || !m_container || m_entries.count(cardId) > 0) {
+        return false;
+    }
+
+    // 原补间的起点和终点属于旧容器的坐标系
+    if (m_tweens) {
+        m_tweens->cancel(view);
+    }
+
+    // 保持屏幕位置不变地换到本容器；不做清理，节点上的其他动作继续进行
+    Vec2 position = view->getPosition();
+    Node* parent = view->getParent();
+    if (parent != m_container) {
+        if (parent) {
+            position = m_container->convertToNodeSpace(parent->convertToWorldSpace(position));
+            view->removeFromParentAndCleanup(false);
+        }
+        view->setPosition(position);
+        m_container->addChild(view, view->getLocalZOrder());
+    }
+
+    CardNodeEntry entry;
+    entry.view = view;
+    entry.target = position;
+    entry.mark = 0;
+    entry.transferred = true;
+    m_entries.emplace(cardId, entry);
+    return true;
+}
+
+// 移除所有卡牌节点
+void CardViewReconciler::clear() {
+    for (auto& pair : m_entries) {
+        destroyEntry(pair.second);
+    }
+    m_entries.clear();
+}
+
+// 创建卡牌节点
+bool CardViewReconciler::createEntry(const CardModel& card, const Vec2& position, int zOrder, CardNodeEntry& entry) {
+    // 取出的视图已被retain，保证映射中的指针在外部移除节点后依然有效
+    CardView* cardView = nullptr;
+    if (m_pool) {
+        cardView = m_pool->acquire(card);
+    } else {
+        cardView = CardView::create(card);
+        CC_SAFE_RETAIN(cardView);
+    }
+    if (!cardView) {
+        return false;
+    }
+    cardView->setPosition(position);
+    cardView->setTag(card.id);
+    m_container->addChild(cardView, zOrder);
+
+    entry.view = cardView;
+    entry.target = position;
+    entry.mark = 0;
+    entry.transferred = false;
+    return true;
+}
+
+// 把节点移向目标位置
+void CardViewReconciler::moveEntry(int cardId, CardNodeEntry& entry, bool animate) {
+    bool transferred = entry.transferred;
+    entry.transferred = false;
+
+    const Vec2& from = entry.view->getPosition();
+    if (animate && m_tweens && m_durationFunc && !from.equals(entry.target)) {
+        // 飞行中的节点从当前位置重新出发，不会跳回起点
+        float duration = m_durationFunc(cardId, from, entry.target, transferred);
+        if (m_tweens->moveTo(entry.view, entry.target, duration, TE_QUAD_OUT, cardId)) {
+            return;
+        }
+    }
+
+    if (m_tweens) {
+        m_tweens->cancel(entry.view);
+    }
+    entry.view->setPosition(entry.target);
+}
+
+// 销毁卡牌节点
+void CardViewReconciler::destroyEntry(CardNodeEntry& entry) {
+    if (entry.view) {
+        if (m_tweens) {
+            m_tweens->cancel(entry.view);
+        }
+        if (m_pool) {
+            m_pool->release(entry.view);
+        } else {
+            entry.view->removeFromParent();
+            entry.view->release();
+        }
+        entry.view = nullptr;
+    }
+}
+
+// 判断显示内容是否相同
+bool CardViewReconciler::isSameFace(const CardModel& a, const CardModel& b) {
+    return a.face == b.face && a.suit == b.suit && a.isFaceUp == b.isFaceUp;
+}
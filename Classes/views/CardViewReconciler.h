@@ -0,0 +1,252 @@
+﻿#ifndef __CARD_VIEW_RECONCILER_H__
+#define __CARD_VIEW_RECONCILER_H__
+
+#include "cocos2d.h"
+#include "../models/CardModel.h"
+#include <unordered_map>
+#include <vector>
+#include <functional>
+
+class CardView;
+class CardViewPool;
+class CardTweenSystem;
+
+/**
+ * @struct CardRefreshStats
+ * @brief 卡牌刷新统计结构体
+ *
+ * 记录一次（或累计多次）卡牌视图刷新中节点的增删改情况
+ */
+struct CardRefreshStats {
+    int nodesCreated;    ///< 新建的卡牌节点数
+    int nodesDestroyed;  ///< 销毁的卡牌节点数
+    int nodesMoved;      ///< 位置或层级发生变化的卡牌节点数
+    int nodesUpdated;    ///< 牌面内容发生变化的卡牌节点数
+    int nodesKept;       ///< 未做任何修改而保留的卡牌节点数
+
+    /**
+     * @brief 构造函数
+     *
+     * 所有计数初始化为0
+     */
+    CardRefreshStats();
+
+    /**
+     * @brief 清零所有计数
+     */
+    void reset();
+
+    /**
+     * @brief 累加另一份统计
+     *
+     * @param other 要累加的统计
+     * @return 返回当前对象的引用
+     */
+    CardRefreshStats& operator+=(const CardRefreshStats& other);
+};
+
+/**
+ * @class CardViewReconciler
+ * @brief 卡牌视图差量刷新器
+ *
+ * 维护卡牌ID到卡牌节点的映射，将新的卡牌列表与屏幕上已有的节点做差量比较，
+ * 只新增、移除、移动或更新发生变化的节点，避免每次点击都重建所有卡牌
+ *
+ * 每个节点记下布局给出的目标位置；动画刷新时移动的节点经补间系统飞向新目标，
+ * 飞行中再次刷新只在目标改变时从当前位置重新出发，视图总是收敛到最新的模型状态
+ * 换区的卡牌通过detach和adopt把节点交给另一个刷新器，飞行不会因换区而中断
+ *
+ * 职责：
+ * - 管理一个容器节点下所有卡牌节点的生命周期
+ * - 根据卡牌列表增量地同步节点的位置、层级和牌面
+ * - 统计每次刷新中节点的新建与销毁数量
+ * - 通过CardViewPool复用卡牌视图
+ * - 在刷新器之间移交换区卡牌的节点
+ *
+ * 使用场景：
+ * - GameView中手牌区和牌桌区各持有一个实例
+ * - 动画等需要按卡牌ID查找节点时
+ */
+class CardViewReconciler {
+public:
+    /**
+     * 布局函数：根据卡牌在列表中的下标和卡牌数据计算节点位置
+     */
+    typedef std::function<cocos2d::Vec2(size_t index, const CardModel& card)> LayoutFunc;
+
+    /**
+     * 移动时长函数：根据卡牌ID、起点、终点和是否刚从其他区域移交计算补间秒数
+     */
+    typedef std::function<float(int cardId, const cocos2d::Vec2& from, const cocos2d::Vec2& to,
+                                bool transferred)> DurationFunc;
+
+    /**
+     * @brief 构造函数
+     */
+    CardViewReconciler();
+
+    /**
+     * @brief 析构函数
+     *
+     * 释放对所有卡牌节点的持有
+     */
+    ~CardViewReconciler();
+
+    /**
+     * @brief 初始化刷新器
+     *
+     * @param container 卡牌节点所在的容器节点
+     */
+    void init(cocos2d::Node* container);
+
+    /**
+     * @brief 设置卡牌视图对象池
+     *
+     * 设置后卡牌视图从池中取出并在移除时归还；未设置时直接创建和销毁
+     * @param pool 对象池指针，生命周期需长于刷新器
+     */
+    void setCardViewPool(CardViewPool* pool) { m_pool = pool; }
+
+    /**
+     * @brief 设置卡牌补间系统
+     *
+     * 设置后直接摆放或回收节点时先取消其补间，以免补间继续改写位置
+     * @param tweens 补间系统指针，生命周期需长于刷新器
+     */
+    void setTweenSystem(CardTweenSystem* tweens) { m_tweens = tweens; }
+
+    /**
+     * @brief 设置动画刷新时的移动时长函数
+     *
+     * @param durationFunc 移动时长函数，为空时动画刷新也直接摆放
+     */
+    void setDurationFunc(const DurationFunc& durationFunc) { m_durationFunc = durationFunc; }
+
+    /**
+     * @brief 按卡牌列表差量刷新节点
+     *
+     * 列表中靠后的卡牌显示在上层；新建的节点总是直接放到目标位置
+     * @param cards 最新的卡牌列表
+     * @param layout 布局函数
+     * @param animate 为true时目标改变的节点以补间移动，否则直接摆放并取消其补间
+     * @return 本次刷新的统计
+     */
+    const CardRefreshStats& reconcile(const std::vector<CardModel>& cards, const LayoutFunc& layout,
+                                      bool animate = false);
+
+    /**
+     * @brief 根据卡牌ID查找卡牌视图
+     *
+     * @param cardId 卡牌ID
+     * @return 找到返回卡牌视图指针，否则返回nullptr
+     */
+    CardView* findCardView(int cardId) const;
+
+    /**
+     * @brief 交出卡牌的节点
+     *
+     * 节点留在原容器中并保持对它的持有，调用方须随后把它交给另一个刷新器的adopt
+     * @param cardId 卡牌ID
+     * @return 卡牌视图，没有该卡牌时返回nullptr
+     */
+    CardView* detach(int cardId);
+
+    /**
+     * @brief 接收另一个刷新器交出的节点
+     *
+     * 节点移入本容器并保持屏幕位置不变，原有补间被取消，下一次reconcile时从当前位置移向目标
+     * @param cardId 卡牌ID
+     * @param view detach返回的卡牌视图
+     * @return 接收成功返回true；本刷新器已有该卡牌时返回false，节点仍归调用方
+     */
+    bool adopt(int cardId, CardView* view);
+
+    /**
+     * @brief 移除所有卡牌节点
+     *
+     * 卡牌视图归还对象池
+     */
+    void clear();
+
+    /**
+     * @brief 遍历所有卡牌视图
+     *
+     * @param visitor 访问函数，参数为卡牌ID、卡牌视图和布局给出的目标位置（节点飞行中时与当前位置不同）
+     */
+    template <typename Visitor>
+    void forEachCardView(Visitor visitor) const {
+        for (const auto& pair : m_entries) {
+            visitor(pair.first, pair.second.view, pair.second.target);
+        }
+    }
+
+    /**
+     * @brief 获取最近一次刷新的统计
+     */
+    const CardRefreshStats& getLastStats() const { return m_lastStats; }
+
+    /**
+     * @brief 获取自创建以来的累计统计
+     */
+    const CardRefreshStats& getTotalStats() const { return m_totalStats; }
+
+    /**
+     * @brief 获取当前管理的卡牌节点数量
+     */
+    size_t getCardCount() const { return m_entries.size(); }
+
+private:
+    /**
+     * @struct CardNodeEntry
+     * @brief 单张卡牌对应的节点记录
+     */
+    struct CardNodeEntry {
+        CardView* view;                  ///< 卡牌视图
+        cocos2d::Vec2 target;            ///< 布局给出的目标位置
+        unsigned int mark;               ///< 最近一次被刷新命中的标记
+        bool transferred;                ///< 是否刚从其他刷新器移交，尚未经过刷新
+    };
+
+    cocos2d::Node* m_container;                                    ///< 卡牌节点所在容器
+    CardViewPool* m_pool;                                          ///< 卡牌视图对象池，可为空
+    CardTweenSystem* m_tweens;                                     ///< 卡牌补间系统，可为空
+    DurationFunc m_durationFunc;                                   ///< 动画刷新时的移动时长函数
+    std::unordered_map<int, CardNodeEntry> m_entries;              ///< 卡牌ID到节点记录的映射
+    unsigned int m_mark;                                           ///< 当前刷新标记，用于找出失效节点
+    CardRefreshStats m_lastStats;                                  ///< 最近一次刷新统计
+    CardRefreshStats m_totalStats;                                 ///< 累计刷新统计
+
+    /**
+     * @brief 为卡牌创建节点并加入容器
+     *
+     * @param card 卡牌数据
+     * @param position 节点位置
+     * @param zOrder 卡牌层级
+     * @param entry 输出的节点记录
+     * @return 创建成功返回true
+     */
+    bool createEntry(const CardModel& card, const cocos2d::Vec2& position, int zOrder, CardNodeEntry& entry);
+
+    /**
+     * @brief 把节点移向目标位置
+     *
+     * @param cardId 卡牌ID
+     * @param entry 节点记录，target已是新目标
+     * @param animate 是否以补间移动
+     */
+    void moveEntry(int cardId, CardNodeEntry& entry, bool animate);
+
+    /**
+     * @brief 从容器移除节点并释放持有（或归还对象池）
+     *
+     * @param entry 要销毁的节点记录
+     */
+    void destroyEntry(CardNodeEntry& entry);
+
+    /**
+     * @brief 判断两张卡牌的显示内容是否相同
+     */
+    static bool isSameFace(const CardModel& a, const CardModel& b);
+};
+
+#endif // __CARD_VIEW_RECONCILER_H__
@@ -3,9 +3,20 @@
 #include "ui/CocosGUI.h"
 #include "CardView.h"
 #include "../services/AnimationService.h"
+#include <algorithm>
 
 USING_NS_CC;
 
+// 构造函数
+InputLatencyStats::InputLatencyStats()
+    : sampleCount(0), totalMicroseconds(0.0), maxMicroseconds(0.0), lastMicroseconds(0.0) {
+}
+
+// 获取平均延迟
+double InputLatencyStats::getAverageMicroseconds() const {
+    return sampleCount > 0 ? totalMicroseconds / sampleCount : 0.0;
+}
+
 // 创建游戏视图
 GameView* GameView::create() {
     GameView* ret = new (std::nothrow) GameView();
@@ -23,97 +34,109 @@ bool GameView::init() {
         return false;
     }
     
+    m_cardTweens.init(Director::getInstance()->getScheduler());
+    m_handCards.setCardViewPool(&m_cardViewPool);
+    m_handCards.setTweenSystem(&m_cardTweens);
+    m_playfieldCards.setCardViewPool(&m_cardViewPool);
+    m_playfieldCards.setTweenSystem(&m_cardTweens);
+    
+    // 换区飞行的卡牌用牌桌到手牌的时长，区内移动用手牌换顶的时长
+    CardViewReconciler::DurationFunc duration = [](int cardId, const Vec2& from, const Vec2& to, bool transferred) {
+        return transferred ? AnimationService::calculatePlayfieldToHandDuration(cardId, from, to)
+                           : AnimationService::calculateHandCardMoveToTopDuration(cardId, from, to);
+    };
+    m_handCards.setDurationFunc(duration);
+    m_playfieldCards.setDurationFunc(duration);
+    
     createUI();
+    createCardTouchListener();
+    
+    // 帧绘制完成的事件用于测量输入响应延迟，监听器随视图一起移除
+    m_inputPending = false;
+    m_responsePending = false;
+    auto frameListener = EventListenerCustom::create(Director::EVENT_AFTER_DRAW, [this](EventCustom*) {
+        onFrameDrawn();
+    });
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(frameListener, this);
     
     return true;
 }
 
-// 更新手牌显示
-void GameView::updateHandCards(const std::vector<CardModel>& handCards) {
-    if (!m_handCardContainer) {
+// 更新卡牌显示
+void GameView::updateCards(const std::vector<CardModel>& handCards, const std::vector<CardModel>& playfieldCards,
+                           bool animate) {
+    if (!m_handCardContainer || !m_playfieldContainer) {
         return;
     }
     
-    // 清除现有手牌
-    m_handCardContainer->removeAllChildren();
-    
-    if (handCards.empty()) {
-        return;
-    }
+    // 换区的卡牌先交出节点，飞行中的节点由新区域接着移动
+    transferCardViews(handCards, m_playfieldCards, m_handCards);
+    transferCardViews(playfieldCards, m_handCards, m_playfieldCards);
     
     // 以堆叠布局显示卡牌，顶部卡牌分离
     float cardOffset = 25.0f; // 堆叠卡牌间的偏移
     float topCardGap = 60.0f; // 顶部卡牌与堆叠的间隙
     
     // 计算所有卡牌所需的总宽度
-    float stackWidth = (handCards.size() - 1) * cardOffset;
+    float stackWidth = handCards.empty() ? 0.0f : (handCards.size() - 1) * cardOffset;
     float totalWidth = stackWidth + topCardGap + CardView::CARD_WIDTH;
     float startX = -totalWidth / 2.0f;
+    size_t topIndex = handCards.size() - 1;
     
-    for (size_t i = 0; i < handCards.size(); ++i) {
-        const CardModel& card = handCards[i];
-        auto cardNode = createCardSprite(card);
-        if (cardNode) {
-            float posX = 0;
-            float posY = 0;
-            
-            if (i == handCards.size() - 1) {
+    m_handCards.reconcile(handCards,
+        [=](size_t i, const CardModel& card) {
+            if (i == topIndex) {
                 // 顶部卡牌（向量中的最后一张）- 用间隙分离
-                posX = startX + stackWidth + topCardGap;
-            } else {
-                // 其他卡牌 - 从左侧堆叠
-                posX = startX + (float)i * cardOffset;
+                return Vec2(startX + stackWidth + topCardGap, 0);
             }
-            
-            cardNode->setPosition(Vec2(posX, posY));
-            m_handCardContainer->addChild(cardNode);
-            
-            // 添加点击事件
-            auto button = ui::Button::create();
-            button->setContentSize(Size(CardView::CARD_WIDTH, CardView::CARD_HEIGHT));
-            button->setPosition(Vec2(posX, posY));
-            button->setTag(card.id);
-            // 设置完全透明背景以确保触摸事件工作
-            button->loadTextureNormal("res/card_general.png");
-            button->setOpacity(0); // 设为完全透明
-            button->addTouchEventListener(CC_CALLBACK_2(GameView::onHandCardTouched, this));
-            m_handCardContainer->addChild(button);
-            CCLOG("Created hand card button with tag: %d at position (%f, %f)", card.id, posX, posY);
-        }
+            // 其他卡牌 - 从左侧堆叠
+            return Vec2(startX + (float)i * cardOffset, 0);
+        }, animate);
+    
+    // 牌桌卡牌直接使用配置中的位置
+    m_playfieldCards.reconcile(playfieldCards,
+        [](size_t i, const CardModel& card) {
+            return Vec2(card.position.x, card.position.y);
+        }, animate);
+    
+    // 输入引起了卡牌变化，下一次绘制即是它的画面响应
+    CardRefreshStats stats = getLastRefreshStats();
+    if (m_inputPending && stats.nodesCreated + stats.nodesDestroyed + stats.nodesMoved + stats.nodesUpdated > 0) {
+        m_responsePending = true;
     }
+    
+    rebuildTouchIndex();
 }
 
-// 更新牌桌卡牌显示
-void GameView::updatePlayfieldCards(const std::vector<CardModel>& playfieldCards) {
-    if (!m_playfieldContainer) {
-        return;
-    }
-    
-    // 清除现有卡牌
-    m_playfieldContainer->removeAllChildren();
-    
-    // 显示所有牌桌卡牌
-    for (const auto& card : playfieldCards) {
-        auto cardNode = createCardSprite(card);
-        if (cardNode) {
-            cardNode->setPosition(card.position);
-            m_playfieldContainer->addChild(cardNode);
-            
-            
-            auto button = ui::Button::create();
-            button->setContentSize(Size(CardView::CARD_WIDTH, CardView::CARD_HEIGHT));
-            button->setPosition(card.position);
-            button->setTag(card.id);
-            
-            button->loadTextureNormal("res/card_general.png");
-            button->setOpacity(0); 
-            button->addTouchEventListener(CC_CALLBACK_2(GameView::onPlayfieldCardTouched, this));
-            m_playfieldContainer->addChild(button);
-            CCLOG("Created playfield card button with tag: %d at position (%f, %f)", card.id, card.position.x, card.position.y);
+// 移交换区卡牌的节点
+void GameView::transferCardViews(const std::vector<CardModel>& cards, CardViewReconciler& from,
+                                 CardViewReconciler& to) {
+    for (const CardModel& card : cards) {
+        if (to.findCardView(card.id)) {
+            continue;
+        }
+        CardView* view = from.detach(card.id);
+        if (view && !to.adopt(card.id, view)) {
+            // 目标区域无法接收时放回原区域，由其随后的刷新回收
+            from.adopt(card.id, view);
         }
     }
 }
 
+// 获取最近一次刷新的节点统计
+CardRefreshStats GameView::getLastRefreshStats() const {
+    CardRefreshStats stats = m_handCards.getLastStats();
+    stats += m_playfieldCards.getLastStats();
+    return stats;
+}
+
+// 预热卡牌视图对象池
+void GameView::prewarmCardViews(size_t cardCount) {
+    m_cardViewPool.prewarm(cardCount);
+    CCLOG("Card view pool prewarmed: %d free, %d in use",
+          (int)m_cardViewPool.getFreeCount(), (int)m_cardViewPool.getInUseCount());
+}
+
 // 设置手牌点击回调
 void GameView::setHandCardClickCallback(const std::function<void(int)>& callback) {
     m_handCardClickCallback = callback;
@@ -129,6 +152,41 @@ void GameView::setUndoButtonClickCallback(const std::function<void()>& callback)
     m_undoButtonClickCallback = callback;
 }
 
+// 设置重做按钮点击回调
+void GameView::setRedoButtonClickCallback(const std::function<void()>& callback) {
+    m_redoButtonClickCallback = callback;
+}
+
+// 设置提示按钮点击回调
+void GameView::setHintButtonClickCallback(const std::function<void()>& callback) {
+    m_hintButtonClickCallback = callback;
+}
+
+// 高亮提示的卡牌
+void GameView::showHint(int handCardId, int playfieldCardId) {
+    float delay = 0.0f;
+    if (handCardId >= 0) {
+        pulseCard(m_handCards.findCardView(handCardId), delay);
+        delay += AnimationService::DEFAULT_SCALE_DURATION * 2;
+    }
+    pulseCard(m_playfieldCards.findCardView(playfieldCardId), delay);
+}
+
+// 卡牌放大再复原
+void GameView::pulseCard(Node* cardNode, float delay) {
+    if (!cardNode) {
+        return;
+    }
+    
+    auto grow = dynamic_cast<FiniteTimeAction*>(
+        AnimationService::createCardScaleAnimation(cardNode, 1.15f, AnimationService::DEFAULT_SCALE_DURATION));
+    auto shrink = dynamic_cast<FiniteTimeAction*>(
+        AnimationService::createCardScaleAnimation(cardNode, 1.0f, AnimationService::DEFAULT_SCALE_DURATION));
+    if (grow && shrink) {
+        cardNode->runAction(Sequence::create(DelayTime::create(delay), grow, shrink, nullptr));
+    }
+}
+
 // 显示游戏结束对话框
 void GameView::showGameEndDialog(bool isWin) {
     if (m_gameEndDialog) {
@@ -191,6 +249,7 @@ void GameView::createHandCardArea() {
     m_handCardContainer = Node::create();
     m_handCardContainer->setPosition(Vec2(540, 290));
     this->addChild(m_handCardContainer);
+    m_handCards.init(m_handCardContainer);
 }
 
 // 创建牌桌区域（主牌区 1080*1500）
@@ -209,6 +268,7 @@ void GameView::createPlayfieldArea() {
     m_playfieldContainer = Node::create();
     m_playfieldContainer->setPosition(Vec2(0, 580));
     this->addChild(m_playfieldContainer);
+    m_playfieldCards.init(m_playfieldContainer);
 }
 
 // 创建控制按钮
@@ -227,6 +287,36 @@ void GameView::createControlButtons() {
     m_undoButton->setTitleColor(Color3B::WHITE);
     m_undoButton->addTouchEventListener(CC_CALLBACK_2(GameView::onUndoButtonClicked, this));
     this->addChild(m_undoButton);
+    
+    m_redoButton = ui::Button::create();
+    m_redoButton->setTitleText("Redo");
+    m_redoButton->setTitleFontName("Arial");
+    m_redoButton->setTitleFontSize(32);
+    m_redoButton->setPosition(Vec2(400, 200));
+    
+    // 为重做按钮添加背景
+    auto redoBg = LayerColor::create(Color4B(128, 128, 128, 255), 150, 60);
+    redoBg->setPosition(Vec2(325, 170));
+    this->addChild(redoBg);
+    
+    m_redoButton->setTitleColor(Color3B::WHITE);
+    m_redoButton->addTouchEventListener(CC_CALLBACK_2(GameView::onRedoButtonClicked, this));
+    this->addChild(m_redoButton);
+    
+    m_hintButton = ui::Button::create();
+    m_hintButton->setTitleText("Hint");
+    m_hintButton->setTitleFontName("Arial");
+    m_hintButton->setTitleFontSize(32);
+    m_hintButton->setPosition(Vec2(600, 200));
+    
+    // 为提示按钮添加背景
+    auto hintBg = LayerColor::create(Color4B(128, 128, 128, 255), 150, 60);
+    hintBg->setPosition(Vec2(525, 170));
+    this->addChild(hintBg);
+    
+    m_hintButton->setTitleColor(Color3B::WHITE);
+    m_hintButton->addTouchEventListener(CC_CALLBACK_2(GameView::onHintButtonClicked, this));
+    this->addChild(m_hintButton);
 }
 
 // 创建分数显示
@@ -255,134 +345,136 @@ void GameView::createGameEndDialog() {
     this->addChild(m_gameEndDialog);
 }
 
-// 创建卡牌精灵
-Node* GameView::createCardSprite(const CardModel& card) {
-    // 使用CardView创建完整的卡牌显示
-    auto cardView = CardView::create(card);
-    if (cardView) {
-        // 直接返回CardView
-        return cardView;
-    }
+// 创建卡牌触摸监听器
+void GameView::createCardTouchListener() {
+    // 所有卡牌共用一个监听器，由空间索引找出触点下最上层的卡牌
+    auto listener = EventListenerTouchOneByOne::create();
+    listener->setSwallowTouches(true);
+    listener->onTouchBegan = CC_CALLBACK_2(GameView::onCardTouchBegan, this);
+    listener->onTouchEnded = CC_CALLBACK_2(GameView::onCardTouchEnded, this);
+    listener->onTouchCancelled = [this](Touch* touch, Event* event) {
+        m_touchedCardId = -1;
+    };
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+    m_touchedCardId = -1;
+}
+
+// 重建卡牌触摸索引
+void GameView::rebuildTouchIndex() {
+    Size cardSize(CardView::CARD_WIDTH, CardView::CARD_HEIGHT);
+    // 牌桌容器在手牌容器之后加入，整体位于上层
+    const int zoneLayerSpan = 100000;
     
-    // 如果CardView创建失败，回退到原来的方式
-    std::string imageName;
-    if (card.isFaceUp) {
-        imageName = GameUtils::getCardImageName(card);
-    } else {
-        imageName = GameUtils::getCardBackImageName();
+    m_touchRouter.beginRebuild();
+    struct ZoneInfo {
+        const CardViewReconciler* cards;
+        Node* container;
+        CardZone zone;
+    };
+    const ZoneInfo zones[] = {
+        { &m_handCards, m_handCardContainer, CZ_HAND },
+        { &m_playfieldCards, m_playfieldContainer, CZ_PLAYFIELD },
+    };
+    for (const auto& info : zones) {
+        if (!info.container) {
+            continue;
+        }
+        Vec2 containerPos = info.container->getPosition();
+        int zoneBase = static_cast<int>(info.zone) * zoneLayerSpan;
+        info.cards->forEachCardView([&](int cardId, CardView* view, const Vec2& target) {
+            Vec2 center = containerPos + target;
+            Rect rect(center.x - cardSize.width / 2, center.y - cardSize.height / 2, cardSize.width, cardSize.height);
+            m_touchRouter.addCard(cardId, info.zone, rect, zoneBase + view->getLocalZOrder());
+        });
     }
-    
-    auto sprite = Sprite::create(imageName);
-    return sprite;
+    m_touchRouter.endRebuild();
 }
 
-// 手牌触摸事件处理器
-void GameView::onHandCardTouched(Ref* sender, ui::Widget::TouchEventType type) {
-    CCLOG("Hand card touched, type: %d", (int)type);
-    if (type == ui::Widget::TouchEventType::BEGAN) {
-        CCLOG("Touch began on hand card");
-    }
-    if (type == ui::Widget::TouchEventType::ENDED) {
-        auto button = dynamic_cast<ui::Button*>(sender);
-        if (button) {
-            CCLOG("Button found, tag: %d", button->getTag());
-            if (m_handCardClickCallback) {
-                CCLOG("Calling hand card callback with cardId: %d", button->getTag());
-                m_handCardClickCallback(button->getTag());
-            } else {
-                CCLOG("Hand card callback is null!");
-            }
-        } else {
-            CCLOG("Button cast failed!");
-        }
+// 卡牌触摸开始
+bool GameView::onCardTouchBegan(Touch* touch, Event* event) {
+    CardHit hit;
+    Vec2 point = this->convertToNodeSpace(touch->getLocation());
+    if (!m_touchRouter.hitTest(point, hit)) {
+        return false;
     }
+    m_touchedCardId = hit.cardId;
+    return true;
 }
 
-// 牌桌卡牌触摸事件处理器
-void GameView::onPlayfieldCardTouched(Ref* sender, ui::Widget::TouchEventType type) {
-    if (type == ui::Widget::TouchEventType::ENDED) {
-        auto button = dynamic_cast<ui::Button*>(sender);
-        if (button && m_playfieldCardClickCallback) {
-            m_playfieldCardClickCallback(button->getTag());
+// 卡牌触摸结束
+void GameView::onCardTouchEnded(Touch* touch, Event* event) {
+    CardHit hit;
+    Vec2 point = this->convertToNodeSpace(touch->getLocation());
+    bool hasHit = m_touchRouter.hitTest(point, hit);
+    
+    // 只有在同一张卡牌上按下并抬起才算点击
+    if (!hasHit || hit.cardId != m_touchedCardId) {
+        m_touchedCardId = -1;
+        return;
+    }
+    m_touchedCardId = -1;
+    
+    markInput();
+    if (hit.zone == CZ_HAND) {
+        if (m_handCardClickCallback) {
+            m_handCardClickCallback(hit.cardId);
         }
+    } else if (m_playfieldCardClickCallback) {
+        m_playfieldCardClickCallback(hit.cardId);
     }
 }
 
 // 撤销按钮点击事件处理器
 void GameView::onUndoButtonClicked(Ref* sender, ui::Widget::TouchEventType type) {
     if (type == ui::Widget::TouchEventType::ENDED) {
+        markInput();
         if (m_undoButtonClickCallback) {
             m_undoButtonClickCallback();
         }
     }
 }
 
-// 手牌移动到顶部位置的动画
-void GameView::animateHandCardToTop(int cardId) {
-    if (!m_handCardContainer) {
-        return;
-    }
-    
-    // 通过标签查找卡牌节点
-    Node* cardNode = nullptr;
-    for (auto child : m_handCardContainer->getChildren()) {
-        if (child->getTag() == cardId) {
-            cardNode = child;
-            break;
+// 重做按钮点击事件处理器
+void GameView::onRedoButtonClicked(Ref* sender, ui::Widget::TouchEventType type) {
+    if (type == ui::Widget::TouchEventType::ENDED) {
+        markInput();
+        if (m_redoButtonClickCallback) {
+            m_redoButtonClickCallback();
         }
     }
-    
-    if (cardNode) {
-        // 计算顶部卡牌位置（与updateHandCards中相同）
-        Vec2 currentPos = cardNode->getPosition();
-        Vec2 topPos = Vec2(0, 0); // 当前布局中的顶部卡牌位置
-        
-        // 使用AnimationService创建动画
-        float duration = AnimationService::calculateHandCardMoveToTopDuration(cardId, currentPos, topPos);
-        auto moveAction = AnimationService::createCardMoveAnimation(cardNode, topPos, duration);
-        
-        if (moveAction) {
-            cardNode->runAction(moveAction);
+}
+
+// 提示按钮点击事件处理器
+void GameView::onHintButtonClicked(Ref* sender, ui::Widget::TouchEventType type) {
+    if (type == ui::Widget::TouchEventType::ENDED) {
+        if (m_hintButtonClickCallback) {
+            m_hintButtonClickCallback();
         }
     }
 }
 
-// 牌桌卡牌移动到手牌区域的动画
-void GameView::animatePlayfieldCardToHand(int cardId) {
-    if (!m_playfieldContainer || !m_handCardContainer) {
-        return;
-    }
-    
-    // 通过标签查找牌桌卡牌节点
-    Node* cardNode = nullptr;
-    for (auto child : m_playfieldContainer->getChildren()) {
-        if (child->getTag() == cardId) {
-            cardNode = child;
-            break;
-        }
+// 记下输入时刻
+void GameView::markInput() {
+    m_inputTime = std::chrono::steady_clock::now();
+    m_inputPending = true;
+    m_responsePending = false;
+}
+
+// 帧绘制完成
+void GameView::onFrameDrawn() {
+    if (m_responsePending) {
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_inputTime);
+        double microseconds = elapsed.count();
+        m_latencyStats.sampleCount++;
+        m_latencyStats.totalMicroseconds += microseconds;
+        m_latencyStats.maxMicroseconds = std::max(m_latencyStats.maxMicroseconds, microseconds);
+        m_latencyStats.lastMicroseconds = microseconds;
+        CCLOG("Input to visual response: %.2f us (avg %.2f us, max %.2f us over %d inputs)",
+              microseconds, m_latencyStats.getAverageMicroseconds(), m_latencyStats.maxMicroseconds,
+              m_latencyStats.sampleCount);
     }
     
-    if (cardNode) {
-        // 计算目标位置（手牌区域的顶部卡牌位置）
-        Vec2 currentPos = cardNode->getPosition();
-        Vec2 handAreaPos = m_handCardContainer->getPosition();
-        Vec2 targetPos = Vec2(handAreaPos.x, handAreaPos.y - 580); // 调整容器偏移
-        
-        // Use AnimationService to create animation
-        float duration = AnimationService::calculatePlayfieldToHandDuration(cardId, currentPos, targetPos);
-        auto moveAction = AnimationService::createCardMoveAnimation(cardNode, targetPos, duration);
-        
-        // 动画后移除卡牌
-        auto removeAction = CallFunc::create([cardNode]() {
-            cardNode->removeFromParent();
-        });
-        
-        if (moveAction) {
-            auto finiteAction = dynamic_cast<FiniteTimeAction*>(moveAction);
-            if (finiteAction) {
-                auto sequence = Sequence::create(finiteAction, removeAction, nullptr);
-                cardNode->runAction(sequence);
-            }
-        }
-    }
-}
\ No newline at end of file
+    // 没有引起变化的输入在这一帧之后不再等待
+    m_inputPending = false;
+    m_responsePending = false;
+}
@@ -4,9 +4,38 @@
 #include "cocos2d.h"
 #include "ui/CocosGUI.h"
 #include "../models/CardModel.h"
+#include "CardViewReconciler.h"
+#include "CardViewPool.h"
+#include "CardTouchRouter.h"
+#include "CardTweenSystem.h"
+#include <chrono>
 #include <vector>
 #include <functional>
 
+/**
+ * @struct InputLatencyStats
+ * @brief 输入到画面响应的延迟统计
+ *
+ * 从触摸抬起或按钮点击算起，到第一帧画出该输入引起的卡牌变化为止；
+ * 没有引起变化的输入（如被规则拒绝的点击）不计入
+ */
+struct InputLatencyStats {
+    int sampleCount;            ///< 统计的输入次数
+    double totalMicroseconds;   ///< 累计延迟（微秒）
+    double maxMicroseconds;     ///< 最大延迟（微秒）
+    double lastMicroseconds;    ///< 最近一次延迟（微秒）
+
+    /**
+     * @brief 构造函数
+     */
+    InputLatencyStats();
+
+    /**
+     * @brief 获取平均延迟（微秒）
+     */
+    double getAverageMicroseconds() const;
+};
+
 /**
  * @class GameView
  * @brief 游戏视图类
@@ -19,7 +48,7 @@
  * - 渲染游戏中的所有可视元素
  * - 处理用户的触摸和点击事件
  * - 显示游戏状态和信息
- * - 播放卡牌移动和游戏动画
+ * - 播放卡牌移动和游戏动画，模型变化以补间过渡到新布局
  * - 管理游戏界面布局和样式
  * 
  * 使用场景：
@@ -44,18 +73,17 @@ public:
     virtual bool init() override;
     
     /**
-     * @brief 更新手牌显示
+     * @brief 按最新的模型更新手牌和牌桌卡牌显示
      * 
+     * 换区的卡牌（匹配时牌桌到手牌、撤销时手牌回到牌桌）沿用原来的节点；
+     * 动画更新时位置改变的卡牌从当前位置飞向新位置，飞行中再次更新会直接转向新的目标，
+     * 因此连续点击不必等待前面的动画结束。触摸索引按目标位置建立，点击总是对应最新的模型
      * @param handCards 手牌卡牌列表
-     */
-    void updateHandCards(const std::vector<CardModel>& handCards);
-    
-    /**
-     * @brief 更新牌桌卡牌显示
-     * 
      * @param playfieldCards 牌桌卡牌列表
+     * @param animate 是否以动画过渡，为false时直接摆放到位
      */
-    void updatePlayfieldCards(const std::vector<CardModel>& playfieldCards);
+    void updateCards(const std::vector<CardModel>& handCards, const std::vector<CardModel>& playfieldCards,
+                     bool animate);
     
     /**
      * @brief 设置手牌点击回调函数
@@ -78,6 +106,29 @@ public:
      */
     void setUndoButtonClickCallback(const std::function<void()>& callback);
     
+    /**
+     * @brief 设置重做按钮点击回调函数
+     * 
+     * @param callback 重做按钮点击时的回调函数
+     */
+    void setRedoButtonClickCallback(const std::function<void()>& callback);
+    
+    /**
+     * @brief 设置提示按钮点击回调函数
+     * 
+     * @param callback 提示按钮点击时的回调函数
+     */
+    void setHintButtonClickCallback(const std::function<void()>& callback);
+    
+    /**
+     * @brief 高亮提示的卡牌
+     * 
+     * 需要先切换手牌时先后脉动手牌和牌桌卡牌，否则只脉动牌桌卡牌
+     * @param handCardId 需要先切换到顶部的手牌ID，为-1时不高亮手牌
+     * @param playfieldCardId 建议匹配的牌桌卡牌ID
+     */
+    void showHint(int handCardId, int playfieldCardId);
+    
     /**
      * @brief 显示游戏结束对话框
      * 
@@ -91,29 +142,69 @@ public:
     void hideGameEndDialog();
     
     /**
-     * @brief 播放手牌移动到顶部的动画
+     * @brief 获取最近一次刷新的节点统计
      * 
-     * @param cardId 要移动的卡牌ID
+     * @return 手牌区与牌桌区最近一次刷新的统计之和
      */
-    void animateHandCardToTop(int cardId);
+    CardRefreshStats getLastRefreshStats() const;
     
     /**
-     * @brief 播放牌桌卡牌移动到手牌区的动画
+     * @brief 预热卡牌视图对象池
      * 
-     * @param cardId 要移动的卡牌ID
+     * 通常在关卡加载完成后以关卡卡牌总数调用，使游戏过程中无需再创建卡牌节点
+     * @param cardCount 关卡中的卡牌总数
+     */
+    void prewarmCardViews(size_t cardCount);
+    
+    /**
+     * @brief 获取卡牌视图对象池
+     */
+    const CardViewPool& getCardViewPool() const { return m_cardViewPool; }
+    
+    /**
+     * @brief 获取卡牌命中测试的耗时统计
      */
-    void animatePlayfieldCardToHand(int cardId);
+    const HitTestStats& getHitTestStats() const { return m_touchRouter.getStats(); }
+    
+    /**
+     * @brief 获取进行中的卡牌补间数
+     */
+    size_t getActiveTweenCount() const { return m_cardTweens.getActiveCount(); }
+    
+    /**
+     * @brief 获取卡牌补间每帧更新的耗时统计
+     */
+    const TweenFrameStats& getTweenStats() const { return m_cardTweens.getStats(); }
+    
+    /**
+     * @brief 获取输入到画面响应的延迟统计
+     */
+    const InputLatencyStats& getInputLatencyStats() const { return m_latencyStats; }
     
 private:
     cocos2d::Node* m_handCardContainer;                    ///< 手牌容器节点，用于管理手牌显示
     cocos2d::Node* m_playfieldContainer;                  ///< 牌桌容器节点，用于管理牌桌卡牌显示
     cocos2d::ui::Button* m_undoButton;                    ///< 撤销按钮，用于撤销上一步操作
+    cocos2d::ui::Button* m_redoButton;                    ///< 重做按钮，用于重做被撤销的操作
+    cocos2d::ui::Button* m_hintButton;                    ///< 提示按钮，用于显示建议的下一步
     cocos2d::Label* m_scoreLabel;                         ///< 分数标签，显示当前游戏分数
     cocos2d::Node* m_gameEndDialog;                       ///< 游戏结束对话框节点
+    CardViewPool m_cardViewPool;                          ///< 卡牌视图对象池（需先于刷新器构造）
+    CardTweenSystem m_cardTweens;                         ///< 卡牌位移补间系统（需先于刷新器构造）
+    CardViewReconciler m_handCards;                       ///< 手牌区卡牌节点的差量刷新器
+    CardViewReconciler m_playfieldCards;                  ///< 牌桌区卡牌节点的差量刷新器
+    CardTouchRouter m_touchRouter;                        ///< 卡牌触摸路由器，按空间索引查找被点击的卡牌
+    int m_touchedCardId;                                  ///< 触摸按下时命中的卡牌ID，未命中为-1
+    std::chrono::steady_clock::time_point m_inputTime;    ///< 最近一次输入的时刻
+    bool m_inputPending;                                  ///< 最近一次输入是否还在等待画面响应
+    bool m_responsePending;                               ///< 最近一次输入引起的卡牌变化是否还未画出
+    InputLatencyStats m_latencyStats;                     ///< 输入到画面响应的延迟统计
     
     std::function<void(int)> m_handCardClickCallback;     ///< 手牌点击回调函数
     std::function<void(int)> m_playfieldCardClickCallback; ///< 牌桌卡牌点击回调函数
     std::function<void()> m_undoButtonClickCallback;      ///< 撤销按钮点击回调函数
+    std::function<void()> m_redoButtonClickCallback;      ///< 重做按钮点击回调函数
+    std::function<void()> m_hintButtonClickCallback;      ///< 提示按钮点击回调函数
     
     /**
      * @brief 创建用户界面元素
@@ -165,36 +256,87 @@ private:
     void createGameEndDialog();
     
     /**
-     * @brief 创建卡牌精灵
+     * @brief 创建卡牌触摸监听器
+     * 
+     * 整个视图只注册一个触摸监听器，替代每张卡牌一个透明按钮
+     */
+    void createCardTouchListener();
+    
+    /**
+     * @brief 把换区卡牌的节点从一个刷新器移交给另一个
      * 
-     * @param card 卡牌模型数据
-     * @return 返回创建的卡牌节点指针
+     * @param cards 目标区域的最新卡牌列表
+     * @param from 卡牌原来所在区域的刷新器
+     * @param to 目标区域的刷新器
      */
-    cocos2d::Node* createCardSprite(const CardModel& card);
+    static void transferCardViews(const std::vector<CardModel>& cards, CardViewReconciler& from,
+                                  CardViewReconciler& to);
     
     /**
-     * @brief 手牌触摸事件处理器
+     * @brief 重建卡牌触摸索引
+     * 
+     * 卡牌刷新后按目标位置和层级重新登记所有卡牌区域，飞行中的卡牌按落点响应点击
+     */
+    void rebuildTouchIndex();
+    
+    /**
+     * @brief 记下一次输入的时刻，开始测量画面响应延迟
+     */
+    void markInput();
+    
+    /**
+     * @brief 每帧绘制完成后调用，记录等待中的输入响应延迟
+     */
+    void onFrameDrawn();
+    
+    /**
+     * @brief 卡牌触摸开始事件处理器
+     * 
+     * @param touch 触摸对象
+     * @param event 事件对象
+     * @return 触点下有卡牌时返回true并吞噬该触摸
+     */
+    bool onCardTouchBegan(cocos2d::Touch* touch, cocos2d::Event* event);
+    
+    /**
+     * @brief 卡牌触摸结束事件处理器
+     * 
+     * @param touch 触摸对象
+     * @param event 事件对象
+     */
+    void onCardTouchEnded(cocos2d::Touch* touch, cocos2d::Event* event);
+    
+    /**
+     * @brief 撤销按钮点击事件处理器
      * 
      * @param sender 事件发送者
      * @param type 触摸事件类型
      */
-    void onHandCardTouched(cocos2d::Ref* sender, cocos2d::ui::Widget::TouchEventType type);
+    void onUndoButtonClicked(cocos2d::Ref* sender, cocos2d::ui::Widget::TouchEventType type);
     
     /**
-     * @brief 牌桌卡牌触摸事件处理器
+     * @brief 重做按钮点击事件处理器
      * 
      * @param sender 事件发送者
      * @param type 触摸事件类型
      */
-    void onPlayfieldCardTouched(cocos2d::Ref* sender, cocos2d::ui::Widget::TouchEventType type);
+    void onRedoButtonClicked(cocos2d::Ref* sender, cocos2d::ui::Widget::TouchEventType type);
     
     /**
-     * @brief 撤销按钮点击事件处理器
+     * @brief 提示按钮点击事件处理器
      * 
      * @param sender 事件发送者
      * @param type 触摸事件类型
      */
-    void onUndoButtonClicked(cocos2d::Ref* sender, cocos2d::ui::Widget::TouchEventType type);
+    void onHintButtonClicked(cocos2d::Ref* sender, cocos2d::ui::Widget::TouchEventType type);
+    
+    /**
+     * @brief 让卡牌节点放大再复原，用于提示
+     * 
+     * @param cardNode 卡牌节点，可为空
+     * @param delay 开始前的延迟（秒）
+     */
+    void pulseCard(cocos2d::Node* cardNode, float delay);
 };
 
 #endif // __GAME_VIEW_H__
\ No newline at end of file
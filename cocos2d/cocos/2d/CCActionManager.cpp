@@ -436,6 +436,18 @@ ssize_t ActionManager::getNumberOfRunningActions() const
     return count;
 }
 
+bool ActionManager::hasRunningActions() const
+{
+    for (tHashElement *elt = _targets; elt != nullptr; elt = (tHashElement*)(elt->hh.next))
+    {
+        if (! elt->paused && elt->actions && elt->actions->num > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 // main loop
 void ActionManager::update(float dt)
 {
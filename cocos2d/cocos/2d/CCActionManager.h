@@ -148,6 +148,13 @@ public:
      */
     virtual ssize_t getNumberOfRunningActions() const;
 
+    /** Returns whether any action will be stepped on the next update, i.e. some target that is not paused has actions.
+     * The director uses it to decide whether a frame can be skipped when rendering on demand.
+     * @return True if at least one action is running.
+     * @js NA
+     */
+    virtual bool hasRunningActions() const;
+
     /** @deprecated Use getNumberOfRunningActionsInTarget() instead.
      */
     CC_DEPRECATED_ATTRIBUTE ssize_t numberOfRunningActionsInTarget(Node *target) const { return getNumberOfRunningActionsInTarget(target); }
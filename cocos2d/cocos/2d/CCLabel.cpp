@@ -616,6 +616,7 @@ void Label::setFontAtlas(FontAtlas* atlas,bool distanceFieldEnabled /* = false *
     {
         _lineHeight = _fontAtlas->getLineHeight();
         _contentDirty = true;
+        _director->requestRedraw();
         _systemFontDirty = false;
     }
     _useDistanceField = distanceFieldEnabled;
@@ -671,6 +672,7 @@ void Label::setString(const std::string& text)
     {
         _utf8Text = text;
         _contentDirty = true;
+        _director->requestRedraw();
 
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
@@ -695,6 +697,7 @@ void Label::setAlignment(TextHAlignment hAlignment,TextVAlignment vAlignment)
         _vAlignment = vAlignment;
 
         _contentDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -704,6 +707,7 @@ void Label::setMaxLineWidth(float maxLineWidth)
     {
         _maxLineWidth = maxLineWidth;
         _contentDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -721,6 +725,7 @@ void Label::setDimensions(float width, float height)
 
         _maxLineWidth = width;
         _contentDirty = true;
+        _director->requestRedraw();
 
         if(_overflow == Overflow::SHRINK){
             if (_originalFontSize > 0) {
@@ -749,6 +754,7 @@ void Label::setLineBreakWithoutSpace(bool breakWithoutSpace)
     {
         _lineBreakWithoutSpaces = breakWithoutSpace;
         _contentDirty = true;     
+        _director->requestRedraw();
     }
 }
 
@@ -1034,6 +1040,7 @@ void Label::setBMFontSizeInternal(float fontSize)
     if(_currentLabelType == LabelType::BMFONT){
         this->setBMFontFilePath(_bmFontPath, Vec2::ZERO, fontSize);
         _contentDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -1070,6 +1077,7 @@ void Label::enableGlow(const Color4B& glowColor)
             config.distanceFieldEnabled = true;
             setTTFConfig(config);
             _contentDirty = true;
+            _director->requestRedraw();
         }
         _currLabelEffect = LabelEffect::GLOW;
         _effectColorF.r = glowColor.r / 255.0f;
@@ -1107,6 +1115,7 @@ void Label::enableOutline(const Color4B& outlineColor,int outlineSize /* = -1 */
             _effectColorF.a = outlineColor.a / 255.f;
             _currLabelEffect = LabelEffect::OUTLINE;
             _contentDirty = true;
+            _director->requestRedraw();
         }
         _outlineSize = outlineSize;
     }
@@ -1186,6 +1195,7 @@ void Label::enableUnderline()
         _underlineNode = DrawNode::create();
         addChild(_underlineNode, 100000);
         _contentDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -1219,6 +1229,7 @@ void Label::disableEffect(LabelEffect effect)
                 }
                 _currLabelEffect = LabelEffect::NORMAL;
                 _contentDirty = true;
+                _director->requestRedraw();
             }
             break;
         case cocos2d::LabelEffect::SHADOW:
@@ -1826,6 +1837,7 @@ void Label::setLineHeight(float height)
     {
         _lineHeight = height;
         _contentDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -1841,6 +1853,7 @@ void Label::setLineSpacing(float height)
     {
         _lineSpacing = height;
         _contentDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -1858,6 +1871,7 @@ void Label::setAdditionalKerning(float space)
         {
             _additionalKerning = space;
             _contentDirty = true;
+            _director->requestRedraw();
         }
     }
     else
@@ -1947,6 +1961,7 @@ void Label::updateDisplayedColor(const Color3B& parentColor)
         // Correct solution is to update the DrawNode directly since we know it is
         // a line. Returning a pointer to the line is an option
         _contentDirty = true;
+        _director->requestRedraw();
     }
 
     for (auto&& it : _letters)
@@ -1984,6 +1999,7 @@ void Label::setTextColor(const Color4B &color)
     if (_currentLabelType == LabelType::STRING_TEXTURE && _textColor != color)
     {
         _contentDirty = true;
+        _director->requestRedraw();
     }
 
     _textColor = color;
@@ -2174,6 +2190,7 @@ void Label::enableWrap(bool enable)
     this->rescaleWithOriginalFontSize();
     
     _contentDirty = true;
+    _director->requestRedraw();
 }
 
 bool Label::isWrapEnabled()const
@@ -2202,6 +2219,7 @@ void Label::setOverflow(Overflow overflow)
     this->rescaleWithOriginalFontSize();
     
     _contentDirty = true;
+    _director->requestRedraw();
 }
 
 void Label::rescaleWithOriginalFontSize()
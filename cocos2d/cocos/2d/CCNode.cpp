@@ -251,6 +251,7 @@ void Node::setSkewX(float skewX)
     
     _skewX = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 float Node::getSkewY() const
@@ -265,6 +266,7 @@ void Node::setSkewY(float skewY)
     
     _skewY = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 void Node::setLocalZOrder(std::int32_t z)
@@ -279,6 +281,7 @@ void Node::setLocalZOrder(std::int32_t z)
     }
 
     _eventDispatcher->setDirtyForNode(this);
+    _director->requestRedraw();
 }
 
 /// zOrder setter : private method
@@ -299,6 +302,7 @@ void Node::setGlobalZOrder(float globalZOrder)
     {
         _globalZOrder = globalZOrder;
         _eventDispatcher->setDirtyForNode(this);
+        _director->requestRedraw();
     }
 }
 
@@ -317,6 +321,7 @@ void Node::setRotation(float rotation)
     
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
     
     updateRotationQuat();
 }
@@ -334,6 +339,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -385,6 +391,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -399,6 +406,7 @@ void Node::setRotationSkewX(float rotationX)
     
     _rotationZ_X = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
     
     updateRotationQuat();
 }
@@ -415,6 +423,7 @@ void Node::setRotationSkewY(float rotationY)
     
     _rotationZ_Y = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
     
     updateRotationQuat();
 }
@@ -434,6 +443,7 @@ void Node::setScale(float scale)
     
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 /// scaleX getter
@@ -451,6 +461,7 @@ void Node::setScale(float scaleX,float scaleY)
     _scaleX = scaleX;
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 /// scaleX setter
@@ -461,6 +472,7 @@ void Node::setScaleX(float scaleX)
     
     _scaleX = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 /// scaleY getter
@@ -477,6 +489,7 @@ void Node::setScaleZ(float scaleZ)
     
     _scaleZ = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 /// scaleY getter
@@ -493,6 +506,7 @@ void Node::setScaleY(float scaleY)
     
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 
@@ -523,6 +537,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
     _usingNormalizedPosition = false;
 }
 
@@ -568,6 +583,7 @@ void Node::setPositionZ(float positionZ)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 
     _positionZ = positionZ;
 }
@@ -588,6 +604,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -609,6 +626,7 @@ void Node::setVisible(bool visible)
         _visible = visible;
         if(_visible)
             _transformUpdated = _transformDirty = _inverseDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -630,6 +648,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -647,6 +666,7 @@ void Node::setContentSize(const Size & size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -661,6 +681,7 @@ void Node::setParent(Node * parent)
 {
     _parent = parent;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 /// isRelativeAnchorPoint getter
@@ -676,6 +697,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        _director->requestRedraw();
     }
 }
 
@@ -1164,6 +1186,7 @@ void Node::insertChild(Node* child, int z)
     _reorderChildDirty = true;
     _children.pushBack(child);
     child->_setLocalZOrder(z);
+    _director->requestRedraw();
 }
 
 void Node::reorderChild(Node *child, int zOrder)
@@ -1172,6 +1195,7 @@ void Node::reorderChild(Node *child, int zOrder)
     _reorderChildDirty = true;
     child->updateOrderOfArrival();
     child->_setLocalZOrder(zOrder);
+    _director->requestRedraw();
 }
 
 void Node::sortAllChildren()
@@ -1808,6 +1832,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform = transform;
     _transformDirty = false;
     _transformUpdated = true;
+    _director->requestRedraw();
 
     if (_additionalTransform)
         // _additionalTransform[1] has a copy of lastest transform
@@ -1841,6 +1866,7 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
         _additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
+    _director->requestRedraw();
 }
 
 void Node::setAdditionalTransform(const Mat4& additionalTransform)
@@ -2013,6 +2039,7 @@ void Node::updateDisplayedOpacity(GLubyte parentOpacity)
 {
     _displayedOpacity = _realOpacity * parentOpacity/255.0;
     updateColor();
+    _director->requestRedraw();
     
     if (_cascadeOpacityEnabled)
     {
@@ -2100,6 +2127,7 @@ void Node::updateDisplayedColor(const Color3B& parentColor)
     _displayedColor.g = _realColor.g * parentColor.g/255.0;
     _displayedColor.b = _realColor.b * parentColor.b/255.0;
     updateColor();
+    _director->requestRedraw();
     
     if (_cascadeColorEnabled)
     {
@@ -409,6 +409,7 @@ void Sprite::setTexture(Texture2D *texture)
         }
         updateBlendFunc();
     }
+    _director->requestRedraw();
 }
 
 Texture2D* Sprite::getTexture() const
@@ -671,6 +672,7 @@ void Sprite::updatePoly()
         // to avoid memcpy'ing stuff
         _polyInfo.setTriangles(triangles);
     }
+    _director->requestRedraw();
 }
 
 void Sprite::setCenterRectNormalized(const cocos2d::Rect &rectTopLeft)
@@ -1438,6 +1440,7 @@ void Sprite::setFlippedX(bool flippedX)
     {
         _flippedX = flippedX;
         flipX();
+        _director->requestRedraw();
     }
 }
 
@@ -1452,6 +1455,7 @@ void Sprite::setFlippedY(bool flippedY)
     {
         _flippedY = flippedY;
         flipY();
+        _director->requestRedraw();
     }
 }
 
@@ -1539,7 +1543,7 @@ void Sprite::updateColor(void)
     }
 
     // self render
-    // do nothing
+    _director->requestRedraw();
 }
 
 void Sprite::setOpacityModifyRGB(bool modify)
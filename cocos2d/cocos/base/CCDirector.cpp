@@ -267,6 +267,13 @@ void Director::drawScene()
         _eventDispatcher->dispatchEvent(_eventAfterUpdate);
     }
 
+    if (_renderOnDemand && !_redrawRequested && !_nextScene)
+    {
+        // nothing visible changed, keep the last frame on screen
+        advanceTotalFrames();
+        return;
+    }
+
     _renderer->clear();
     experimental::FrameBuffer::clearAllFBOs();
     
@@ -313,12 +320,13 @@ void Director::drawScene()
     }
     
     _renderer->render();
+    _redrawRequested = false;
 
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
 
     popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 
-    _totalFrames++;
+    advanceTotalFrames();
 
     // swap buffers
     if (_openGLView)
@@ -356,8 +364,9 @@ void Director::calculateDeltaTime()
     }
 
 #if COCOS2D_DEBUG
-    // If we are debugging our code, prevent big delta time
-    if (_deltaTime > 0.2f)
+    // If we are debugging our code, prevent big delta time.
+    // Rendering on demand waits for input between frames, so long deltas are expected there.
+    if (_deltaTime > 0.2f && !_renderOnDemand)
     {
         _deltaTime = 1 / 60.0f;
     }
@@ -368,6 +377,57 @@ float Director::getDeltaTime() const
 {
     return _deltaTime;
 }
+
+void Director::advanceTotalFrames()
+{
+    if (_renderOnDemand && _animationInterval > 0)
+    {
+        // count the frames skipped while waiting, so the frame count keeps measuring time
+        unsigned int frames = static_cast<unsigned int>(_deltaTime / _animationInterval + 0.5f);
+        _totalFrames += MAX(1u, frames);
+    }
+    else
+    {
+        _totalFrames++;
+    }
+}
+
+void Director::setRenderOnDemand(bool renderOnDemand)
+{
+    _renderOnDemand = renderOnDemand;
+    _redrawRequested = true;
+}
+
+float Director::getIdleWaitTime()
+{
+    if (!_renderOnDemand || _invalid || _purgeDirectorInNextLoop || _restartDirectorInNextLoop)
+    {
+        return 0;
+    }
+    if (_redrawRequested || _nextScene)
+    {
+        return 0;
+    }
+    if (_paused)
+    {
+        // neither actions nor the scheduler are ticked while paused
+        return FLT_MAX;
+    }
+    if (_actionManager->hasRunningActions())
+    {
+        return 0;
+    }
+    return _scheduler->getTimeToNextUpdate();
+}
+
+void Director::wakeUp()
+{
+    if (_openGLView)
+    {
+        _openGLView->wakeUp();
+    }
+}
+
 void Director::setOpenGLView(GLView *openGLView)
 {
     CCASSERT(openGLView, "opengl view should not be null");
@@ -430,6 +490,7 @@ void Director::setViewport()
     {
         _openGLView->setViewPortInPoints(0, 0, _winSizeInPoints.width, _winSizeInPoints.height);
     }
+    requestRedraw();
 }
 
 void Director::setNextDeltaTimeZero(bool nextDeltaTimeZero)
@@ -1196,6 +1257,8 @@ void Director::setNextScene()
     }
     
     _eventDispatcher->dispatchEvent(_afterSetNextScene);
+
+    requestRedraw();
 }
 
 void Director::pause()
@@ -1225,6 +1288,7 @@ void Director::resume()
     _deltaTime = 0;
     // fix issue #3509, skip one fps to avoid incorrect time calculation.
     setNextDeltaTimeZero(true);
+    requestRedraw();
 }
 
 void Director::updateFrameRate()
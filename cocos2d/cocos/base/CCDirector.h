@@ -207,8 +207,45 @@ public:
     /** Whether or not the Director is paused. */
     bool isPaused() { return _paused; }
 
-    /** How many frames were called since the director started */
+    /** How many frames were called since the director started.
+     * When rendering on demand, skipped frames and the animation intervals spent waiting for input are counted too,
+     * so the value keeps advancing with time at the animation interval.
+     */
     unsigned int getTotalFrames() { return _totalFrames; }
+
+    /** Whether or not frames are only rendered when the scene changes. */
+    bool isRenderOnDemand() const { return _renderOnDemand; }
+    /**
+     * Enables or disables rendering on demand.
+     * When enabled, a frame whose scene graph was not modified still ticks the scheduler but skips clear, visit,
+     * render and swap, and the platform main loop may block in GLView::waitEvents() for getIdleWaitTime() seconds.
+     * The total frame count keeps advancing by elapsed animation intervals, so it still measures time.
+     * @since v3.17
+     */
+    void setRenderOnDemand(bool renderOnDemand);
+
+    /**
+     * Requests that the next frame is rendered.
+     * Nodes, sprites, labels and the event dispatcher call it when something visible changes; content modified
+     * through other paths (custom draw commands, direct GL state) should call it explicitly.
+     * @since v3.17
+     */
+    void requestRedraw() { _redrawRequested = true; }
+
+    /**
+     * Gets how long the main loop can wait for input before the next frame is due.
+     * @return 0 if the next frame has work to do (a redraw, a scene change, running actions or a per-frame update),
+     * the seconds until the next scheduled timer otherwise, or FLT_MAX if only input can change the scene.
+     * Always 0 when rendering on demand is disabled.
+     * @since v3.17
+     */
+    float getIdleWaitTime();
+
+    /**
+     * Wakes up the main loop if it is waiting for input. Can be called from any thread.
+     * @since v3.17
+     */
+    void wakeUp();
     
     /** Gets an OpenGL projection.
      * @since v0.8.2
@@ -598,6 +635,9 @@ protected:
     bool _restartDirectorInNextLoop = false; // this flag will be set to true in restart()
     
     void setNextScene();
+
+    /* Advances _totalFrames after a frame, by the elapsed animation intervals when rendering on demand */
+    void advanceTotalFrames();
     
     void updateFrameRate();
 #if !CC_STRIP_FPS
@@ -672,7 +712,13 @@ protected:
     /** Whether or not the Director is paused */
     bool _paused = false;
 
-    /* How many frames were called since the director started */
+    /* Whether or not frames are only rendered when the scene changes */
+    bool _renderOnDemand = false;
+
+    /* Whether or not the next frame has to be rendered, used when rendering on demand */
+    bool _redrawRequested = true;
+
+    /* How many frames were called since the director started, including skipped and idle intervals when rendering on demand */
     unsigned int _totalFrames = 0;
     unsigned int _frames = 0;
     float _secondsPerFrame = 1.f;
@@ -905,6 +905,11 @@ void EventDispatcher::dispatchEvent(Event* event)
     
     updateDirtyFlagForSceneGraph();
     
+    // input may change the scene through paths that are not tracked, render the next frame when rendering on demand
+    if (event->getType() != Event::Type::CUSTOM)
+    {
+        Director::getInstance()->requestRedraw();
+    }
     
     DispatchGuard guard(_inDispatch);
     
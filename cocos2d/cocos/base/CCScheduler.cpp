@@ -151,6 +151,18 @@ bool Timer::isExhausted() const
     return !_runForever && _timesExecuted > _repeat;
 }
 
+float Timer::getTimeToNextTrigger() const
+{
+    // a new timer starts counting on its first update
+    if (_elapsed == -1)
+    {
+        return 0;
+    }
+    // if _interval == 0, it triggers every frame
+    float next = _useDelay ? _delay : _interval;
+    return std::max(0.0f, next - _elapsed);
+}
+
 // TimerTargetSelector
 
 TimerTargetSelector::TimerTargetSelector()
@@ -809,8 +821,13 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
 
 void Scheduler::performFunctionInCocosThread(std::function<void ()> function)
 {
-    std::lock_guard<std::mutex> lock(_performMutex);
-    _functionsToPerform.push_back(std::move(function));
+    {
+        std::lock_guard<std::mutex> lock(_performMutex);
+        _functionsToPerform.push_back(std::move(function));
+    }
+
+    // the main loop may be blocked waiting for input when rendering on demand
+    Director::getInstance()->wakeUp();
 }
 
 void Scheduler::removeAllFunctionsToBePerformedInCocosThread()
@@ -819,6 +836,71 @@ void Scheduler::removeAllFunctionsToBePerformedInCocosThread()
     _functionsToPerform.clear();
 }
 
+float Scheduler::getTimeToNextUpdate()
+{
+    {
+        std::lock_guard<std::mutex> lock(_performMutex);
+        if (!_functionsToPerform.empty())
+        {
+            return 0;
+        }
+    }
+
+#if CC_ENABLE_SCRIPT_BINDING
+    if (!_scriptHandlerEntries.empty())
+    {
+        return 0;
+    }
+#endif
+
+    // updates with priority < 0
+    tListEntry *entry, *tmp;
+    DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
+    {
+        if (entry->priority != PRIORITY_SYSTEM && !entry->paused && !entry->markedForDeletion)
+        {
+            return 0;
+        }
+    }
+
+    // updates with priority == 0
+    DL_FOREACH_SAFE(_updates0List, entry, tmp)
+    {
+        if (!entry->paused && !entry->markedForDeletion)
+        {
+            return 0;
+        }
+    }
+
+    // updates with priority > 0
+    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
+    {
+        if (!entry->paused && !entry->markedForDeletion)
+        {
+            return 0;
+        }
+    }
+
+    // timers with interval
+    float idle = FLT_MAX;
+    for (tHashTimerEntry *elt = _hashForTimers; elt != nullptr; elt = (tHashTimerEntry *)elt->hh.next)
+    {
+        if (elt->paused)
+        {
+            continue;
+        }
+        for (int i = 0; i < elt->timers->num; ++i)
+        {
+            Timer *timer = static_cast<Timer*>(elt->timers->arr[i]);
+            if (!timer->isAborted())
+            {
+                idle = std::min(idle, timer->getTimeToNextTrigger());
+            }
+        }
+    }
+    return idle;
+}
+
 // main loop
 void Scheduler::update(float dt)
 {
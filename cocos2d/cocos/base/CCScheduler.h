@@ -55,6 +55,9 @@ public:
     void setAborted() { _aborted = true; }
     bool isAborted() const { return _aborted; }
     bool isExhausted() const;
+
+    /** Returns the seconds left until the timer triggers; 0 if it has to be updated on the next frame. */
+    float getTimeToNextTrigger() const;
     
     virtual void trigger(float dt) = 0;
     virtual void cancel() = 0;
@@ -437,6 +440,17 @@ public:
      * @js NA
      */
     void removeAllFunctionsToBePerformedInCocosThread();
+
+    /** Returns how long the scheduler can stay idle before a scheduled callback is due.
+     * Per-frame updates, timers with a zero interval, newly scheduled timers and functions queued with
+     * performFunctionInCocosThread all need the next frame and yield 0. Updates with PRIORITY_SYSTEM are not
+     * counted: the system services using them (the action manager) report their own state.
+     * Used by the director when rendering on demand.
+     * @return Seconds until the next callback is due, or FLT_MAX if nothing is scheduled.
+     * @since v3.17
+     * @js NA
+     */
+    float getTimeToNextUpdate();
     
     /////////////////////////////////////
     
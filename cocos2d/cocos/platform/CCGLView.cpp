@@ -128,6 +128,11 @@ void GLView::pollEvents()
 {
 }
 
+void GLView::waitEvents(float /*timeout*/)
+{
+    pollEvents();
+}
+
 void GLView::updateDesignResolutionSize()
 {
     if (_screenSize.width > 0 && _screenSize.height > 0
@@ -165,6 +165,21 @@ public:
     /** Polls the events. */
     virtual void pollEvents();
 
+    /**
+     * Waits until events arrive or the timeout expires, then processes them like pollEvents().
+     * Used by the main loop when the director renders on demand and has nothing to do.
+     * The default implementation only polls.
+     * @param timeout Seconds to wait at most, FLT_MAX to wait without a timeout.
+     * @since v3.17
+     */
+    virtual void waitEvents(float timeout);
+
+    /**
+     * Makes a pending waitEvents() return. Can be called from any thread.
+     * @since v3.17
+     */
+    virtual void wakeUp() {}
+
     /**
      * Get the frame size of EGL view.
      * In general, it returns the screen size since the EGL view is a fullscreen view.
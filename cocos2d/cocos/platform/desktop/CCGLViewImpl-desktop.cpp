@@ -345,6 +345,7 @@ bool GLViewImpl::initWithRect(const std::string& viewName, Rect rect, float fram
     glfwSetWindowSizeCallback(_mainWindow, GLFWEventHandler::onGLFWWindowSizeFunCallback);
     glfwSetWindowIconifyCallback(_mainWindow, GLFWEventHandler::onGLFWWindowIconifyCallback);
     glfwSetWindowFocusCallback(_mainWindow, GLFWEventHandler::onGLFWWindowFocusCallback);
+    glfwSetWindowRefreshCallback(_mainWindow, GLFWEventHandler::onGLFWWindowRefreshCallback);
 
     setFrameSize(rect.size.width, rect.size.height);
 
@@ -437,6 +438,23 @@ void GLViewImpl::pollEvents()
     glfwPollEvents();
 }
 
+void GLViewImpl::waitEvents(float timeout)
+{
+    if (timeout >= FLT_MAX)
+    {
+        glfwWaitEvents();
+    }
+    else
+    {
+        glfwWaitEventsTimeout(timeout);
+    }
+}
+
+void GLViewImpl::wakeUp()
+{
+    glfwPostEmptyEvent();
+}
+
 void GLViewImpl::enableRetina(bool enabled)
 {
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
@@ -955,6 +973,12 @@ void GLViewImpl::onGLFWWindowFocusCallback(GLFWwindow* /*window*/, int focused)
     }
 }
 
+void GLViewImpl::onGLFWWindowRefreshCallback(GLFWwindow* /*window*/)
+{
+    // the window contents were damaged, e.g. uncovered by another window
+    Director::getInstance()->requestRedraw();
+}
+
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
 static bool glew_dynamic_binding()
 {
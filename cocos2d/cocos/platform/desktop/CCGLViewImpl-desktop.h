@@ -79,6 +79,8 @@ public:
 
     bool windowShouldClose() override;
     void pollEvents() override;
+    void waitEvents(float timeout) override;
+    void wakeUp() override;
     GLFWwindow* getWindow() const { return _mainWindow; }
 
     bool isFullscreen() const;
@@ -165,6 +167,7 @@ protected:
     void onGLFWWindowSizeFunCallback(GLFWwindow *window, int width, int height);
     void onGLFWWindowIconifyCallback(GLFWwindow* window, int iconified);
     void onGLFWWindowFocusCallback(GLFWwindow* window, int focused);
+    void onGLFWWindowRefreshCallback(GLFWwindow* window);
 
     bool _captured;
     bool _supportTouch;
@@ -275,6 +278,14 @@ public:
         }
     }
 
+    static void onGLFWWindowRefreshCallback(GLFWwindow* window)
+    {
+        if (_view)
+        {
+            _view->onGLFWWindowRefreshCallback(window);
+        }
+    }
+
 private:
     static GLViewImpl* _view;
 };
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include <unistd.h>
 #include <sys/time.h>
 #include <string>
+#include <algorithm>
 #include "base/CCDirector.h"
 #include "base/ccUtils.h"
 #include "platform/CCFileUtils.h"
@@ -89,6 +90,16 @@ int Application::run()
         glview->pollEvents();
 
         curTime = getCurrentMillSecond();
+
+        // when rendering on demand and nothing is due, block until input or the next timer instead of spinning
+        float idleTime = director->getIdleWaitTime();
+        if (idleTime > 0)
+        {
+            float frameRemaining = (_animationInterval - curTime + lastTime) / 1000.0f;
+            glview->waitEvents(std::max(idleTime, frameRemaining));
+            continue;
+        }
+
         if (curTime - lastTime < _animationInterval)
         {
             usleep((_animationInterval - curTime + lastTime)*1000);
@@ -0,0 +1,105 @@
+﻿/**
+ * @file FaceIndexTests.cpp
+ * @brief 牌面匹配索引与游戏状态保持一致
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "models/FaceMatchIndex.h"
+#include "managers/UndoManager.h"
+#include "services/GameService.h"
+
+namespace {
+
+/**
+ * @brief 按当前手牌和牌桌重新统计，与增量维护的索引逐项比较
+ */
+bool matchesState(const PackedGameState& state) {
+    const FaceMatchIndex& index = state.faceIndex;
+    int handCounts[CFT_NUM_CARD_FACE_TYPES] = {};
+    int playfieldCounts[CFT_NUM_CARD_FACE_TYPES] = {};
+    for (int i = 0; i < state.handCount; ++i) {
+        handCounts[state.handCards[i].face()]++;
+    }
+    for (int i = 0; i < state.playfield.size(); ++i) {
+        playfieldCounts[state.playfield.values[i].face()]++;
+    }
+
+    for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face) {
+        uint16_t bit = FaceMatchIndex::faceBit(static_cast<CardFaceType>(face));
+        if (index.handCounts[face] != handCounts[face] || ((index.handMask & bit) != 0) != (handCounts[face] > 0)) {
+            return false;
+        }
+        if (index.playfieldCounts[face] != playfieldCounts[face] ||
+            ((index.playfieldMask & bit) != 0) != (playfieldCounts[face] > 0)) {
+            return false;
+        }
+
+        // 链表中恰好是该牌面的全部牌桌卡牌
+        int listed = 0;
+        for (uint8_t id = index.bucketHead[face]; id != FaceMatchIndex::NO_CARD; id = index.bucketNext[id]) {
+            const PackedCard* card = state.playfield.find(id);
+            if (!card || card->face() != face || ++listed > playfieldCounts[face]) {
+                return false;
+            }
+        }
+        if (listed != playfieldCounts[face]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE(face_index, tracks_add_and_remove) {
+    FaceMatchIndex index;
+    index.clear();
+    index.addPlayfieldCard(CFT_FIVE, 3);
+    index.addPlayfieldCard(CFT_FIVE, 9);
+    index.addPlayfieldCard(CFT_KING, 4);
+    index.addHandCard(CFT_FIVE);
+    CHECK(index.playfieldMask == (FaceMatchIndex::faceBit(CFT_FIVE) | FaceMatchIndex::faceBit(CFT_KING)));
+    CHECK(index.handMask == FaceMatchIndex::faceBit(CFT_FIVE));
+    CHECK(index.playfieldCounts[CFT_FIVE] == 2);
+
+    // 移除链表中间和头部的卡牌
+    index.removePlayfieldCard(CFT_FIVE, 9);
+    CHECK(index.bucketHead[CFT_FIVE] == 3);
+    CHECK(index.bucketNext[3] == FaceMatchIndex::NO_CARD);
+    index.removePlayfieldCard(CFT_FIVE, 3);
+    CHECK(index.bucketHead[CFT_FIVE] == FaceMatchIndex::NO_CARD);
+    CHECK(index.playfieldMask == FaceMatchIndex::faceBit(CFT_KING));
+
+    index.removeHandCard(CFT_FIVE);
+    CHECK(index.handMask == 0);
+}
+
+TEST_CASE(face_index, stays_consistent_through_play_and_undo) {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_SEVEN, CST_CLUBS));
+    level.stack.push_back(TestLevels::card(CFT_FOUR, CST_HEARTS));
+    level.playfield.push_back(TestLevels::card(CFT_FIVE, CST_SPADES));
+    level.playfield.push_back(TestLevels::card(CFT_THREE, CST_SPADES));
+    level.playfield.push_back(TestLevels::card(CFT_EIGHT, CST_DIAMONDS));
+    level.playfield.push_back(TestLevels::card(CFT_FIVE, CST_HEARTS));
+
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, level));
+    REQUIRE(undoManager.init(&model));
+    CHECK(matchesState(model.state));
+
+    // 4匹配5（ID 2），切换到手牌7（ID 0）匹配8（ID 4），再把5切换回顶部
+    const int cardIds[] = { 2, 0, 4, 2 };
+    const InputOp ops[] = { IO_PLAYFIELD_CLICK, IO_HAND_CLICK, IO_PLAYFIELD_CLICK, IO_HAND_CLICK };
+    for (int i = 0; i < 4; ++i) {
+        CHECK(GameService::applyInput(&model, &undoManager, ops[i], cardIds[i]));
+        CHECK(matchesState(model.state));
+    }
+    while (undoManager.undo()) {
+        CHECK(matchesState(model.state));
+    }
+    CHECK(model.state.playfieldCount() == 4);
+    CHECK(model.state.faceIndex.playfieldCounts[CFT_FIVE] == 2);
+}
@@ -0,0 +1,68 @@
+﻿/**
+ * @file GameContextTests.cpp
+ * @brief 每局游戏独立的游戏上下文
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "managers/GameContext.h"
+#include "services/GameService.h"
+
+TEST_CASE(game_context, contexts_are_independent) {
+    GameContext first(11);
+    GameContext second(11);
+    REQUIRE(first.loadLevel(TestLevels::makeWinnableLevel(), 1));
+    REQUIRE(second.loadLevel(TestLevels::makeWinnableLevel(), 2));
+    CHECK(first.getModel().currentLevel == 1);
+    CHECK(second.getModel().currentLevel == 2);
+
+    REQUIRE(GameService::applyInput(&first.getModel(), &first.getUndoManager(), IO_PLAYFIELD_CLICK, 2));
+    CHECK(first.getModel().state.playfieldCount() == 2);
+    CHECK(second.getModel().state.playfieldCount() == 3);
+    CHECK(first.getUndoManager().canUndo());
+    CHECK(!second.getUndoManager().canUndo());
+
+    // 同一种子的随机数序列相同，互不消耗
+    uint32_t value = first.getRandom()();
+    CHECK(second.getRandom()() == value);
+    first.getRandom()();
+    first.resetRandom();
+    CHECK(first.getRandom()() == value);
+}
+
+TEST_CASE(game_context, load_level_resets_history) {
+    GameContext context(5);
+    REQUIRE(context.loadLevel(TestLevels::makeWinnableLevel(), 1));
+    REQUIRE(GameService::applyInput(&context.getModel(), &context.getUndoManager(), IO_PLAYFIELD_CLICK, 2));
+    CHECK(context.getModel().getScore() > 0);
+
+    REQUIRE(context.loadLevel(context.getLevelConfig(), 1));
+    CHECK(context.getModel().getScore() == 0);
+    CHECK(context.getModel().state.playfieldCount() == 3);
+    CHECK(!context.getUndoManager().canUndo());
+    CHECK(context.getScoringEngine().getTotalScore() == 0);
+}
+
+TEST_CASE(game_context, adopt_level_keeps_rule_set) {
+    // 预取线程加载好的关卡
+    LevelConfig prefetched = TestLevels::makeWinnableLevel(RST_WRAPAROUND);
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, prefetched));
+    model.currentLevel = 3;
+
+    GameContext context(5);
+    context.adoptLevel(prefetched, model);
+    CHECK(context.getLevelConfig().ruleSet == RST_WRAPAROUND);
+    CHECK(context.getLevelConfig().playfield.size() == 3);
+    CHECK(context.getModel().currentLevel == 3);
+
+    // 接管后的撤销管理器作用于上下文自己的模型
+    REQUIRE(GameService::applyInput(&context.getModel(), &context.getUndoManager(), IO_PLAYFIELD_CLICK, 2));
+    CHECK(model.state.playfieldCount() == 3);
+    CHECK(context.getUndoManager().undo());
+    CHECK(context.getModel().computeStateHash() == model.computeStateHash());
+
+    // 重新开始时按保存的配置加载，仍是首尾相接规则
+    REQUIRE(context.loadLevel(context.getLevelConfig(), 3));
+    CHECK(context.getModel().state.ruleSet == RST_WRAPAROUND);
+}
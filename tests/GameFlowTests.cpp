@@ -0,0 +1,68 @@
+﻿/**
+ * @file GameFlowTests.cpp
+ * @brief 不依赖cocos2d-x的完整对局流程
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "services/GameService.h"
+#include "managers/UndoManager.h"
+
+TEST_CASE(game_flow, play_to_win) {
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    REQUIRE(undoManager.init(&model));
+    CHECK(model.state.handCount == 2);
+    CHECK(model.state.playfieldCount() == 3);
+    CHECK(model.state.topHandId() == 1);
+
+    CHECK(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 2));
+    CHECK(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 3));
+    CHECK(!model.isGameOver);
+    CHECK(GameService::applyInput(&model, &undoManager, IO_HAND_CLICK, 0));
+    CHECK(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 4));
+
+    CHECK(model.state.playfield.empty());
+    CHECK(model.isGameOver);
+    CHECK(model.isGameWon);
+    // 2和3各得10分，Q为人头牌另加5分
+    CHECK(model.getScore() == 35);
+}
+
+TEST_CASE(game_flow, rejected_match_leaves_state) {
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    uint64_t hash = model.computeStateHash();
+
+    // 顶部手牌A与3相差2，经典规则下不能匹配
+    MoveRecord record;
+    CHECK(!GameService::applyInput(&model, nullptr, IO_PLAYFIELD_CLICK, 3, &record));
+    CHECK(!GameService::applyInput(&model, nullptr, IO_HAND_CLICK, 3));
+    CHECK(model.computeStateHash() == hash);
+    CHECK(model.state.playfield.contains(3));
+    CHECK(model.getScore() == 0);
+}
+
+TEST_CASE(game_flow, dead_end_loses) {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    level.playfield.push_back(TestLevels::card(CFT_SEVEN, CST_CLUBS));
+
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+    CHECK(GameService::updateGameEndState(&model) == -1);
+    CHECK(model.isGameOver);
+    CHECK(!model.isGameWon);
+
+    // 结束后的点击一律忽略
+    CHECK(!GameService::applyInput(&model, nullptr, IO_HAND_CLICK, 0));
+}
+
+TEST_CASE(game_flow, invalid_rule_set_falls_back_to_classic) {
+    LevelConfig level = TestLevels::makeWinnableLevel(RST_NUM_RULE_SET_TYPES);
+    GameModel model;
+    CHECK(!GameService::loadLevel(&model, level));
+    CHECK(model.state.ruleSet == RST_CLASSIC);
+    CHECK(model.state.playfieldCount() == 3);
+}
@@ -0,0 +1,65 @@
+﻿/**
+ * @file HintTests.cpp
+ * @brief 有界前瞻的提示计算
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "managers/HintCache.h"
+#include "services/GameService.h"
+
+TEST_CASE(hint, prefers_the_winning_line) {
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+
+    // 先匹配2、3再切换到K才能清空；先切换到K会让A无处可用
+    HintCache cache(10);
+    HintMove hint;
+    REQUIRE(GameService::computeHint(model.state, cache, hint));
+    CHECK(hint.isValid());
+    CHECK(hint.handCardId == -1);
+    CHECK(hint.playfieldCardId == 2);
+    CHECK(hint.depth == HintOptions::DEFAULT_MAX_DEPTH);
+
+    // 快照上的计算与模型上的计算一致，第二次命中缓存
+    uint64_t hits = cache.getHits();
+    HintMove fromModel;
+    REQUIRE(GameService::computeHint(&model, cache, fromModel));
+    CHECK(fromModel.playfieldCardId == hint.playfieldCardId);
+    CHECK(fromModel.value == hint.value);
+    CHECK(cache.getHits() > hits);
+}
+
+TEST_CASE(hint, names_the_hand_card_to_switch) {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_FIVE, CST_CLUBS));
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    level.playfield.push_back(TestLevels::card(CFT_SIX, CST_SPADES));
+
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+    HintCache cache(10);
+    HintMove hint;
+    REQUIRE(GameService::computeHint(model.state, cache, hint));
+    CHECK(hint.handCardId == 0);
+    CHECK(hint.playfieldCardId == 2);
+}
+
+TEST_CASE(hint, no_move_no_hint) {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    level.playfield.push_back(TestLevels::card(CFT_SEVEN, CST_CLUBS));
+
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+    HintCache cache(10);
+    HintMove hint;
+    CHECK(!GameService::computeHint(model.state, cache, hint));
+    CHECK(!hint.isValid());
+
+    // 对局结束后不再给出提示
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    model.isGameOver = true;
+    CHECK(!GameService::computeHint(&model, cache, hint));
+    CHECK(!hint.isValid());
+}
@@ -0,0 +1,81 @@
+﻿/**
+ * @file LevelGenerationTests.cpp
+ * @brief 保证可解的关卡生成
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "services/LevelGenerationService.h"
+#include "services/GameService.h"
+#include "solver/LevelSolver.h"
+
+namespace {
+
+const int LAYOUT_PLAYFIELD = 12;    ///< 模板的牌桌卡牌数
+const int SEEDS = 20;               ///< 测试的随机种子数
+
+LevelConfig makeLayout() {
+    LevelConfig layout;
+    for (int i = 0; i < LAYOUT_PLAYFIELD; ++i) {
+        layout.playfield.push_back(TestLevels::card(CFT_ACE, CST_CLUBS, 50.0f * i, 300.0f + 10.0f * i));
+    }
+    for (int i = 0; i < 3; ++i) {
+        layout.stack.push_back(TestLevels::card(CFT_ACE, CST_CLUBS, 20.0f * i, 80.0f));
+    }
+    return layout;
+}
+
+} // namespace
+
+TEST_CASE(level_generation, generated_levels_are_solvable) {
+    LevelConfig layout = makeLayout();
+    LevelGenerationParams params;
+    params.switchChance = 0.5f;
+    SolverOptions options;
+    options.threadCount = 1;
+    options.tableSizeLog2 = 14;
+    LevelSolver solver(options);
+
+    for (uint32_t seed = 1; seed <= SEEDS; ++seed) {
+        LevelGenerationService::Random random(seed);
+        LevelConfig level;
+        LevelGenerationService::generateLevel(layout, params, random, level);
+        REQUIRE(level.playfield.size() == layout.playfield.size());
+        REQUIRE(level.stack.size() == layout.stack.size());
+        for (size_t i = 0; i < level.playfield.size(); ++i) {
+            CHECK(level.playfield[i].position.x == layout.playfield[i].position.x);
+            CHECK(level.playfield[i].position.y == layout.playfield[i].position.y);
+        }
+
+        GameModel model;
+        REQUIRE(GameService::loadLevel(&model, level));
+        SolverResult result = solver.solve(model);
+        CHECK(result.solvable);
+        CHECK(result.complete);
+    }
+}
+
+TEST_CASE(level_generation, same_seed_same_level) {
+    LevelConfig layout = makeLayout();
+    LevelGenerationParams params;
+    params.stackCount = 5;
+
+    LevelConfig first;
+    LevelConfig second;
+    LevelGenerationService::Random firstRandom(99);
+    LevelGenerationService::Random secondRandom(99);
+    LevelGenerationService::generateLevel(layout, params, firstRandom, first);
+    LevelGenerationService::generateLevel(layout, params, secondRandom, second);
+
+    // 手牌数量多于模板时沿用模板最后一张手牌的位置
+    REQUIRE(first.stack.size() == 5);
+    CHECK(first.stack[4].position.x == layout.stack[2].position.x);
+    REQUIRE(first.playfield.size() == second.playfield.size());
+    for (size_t i = 0; i < first.playfield.size(); ++i) {
+        CHECK(first.playfield[i].cardFace == second.playfield[i].cardFace);
+        CHECK(first.playfield[i].cardSuit == second.playfield[i].cardSuit);
+    }
+    for (size_t i = 0; i < first.stack.size(); ++i) {
+        CHECK(first.stack[i].cardFace == second.stack[i].cardFace);
+    }
+}
@@ -0,0 +1,224 @@
+﻿/**
+ * @file LevelPackTests.cpp
+ * @brief 二进制关卡包的编码和校验
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "configs/LevelPack.h"
+#include "configs/LevelParser.h"
+#include "services/GameService.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 两个关卡：经典规则的可清空关卡和首尾相接规则的单牌关卡
+ */
+std::vector<LevelConfig> makeLevels() {
+    std::vector<LevelConfig> levels;
+    levels.push_back(TestLevels::makeWinnableLevel());
+    LevelConfig wrap;
+    wrap.ruleSet = RST_WRAPAROUND;
+    wrap.stack.push_back(TestLevels::card(CFT_KING, CST_SPADES, 12.25f, -40.5f));
+    wrap.playfield.push_back(TestLevels::card(CFT_ACE, CST_HEARTS, -300.75f, 812.0f));
+    levels.push_back(wrap);
+    return levels;
+}
+
+LevelPackHeader readHeader(const std::vector<uint8_t>& data) {
+    LevelPackHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    return header;
+}
+
+void writeHeader(std::vector<uint8_t>& data, const LevelPackHeader& header) {
+    std::memcpy(data.data(), &header, sizeof(header));
+}
+
+LevelPackEntry* entryAt(std::vector<uint8_t>& data, int index) {
+    return reinterpret_cast<LevelPackEntry*>(data.data() + readHeader(data).indexOffset) + index;
+}
+
+/**
+ * @brief 打开应当失败，并给出原因
+ */
+bool rejects(const std::vector<uint8_t>& data) {
+    LevelPack pack;
+    std::string error;
+    return !pack.openMemory(data.data(), data.size(), &error) && !error.empty() && !pack.isOpen();
+}
+
+} // namespace
+
+TEST_CASE(level_pack, round_trip) {
+    std::vector<LevelConfig> levels = makeLevels();
+    std::vector<uint8_t> data;
+    std::string error;
+    REQUIRE(LevelPack::build(levels, data, &error));
+
+    LevelPack pack;
+    REQUIRE(pack.openMemory(data.data(), data.size(), &error));
+    REQUIRE(pack.getLevelCount() == 2);
+    for (int i = 0; i < pack.getLevelCount(); ++i) {
+        LevelConfig decoded;
+        REQUIRE(pack.decodeLevel(i, decoded));
+        CHECK(decoded.ruleSet == levels[i].ruleSet);
+        REQUIRE(decoded.stack.size() == levels[i].stack.size());
+        REQUIRE(decoded.playfield.size() == levels[i].playfield.size());
+        for (size_t c = 0; c < decoded.playfield.size(); ++c) {
+            CHECK(decoded.playfield[c].cardFace == levels[i].playfield[c].cardFace);
+            CHECK(decoded.playfield[c].cardSuit == levels[i].playfield[c].cardSuit);
+            // 坐标按四分之一像素量化，测试坐标都能精确表示
+            CHECK(decoded.playfield[c].position.x == levels[i].playfield[c].position.x);
+            CHECK(decoded.playfield[c].position.y == levels[i].playfield[c].position.y);
+        }
+
+        // 直接从关卡包加载与从配置加载得到相同的状态
+        GameModel fromPack;
+        GameModel fromConfig;
+        REQUIRE(GameService::loadLevel(&fromPack, pack, i));
+        REQUIRE(GameService::loadLevel(&fromConfig, levels[i]));
+        CHECK(fromPack.computeStateHash() == fromConfig.computeStateHash());
+    }
+    GameModel model;
+    CHECK(!GameService::loadLevel(&model, pack, 2));
+}
+
+TEST_CASE(level_pack, open_file) {
+    std::vector<uint8_t> data;
+    REQUIRE(LevelPack::build(makeLevels(), data));
+    std::string path = TestRegistry::getTempPath("levels.cglp");
+    FILE* file = std::fopen(path.c_str(), "wb");
+    REQUIRE(file);
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+
+    LevelPack pack;
+    std::string error;
+    CHECK(pack.openFile(path, &error));
+    CHECK(pack.getLevelCount() == 2);
+    CHECK(pack.getEntry(1).ruleSet == RST_WRAPAROUND);
+    pack.close();
+    CHECK(!pack.isOpen());
+    std::remove(path.c_str());
+
+    CHECK(!pack.openFile(path, &error));
+    CHECK(!error.empty());
+}
+
+TEST_CASE(level_pack, rejects_bad_headers) {
+    std::vector<uint8_t> valid;
+    REQUIRE(LevelPack::build(makeLevels(), valid));
+
+    std::vector<uint8_t> data(valid.begin(), valid.begin() + sizeof(LevelPackHeader) - 1);
+    CHECK(rejects(data));
+
+    data = valid;
+    LevelPackHeader header = readHeader(valid);
+    header.magic ^= 1;
+    writeHeader(data, header);
+    CHECK(rejects(data));
+
+    header = readHeader(valid);
+    header.version = LevelPack::VERSION + 1;
+    writeHeader(data, header);
+    CHECK(rejects(data));
+
+    header = readHeader(valid);
+    header.positionScale = 0;
+    writeHeader(data, header);
+    CHECK(rejects(data));
+
+    // 计数超出文件长度，包括乘法在32位下会溢出的计数
+    header = readHeader(valid);
+    header.cardCount += 1;
+    writeHeader(data, header);
+    CHECK(rejects(data));
+    header = readHeader(valid);
+    header.levelCount = 0x80000000u;
+    writeHeader(data, header);
+    CHECK(rejects(data));
+
+    header = readHeader(valid);
+    header.indexOffset = 2;
+    writeHeader(data, header);
+    CHECK(rejects(data));
+
+    // 未对齐的内存
+    data.assign(valid.size() + 1, 0);
+    std::memcpy(data.data() + 1, valid.data(), valid.size());
+    LevelPack pack;
+    std::string error;
+    CHECK(!pack.openMemory(data.data() + 1, valid.size(), &error));
+    CHECK(!error.empty());
+}
+
+TEST_CASE(level_pack, rejects_bad_entries) {
+    std::vector<uint8_t> valid;
+    REQUIRE(LevelPack::build(makeLevels(), valid));
+
+    std::vector<uint8_t> data = valid;
+    entryAt(data, 1)->playfieldCount += 1;
+    CHECK(rejects(data));
+
+    data = valid;
+    entryAt(data, 0)->firstCard = 0xFFFFFFF0u;
+    CHECK(rejects(data));
+
+    data = valid;
+    entryAt(data, 1)->ruleSet = RST_NUM_RULE_SET_TYPES;
+    CHECK(rejects(data));
+}
+
+TEST_CASE(level_pack, build_rejects_unpackable_levels) {
+    std::vector<uint8_t> data;
+    std::string error;
+
+    std::vector<LevelConfig> levels = makeLevels();
+    levels[0].ruleSet = -1;
+    CHECK(!LevelPack::build(levels, data, &error));
+    CHECK(!error.empty());
+
+    levels = makeLevels();
+    levels[1].playfield[0].position.x = 100000.0f;
+    CHECK(!LevelPack::build(levels, data));
+
+    levels = makeLevels();
+    levels[1].stack[0].cardSuit = CST_NONE;
+    CHECK(!LevelPack::build(levels, data));
+
+    levels = makeLevels();
+    levels[0].playfield.resize(300, TestLevels::card(CFT_TWO, CST_CLUBS));
+    CHECK(!LevelPack::build(levels, data));
+}
+
+TEST_CASE(level_pack, shipped_pack_matches_json) {
+    // 应用从Resources/levels读取的关卡包须与关卡JSON保持同步
+    LevelPack pack;
+    std::string error;
+    REQUIRE(pack.openFile(CARDGAME_TEST_RESOURCES_DIR "/levels/levels.cglp", &error));
+    REQUIRE(pack.getLevelCount() >= 1);
+
+    std::ifstream file(CARDGAME_TEST_RESOURCES_DIR "/levels/level1.json", std::ios::binary);
+    REQUIRE(file.good());
+    std::stringstream json;
+    json << file.rdbuf();
+    LevelConfig level;
+    REQUIRE(LevelParser::parse(json.str(), level, &error));
+
+    GameModel fromPack;
+    GameModel fromJson;
+    REQUIRE(GameService::loadLevel(&fromPack, pack, 0));
+    REQUIRE(GameService::loadLevel(&fromJson, level));
+    CHECK(fromPack.computeStateHash() == fromJson.computeStateHash());
+    for (int cardId = 0; cardId < fromJson.layout.cardCount; ++cardId) {
+        CHECK(fromPack.layout.positions[cardId].x == fromJson.layout.positions[cardId].x);
+        CHECK(fromPack.layout.positions[cardId].y == fromJson.layout.positions[cardId].y);
+    }
+}
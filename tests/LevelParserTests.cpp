@@ -0,0 +1,115 @@
+﻿/**
+ * @file LevelParserTests.cpp
+ * @brief 关卡JSON的单遍结构校验和错误位置
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "configs/LevelParser.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 分别以复制和原位方式解析，两者的结果和错误信息须一致
+ *
+ * @return 解析成功返回true
+ */
+bool parseBoth(const std::string& json, LevelConfig& level, std::string& error) {
+    std::string copyError;
+    bool parsed = LevelParser::parse(json, level, &copyError);
+
+    std::vector<char> buffer(json.begin(), json.end());
+    buffer.push_back('\0');
+    LevelConfig insituLevel;
+    std::string insituError;
+    bool insituParsed = LevelParser::parseInsitu(buffer.data(), insituLevel, &insituError);
+
+    error = copyError;
+    if (insituParsed != parsed || insituError != copyError) {
+        error = "parse and parseInsitu disagree: " + copyError + " / " + insituError;
+        return !parsed;
+    }
+    return parsed;
+}
+
+/**
+ * @brief 解析应失败并给出指定的错误信息
+ */
+bool failsWith(const std::string& json, const std::string& expected) {
+    LevelConfig level;
+    std::string error;
+    return !parseBoth(json, level, error) && error == expected;
+}
+
+} // namespace
+
+TEST_CASE(level_parser, accepts_valid_level) {
+    const std::string json =
+        "{\n"
+        "  \"Rules\": \"wraparound\",\n"
+        "  \"Future\": {\"a\": [1, {\"b\": null}], \"c\": \"skip\"},\n"
+        "  \"Playfield\": [\n"
+        "    {\"CardFace\": 0, \"CardSuit\": 3, \"Position\": {\"x\": 250.5, \"y\": -12}},\n"
+        "    {\"CardSuit\": 1, \"CardFace\": 12}\n"
+        "  ],\n"
+        "  \"Stack\": [{\"CardFace\": 6, \"CardSuit\": 2}]\n"
+        "}\n";
+    LevelConfig level;
+    std::string error;
+    REQUIRE(parseBoth(json, level, error));
+    CHECK(level.ruleSet == RST_WRAPAROUND);
+    REQUIRE(level.playfield.size() == 2);
+    REQUIRE(level.stack.size() == 1);
+    CHECK(level.playfield[0].cardFace == CFT_ACE && level.playfield[0].cardSuit == CST_SPADES);
+    CHECK(level.playfield[0].position.x == 250.5f && level.playfield[0].position.y == -12.0f);
+    CHECK(level.playfield[1].cardFace == CFT_KING && level.playfield[1].cardSuit == CST_DIAMONDS);
+    CHECK(level.stack[0].cardFace == CFT_SEVEN);
+}
+
+TEST_CASE(level_parser, schema_errors_name_field_line_and_column) {
+    CHECK(failsWith("{\n  \"Playfield\": [\n    {\"CardFace\": 13, \"CardSuit\": 0}\n  ]\n}",
+                    "line 3, column 20: Playfield[0].CardFace: face 13 is out of range 0-12"));
+    CHECK(failsWith("{\n  \"Stack\": [\n    {\"CardFace\": 1}\n  ]\n}",
+                    "line 3, column 20: Stack[0]: missing CardSuit"));
+    CHECK(failsWith("{\n  \"Playfield\": [\n    {\"CardFace\": 1, \"CardSuit\": 2, \"Position\": {\"x\": \"a\", \"y\": 0}}\n  ]\n}",
+                    "line 3, column 57: Playfield[0].Position.x: expected a number, found a string"));
+    CHECK(failsWith("{\n  \"Playfield\": [\n    {\"CardFace\": 1.5, \"CardSuit\": 2}\n  ]\n}",
+                    "line 3, column 21: Playfield[0].CardFace: expected an integer, found a non-integer number"));
+    CHECK(failsWith("{\n  \"Rules\": \"chess\"\n}",
+                    "line 2, column 19: Rules: unknown rule set \"chess\""));
+    CHECK(failsWith("[1]", "line 1, column 2: the root must be an object, found an array"));
+    CHECK(failsWith("{\"Playfield\": [], \"Playfield\": []}", "line 1, column 30: Playfield: duplicate key"));
+}
+
+TEST_CASE(level_parser, syntax_errors_have_position) {
+    CHECK(failsWith("{\n  \"Playfield\": [\n    {\"CardFace\": 1,, \"CardSuit\": 2}\n  ]\n}",
+                    "line 3, column 20: Missing a name for object member."));
+
+    // 第二张卡牌出错时下标为1
+    LevelConfig level;
+    std::string error;
+    CHECK(!parseBoth("{\"Stack\": [{\"CardFace\": 1, \"CardSuit\": 1}, {\"CardFace\": 2, \"CardSuit\": 9}]}",
+                     level, error));
+    CHECK(error.find("Stack[1].CardSuit") != std::string::npos);
+    CHECK(error.compare(0, 8, "line 1, ") == 0);
+}
+
+TEST_CASE(level_parser, serialize_round_trip) {
+    LevelConfig level = TestLevels::makeWinnableLevel(RST_BONUS);
+    std::string json;
+    LevelParser::serialize(level, json);
+
+    LevelConfig parsed;
+    std::string error;
+    REQUIRE(parseBoth(json, parsed, error));
+    CHECK(parsed.ruleSet == RST_BONUS);
+    REQUIRE(parsed.playfield.size() == level.playfield.size());
+    REQUIRE(parsed.stack.size() == level.stack.size());
+    for (size_t i = 0; i < level.playfield.size(); ++i) {
+        CHECK(parsed.playfield[i].cardFace == level.playfield[i].cardFace);
+        CHECK(parsed.playfield[i].cardSuit == level.playfield[i].cardSuit);
+        CHECK(parsed.playfield[i].position.x == level.playfield[i].position.x);
+    }
+}
@@ -0,0 +1,178 @@
+﻿/**
+ * @file MoveLogTests.cpp
+ * @brief 操作日志的恢复、截断和文件头校验
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "managers/MoveLog.h"
+#include "managers/UndoManager.h"
+#include "services/GameService.h"
+#include <cstdio>
+#include <string>
+
+namespace {
+
+const int LEVEL_ID = 7;         ///< 测试日志的关卡ID
+const uint32_t SEED = 1234;     ///< 测试日志的随机种子
+
+/**
+ * @brief 顶部手牌A之后牌桌为2到5的顺子，ID 2到5
+ */
+LevelConfig makeLevel() {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_KING, CST_CLUBS));
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    for (int i = 0; i < 4; ++i) {
+        level.playfield.push_back(TestLevels::card(static_cast<CardFaceType>(CFT_TWO + i), CST_SPADES));
+    }
+    return level;
+}
+
+/**
+ * @brief 把日志条目经GameService应用到对局
+ */
+bool applyEntry(GameModel& model, UndoManager& undoManager, const MoveLogEntry& entry) {
+    switch (entry.op) {
+        case MLO_HAND_REPLACE:
+            return GameService::applyInput(&model, &undoManager, IO_HAND_CLICK, entry.cardId);
+        case MLO_PLAYFIELD_MATCH:
+            return GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, entry.cardId);
+        case MLO_UNDO:
+            return GameService::applyInput(&model, &undoManager, IO_UNDO, 0);
+        case MLO_REDO:
+            return GameService::applyInput(&model, &undoManager, IO_REDO, 0);
+        default:
+            return false;
+    }
+}
+
+long getFileSize(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return -1;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+}
+
+bool appendBytes(const std::string& path, const void* data, size_t size) {
+    FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        return false;
+    }
+    bool written = std::fwrite(data, 1, size, file) == size;
+    std::fclose(file);
+    return written;
+}
+
+} // namespace
+
+TEST_CASE(move_log, resume_after_torn_tail) {
+    std::string path = TestRegistry::getTempPath("session.cglog");
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, makeLevel()));
+    REQUIRE(undoManager.init(&model));
+    {
+        MoveLog log;
+        REQUIRE(log.startSession(path, LEVEL_ID, SEED));
+        REQUIRE(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 2));
+        log.append(MLO_PLAYFIELD_MATCH, 2);
+        REQUIRE(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 3));
+        log.append(MLO_PLAYFIELD_MATCH, 3);
+        REQUIRE(GameService::applyInput(&model, &undoManager, IO_UNDO, 0));
+        log.append(MLO_UNDO, 0);
+        CHECK(log.hasPendingWrites());
+        log.close();
+    }
+    uint64_t expectedHash = model.computeStateHash();
+
+    // 进程在写第四个条目时被杀死，只留下一个字节
+    const uint8_t tornByte = MLO_PLAYFIELD_MATCH;
+    REQUIRE(appendBytes(path, &tornByte, 1));
+    REQUIRE(getFileSize(path) == static_cast<long>(sizeof(MoveLogHeader) + 3 * sizeof(MoveLogEntry) + 1));
+
+    GameModel resumed;
+    UndoManager resumedUndo;
+    REQUIRE(GameService::loadLevel(&resumed, makeLevel()));
+    REQUIRE(resumedUndo.init(&resumed));
+    MoveLog log;
+    std::string error;
+    REQUIRE(log.resumeSession(path, LEVEL_ID, SEED, [&](const MoveLogEntry& entry) {
+        return applyEntry(resumed, resumedUndo, entry);
+    }, &error));
+    CHECK(log.getEntryCount() == 3);
+    CHECK(log.getDroppedEntryCount() == 0);
+    CHECK(resumed.computeStateHash() == expectedHash);
+    // 撤销历史也一并恢复
+    CHECK(resumedUndo.canRedo());
+
+    // 不完整的条目被截掉，之后的追加从条目边界开始
+    CHECK(getFileSize(path) == static_cast<long>(sizeof(MoveLogHeader) + 3 * sizeof(MoveLogEntry)));
+    log.append(MLO_REDO, 0);
+    log.close();
+    CHECK(getFileSize(path) == static_cast<long>(sizeof(MoveLogHeader) + 4 * sizeof(MoveLogEntry)));
+    std::remove(path.c_str());
+}
+
+TEST_CASE(move_log, rejected_entry_truncates) {
+    std::string path = TestRegistry::getTempPath("session.cglog");
+    {
+        MoveLog log;
+        REQUIRE(log.startSession(path, LEVEL_ID, SEED));
+        log.append(MLO_PLAYFIELD_MATCH, 2);
+        // 顶部手牌为2，不能匹配5
+        log.append(MLO_PLAYFIELD_MATCH, 5);
+        log.append(MLO_PLAYFIELD_MATCH, 3);
+        log.close();
+    }
+
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, makeLevel()));
+    REQUIRE(undoManager.init(&model));
+    MoveLog log;
+    REQUIRE(log.resumeSession(path, LEVEL_ID, SEED, [&](const MoveLogEntry& entry) {
+        return applyEntry(model, undoManager, entry);
+    }));
+    CHECK(log.getEntryCount() == 1);
+    CHECK(log.getDroppedEntryCount() == 2);
+    CHECK(model.state.playfieldCount() == 3);
+    log.close();
+    CHECK(getFileSize(path) == static_cast<long>(sizeof(MoveLogHeader) + sizeof(MoveLogEntry)));
+    std::remove(path.c_str());
+}
+
+TEST_CASE(move_log, header_must_match) {
+    std::string path = TestRegistry::getTempPath("session.cglog");
+    {
+        MoveLog log;
+        REQUIRE(log.startSession(path, LEVEL_ID, SEED));
+    }
+
+    MoveLogHeader header;
+    REQUIRE(MoveLog::readHeader(path, header));
+    CHECK(header.levelId == LEVEL_ID);
+    CHECK(header.seed == SEED);
+
+    int replayed = 0;
+    MoveLog log;
+    std::string error;
+    CHECK(!log.resumeSession(path, LEVEL_ID, SEED + 1, [&](const MoveLogEntry&) {
+        return ++replayed > 0;
+    }, &error));
+    CHECK(!error.empty());
+    CHECK(replayed == 0);
+    CHECK(!log.isOpen());
+
+    // 文件标识被破坏时不再识别为日志
+    std::remove(path.c_str());
+    const char garbage[sizeof(MoveLogHeader)] = "not a move log";
+    REQUIRE(appendBytes(path, garbage, sizeof(garbage)));
+    CHECK(!MoveLog::readHeader(path, header));
+    CHECK(!MoveLog::readHeader(TestRegistry::getTempPath("missing.cglog"), header));
+    std::remove(path.c_str());
+}
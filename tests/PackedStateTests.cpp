@@ -0,0 +1,66 @@
+﻿/**
+ * @file PackedStateTests.cpp
+ * @brief 打包游戏状态的编码、复制与导出
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "models/GameModel.h"
+#include "services/GameService.h"
+#include <cstring>
+#include <vector>
+
+TEST_CASE(packed_state, card_round_trip) {
+    for (int suit = 0; suit < CST_NUM_CARD_SUIT_TYPES; ++suit) {
+        for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face) {
+            PackedCard card = PackedCard::make(static_cast<CardFaceType>(face), static_cast<CardSuitType>(suit));
+            CHECK(card.face() == face);
+            CHECK(card.suit() == suit);
+        }
+    }
+}
+
+TEST_CASE(packed_state, memcpy_copy_plays_identically) {
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+
+    // 核心状态是平凡可复制的，逐字节复制后在副本上走子不影响原状态
+    PackedGameState copy;
+    std::memcpy(&copy, &model.state, sizeof(copy));
+    CHECK(GameService::executePlayfieldCardMatch(copy, 2));
+    CHECK(copy.playfieldCount() == 2);
+    CHECK(model.state.playfieldCount() == 3);
+
+    CHECK(GameService::executePlayfieldCardMatch(model.state, 2));
+    CHECK(std::memcmp(copy.handCards, model.state.handCards, sizeof(copy.handCards[0]) * copy.handCount) == 0);
+    CHECK(copy.topHandId() == model.state.topHandId());
+    CHECK(copy.score == model.state.score);
+}
+
+TEST_CASE(packed_state, export_keeps_ids_and_positions) {
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    REQUIRE(model.removePlayfieldCard(3));
+
+    std::vector<CardModel> hand;
+    model.exportHandCards(hand);
+    REQUIRE(hand.size() == 2);
+    CHECK(hand[0].id == 0 && hand[0].face == CFT_KING && hand[0].suit == CST_CLUBS);
+    CHECK(hand[1].id == 1 && hand[1].face == CFT_ACE && hand[1].suit == CST_HEARTS);
+
+    // 牌桌按卡牌ID顺序导出，已移除的卡牌不再出现
+    std::vector<CardModel> playfield;
+    model.exportPlayfieldCards(playfield);
+    REQUIRE(playfield.size() == 2);
+    CHECK(playfield[0].id == 2 && playfield[0].face == CFT_TWO);
+    CHECK(playfield[1].id == 4 && playfield[1].face == CFT_QUEEN);
+    CHECK(playfield[1].position.x == 300.0f && playfield[1].position.y == 400.0f);
+}
+
+TEST_CASE(packed_state, rejects_invalid_cards) {
+    GameModel model;
+    CHECK(model.addHandCard(CFT_NONE, CST_CLUBS) < 0);
+    CHECK(model.addPlayfieldCard(CFT_ACE, CST_NUM_CARD_SUIT_TYPES, GameVec2()) < 0);
+    CHECK(model.state.handCount == 0);
+    CHECK(model.layout.cardCount == 0);
+}
@@ -0,0 +1,78 @@
+﻿/**
+ * @file PlayoutTests.cpp
+ * @brief 蒙特卡洛模拟对局
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "services/PlayoutService.h"
+#include "services/GameService.h"
+
+namespace {
+
+const int PLAYOUTS = 200;   ///< 每组测试的模拟局数
+
+} // namespace
+
+TEST_CASE(playouts, forced_line_always_wins) {
+    // 手牌K无处可用，A只能依次匹配2到5
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_KING, CST_CLUBS));
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    for (int i = 0; i < 4; ++i) {
+        level.playfield.push_back(TestLevels::card(static_cast<CardFaceType>(CFT_TWO + i), CST_SPADES));
+    }
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+
+    const PlayoutPolicy policies[] = { PP_RANDOM, PP_GREEDY };
+    for (PlayoutPolicy policy : policies) {
+        PlayoutStats stats;
+        PlayoutService::runPlayouts(model.state, policy, PLAYOUTS, 1, stats);
+        CHECK(stats.playouts == PLAYOUTS);
+        CHECK(stats.wins == PLAYOUTS);
+        CHECK(stats.winMoves == 4u * PLAYOUTS);
+        CHECK(stats.deadEndMoves == 0);
+    }
+}
+
+TEST_CASE(playouts, dead_end_never_wins) {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    level.playfield.push_back(TestLevels::card(CFT_TWO, CST_CLUBS));
+    level.playfield.push_back(TestLevels::card(CFT_NINE, CST_CLUBS));
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+
+    PlayoutService::Random random(3);
+    PlayoutResult result = PlayoutService::runPlayout(model.state, PP_RANDOM, random);
+    CHECK(!result.won);
+    CHECK(result.moves == 1);
+    CHECK(result.cardsLeft == 1);
+    // 模拟在副本上进行
+    CHECK(model.state.playfieldCount() == 2);
+
+    PlayoutStats stats;
+    PlayoutService::runPlayouts(model.state, PP_GREEDY, PLAYOUTS, 3, stats);
+    CHECK(stats.wins == 0);
+    CHECK(stats.deadEndCardsLeft == static_cast<uint64_t>(PLAYOUTS));
+}
+
+TEST_CASE(playouts, same_seed_same_stats) {
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+
+    PlayoutStats first;
+    PlayoutStats second;
+    PlayoutService::runPlayouts(model.state, PP_RANDOM, PLAYOUTS, 42, first);
+    PlayoutService::runPlayouts(model.state, PP_RANDOM, PLAYOUTS, 42, second);
+    CHECK(first.wins == second.wins);
+    CHECK(first.totalMoves == second.totalMoves);
+    CHECK(first.deadEndCardsLeft == second.deadEndCardsLeft);
+    CHECK(first.totalMoves == first.winMoves + first.deadEndMoves);
+
+    PlayoutStats merged = first;
+    merged.merge(second);
+    CHECK(merged.playouts == 2u * PLAYOUTS);
+    CHECK(merged.wins == 2 * first.wins);
+}
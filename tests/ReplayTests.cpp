@@ -0,0 +1,136 @@
+﻿/**
+ * @file ReplayTests.cpp
+ * @brief 输入录制的编码和回放校验
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "managers/InputRecording.h"
+#include "managers/ScoringEngine.h"
+#include "managers/UndoManager.h"
+#include "services/GameService.h"
+#include "services/ReplayService.h"
+#include <vector>
+
+namespace {
+
+const int FPS = 60;                     ///< 录制帧率
+const uint32_t START_FRAME = 1000;      ///< 开始录制时的全局帧序号
+const uint32_t SEED = 77;               ///< 发牌随机种子
+
+/**
+ * @brief 像GameController一样边玩边录制，得到带结果的录制数据
+ */
+void recordGame(std::vector<uint8_t>& data, uint64_t& finalHash, int32_t& finalScore) {
+    GameModel model;
+    UndoManager undoManager;
+    ScoringEngine scoring;
+    GameService::loadLevel(&model, TestLevels::makeWinnableLevel());
+    undoManager.init(&model);
+    scoring.setClock(FPS, START_FRAME);
+    scoring.reset(model);
+
+    InputRecorder recorder;
+    recorder.begin(InputRecorder::makeHeader(&model, SEED, undoManager.getMaxUndoSteps(), FPS), START_FRAME);
+
+    // 含一次被拒绝的点击和一次撤销、重做
+    struct Step { InputOp op; int cardId; uint32_t frame; };
+    const Step steps[] = {
+        { IO_PLAYFIELD_CLICK, 3, 1030 },
+        { IO_PLAYFIELD_CLICK, 2, 1075 },
+        { IO_UNDO, 0, 1100 },
+        { IO_REDO, 0, 1140 },
+        { IO_PLAYFIELD_CLICK, 3, 1500 },
+        { IO_HAND_CLICK, 0, 3000 },
+        { IO_PLAYFIELD_CLICK, 4, 3010 }
+    };
+    MoveRecord record;
+    for (const Step& step : steps) {
+        bool applied = GameService::applyInput(&model, &undoManager, step.op, step.cardId, &record);
+        scoring.onInput(step.op, applied, record, model, step.frame);
+        recorder.record(step.frame, step.op, step.cardId);
+    }
+
+    finalHash = model.computeStateHash();
+    finalScore = scoring.getTotalScore();
+    recorder.stop();
+    recorder.serialize(finalHash, finalScore, data);
+}
+
+} // namespace
+
+TEST_CASE(replay, recorded_game_verifies) {
+    std::vector<uint8_t> data;
+    uint64_t finalHash = 0;
+    int32_t finalScore = 0;
+    recordGame(data, finalHash, finalScore);
+
+    InputRecording recording;
+    std::string error;
+    REQUIRE(recording.parse(data.data(), data.size(), &error));
+    CHECK(recording.events.size() == 7);
+    CHECK(recording.events[0].frame == 30);
+    CHECK(recording.hasResult);
+    // 完成奖励和时间奖励使总分高于匹配得分
+    CHECK(finalScore > 35);
+
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    ReplayResult result;
+    CHECK(ReplayService::replay(&model, recording, RS_MAX_SPEED, result) == RV_VERIFIED);
+    CHECK(result.appliedInputs == 6);
+    CHECK(result.rejectedInputs == 1);
+    CHECK(result.finalStateHash == finalHash);
+    CHECK(result.finalScore == finalScore);
+    CHECK(model.isGameWon);
+}
+
+TEST_CASE(replay, tampered_results_are_reported) {
+    std::vector<uint8_t> data;
+    uint64_t finalHash = 0;
+    int32_t finalScore = 0;
+    recordGame(data, finalHash, finalScore);
+    InputRecording recording;
+    REQUIRE(recording.parse(data.data(), data.size()));
+
+    GameModel model;
+    ReplayResult result;
+    InputRecording tampered = recording;
+    tampered.finalScore += 1;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    CHECK(ReplayService::replay(&model, tampered, RS_MAX_SPEED, result) == RV_SCORE_MISMATCH);
+
+    tampered = recording;
+    tampered.finalStateHash ^= 1;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    CHECK(ReplayService::replay(&model, tampered, RS_MAX_SPEED, result) == RV_HASH_MISMATCH);
+
+    // 去掉最后一次匹配后牌桌未清空
+    tampered = recording;
+    tampered.events.pop_back();
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    CHECK(ReplayService::replay(&model, tampered, RS_MAX_SPEED, result) != RV_VERIFIED);
+
+    // 其他关卡不回放
+    LevelConfig other = TestLevels::makeWinnableLevel();
+    other.playfield.pop_back();
+    REQUIRE(GameService::loadLevel(&model, other));
+    CHECK(ReplayService::replay(&model, recording, RS_MAX_SPEED, result) == RV_LEVEL_MISMATCH);
+    CHECK(result.appliedInputs == 0);
+}
+
+TEST_CASE(replay, truncated_data_is_malformed) {
+    std::vector<uint8_t> data;
+    uint64_t finalHash = 0;
+    int32_t finalScore = 0;
+    recordGame(data, finalHash, finalScore);
+
+    InputRecording recording;
+    std::string error;
+    CHECK(!recording.parse(data.data(), sizeof(InputRecordingHeader) - 1, &error));
+    CHECK(!error.empty());
+
+    std::vector<uint8_t> corrupt = data;
+    corrupt[0] ^= 0xFF;
+    CHECK(!recording.parse(corrupt.data(), corrupt.size()));
+}
@@ -0,0 +1,112 @@
+﻿/**
+ * @file ReplayValidatorTests.cpp
+ * @brief 多线程批量回放校验
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "ReplayValidator.h"
+#include "services/GameService.h"
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int VALID_SUBMISSIONS = 40;       ///< 有效提交数
+const int TAMPERED_SUBMISSIONS = 7;     ///< 得分被篡改的提交数
+const int GARBAGE_SUBMISSIONS = 3;      ///< 无法解析的提交数
+const int UNKNOWN_SUBMISSIONS = 2;      ///< 关卡不在缓存中的提交数
+
+/**
+ * @brief 录制一局依次匹配到清空的对局
+ *
+ * @param scoreOffset 写入结果时加到真实得分上的偏移，用于伪造提交
+ */
+void recordLevel(const LevelConfig& level, int32_t scoreOffset, std::vector<uint8_t>& data) {
+    GameModel model;
+    UndoManager undoManager;
+    ScoringEngine scoring;
+    GameService::loadLevel(&model, level);
+    undoManager.init(&model);
+    scoring.setClock(ScoringEngine::DEFAULT_FRAMES_PER_SECOND, 0);
+    scoring.reset(model);
+
+    InputRecorder recorder;
+    recorder.begin(InputRecorder::makeHeader(&model, 0, undoManager.getMaxUndoSteps(),
+                                             ScoringEngine::DEFAULT_FRAMES_PER_SECOND), 0);
+    const InputOp ops[] = { IO_PLAYFIELD_CLICK, IO_PLAYFIELD_CLICK, IO_HAND_CLICK, IO_PLAYFIELD_CLICK };
+    const int cardIds[] = { 2, 3, 0, 4 };
+    MoveRecord record;
+    for (int i = 0; i < 4; ++i) {
+        uint32_t frame = 40u * (i + 1);
+        bool applied = GameService::applyInput(&model, &undoManager, ops[i], cardIds[i], &record);
+        scoring.onInput(ops[i], applied, record, model, frame);
+        recorder.record(frame, ops[i], cardIds[i]);
+    }
+    recorder.stop();
+    recorder.serialize(model.computeStateHash(), scoring.getTotalScore() + scoreOffset, data);
+}
+
+void pushSubmission(SubmissionQueue& queue, const std::string& id, const std::vector<uint8_t>& data) {
+    ReplaySubmission submission;
+    submission.id = id;
+    submission.data = data;
+    queue.push(submission);
+}
+
+} // namespace
+
+TEST_CASE(replay_validator, batch_counts_each_verdict) {
+    LevelConfig level = TestLevels::makeWinnableLevel();
+    LevelConfig unknownLevel = TestLevels::makeWinnableLevel(RST_WRAPAROUND);
+    LevelCache levels;
+    REQUIRE(levels.addLevel(level));
+
+    std::vector<uint8_t> valid;
+    std::vector<uint8_t> tampered;
+    std::vector<uint8_t> unknown;
+    recordLevel(level, 0, valid);
+    recordLevel(level, 100, tampered);
+    recordLevel(unknownLevel, 0, unknown);
+    std::vector<uint8_t> garbage(valid.begin(), valid.begin() + 10);
+
+    // 全部提交放得下，关闭后校验线程取完即退出
+    SubmissionQueue queue(64);
+    for (int i = 0; i < VALID_SUBMISSIONS; ++i) {
+        pushSubmission(queue, "valid" + std::to_string(i), valid);
+        if (i < TAMPERED_SUBMISSIONS) {
+            pushSubmission(queue, "tampered" + std::to_string(i), tampered);
+        }
+        if (i < GARBAGE_SUBMISSIONS) {
+            pushSubmission(queue, "garbage" + std::to_string(i), garbage);
+        }
+        if (i < UNKNOWN_SUBMISSIONS) {
+            pushSubmission(queue, "unknown" + std::to_string(i), unknown);
+        }
+    }
+    const int total = VALID_SUBMISSIONS + TAMPERED_SUBMISSIONS + GARBAGE_SUBMISSIONS + UNKNOWN_SUBMISSIONS;
+    queue.close();
+
+    BatchValidationOptions options;
+    options.threadCount = 4;
+    options.batchSize = 3;
+    BatchReplayValidator validator(levels, options);
+    std::set<std::string> ids;
+    bool verdictsMatchIds = true;
+    BatchValidationStats stats = validator.run(queue, [&](const std::vector<ReplayReport>& reports) {
+        for (const ReplayReport& report : reports) {
+            ids.insert(report.id);
+            bool expectVerified = report.id.compare(0, 5, "valid") == 0;
+            verdictsMatchIds &= expectVerified == (report.result.verdict == RV_VERIFIED);
+        }
+    });
+
+    CHECK(stats.replays == static_cast<uint64_t>(total));
+    CHECK(ids.size() == static_cast<size_t>(total));
+    CHECK(verdictsMatchIds);
+    CHECK(stats.verdictCounts[RV_VERIFIED] == VALID_SUBMISSIONS);
+    CHECK(stats.verdictCounts[RV_SCORE_MISMATCH] == TAMPERED_SUBMISSIONS);
+    CHECK(stats.verdictCounts[RV_MALFORMED] == GARBAGE_SUBMISSIONS);
+    CHECK(stats.verdictCounts[RV_LEVEL_MISMATCH] == UNKNOWN_SUBMISSIONS);
+}
@@ -0,0 +1,123 @@
+﻿/**
+ * @file RulePolicyTests.cpp
+ * @brief 各规则集的匹配、计分和结束规则
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "services/GameService.h"
+#include "services/RulePolicies.h"
+
+namespace {
+
+/**
+ * @brief 以指定规则集在顶部手牌上匹配一张牌桌卡牌
+ *
+ * @param scoreDelta 匹配成功时输出得分变化
+ * @return 规则是否允许匹配
+ */
+bool tryMatch(int ruleSet, PackedCard top, PackedCard target, int& scoreDelta) {
+    LevelConfig level;
+    level.ruleSet = ruleSet;
+    level.stack.push_back(TestLevels::card(top.face(), top.suit()));
+    level.playfield.push_back(TestLevels::card(target.face(), target.suit()));
+    GameModel model;
+    if (!GameService::loadLevel(&model, level)) {
+        return false;
+    }
+    MoveRecord record;
+    bool matched = GameService::executePlayfieldCardMatch(&model, 1, &record);
+    scoreDelta = matched ? record.scoreDelta : 0;
+    return matched && model.getScore() == scoreDelta;
+}
+
+bool canMatch(int ruleSet, PackedCard top, PackedCard target) {
+    int scoreDelta = 0;
+    return tryMatch(ruleSet, top, target, scoreDelta);
+}
+
+PackedCard card(CardFaceType face, CardSuitType suit) {
+    return PackedCard::make(face, suit);
+}
+
+} // namespace
+
+TEST_CASE(rule_policy, classic_rules) {
+    CHECK(canMatch(RST_CLASSIC, card(CFT_ACE, CST_CLUBS), card(CFT_TWO, CST_HEARTS)));
+    CHECK(canMatch(RST_CLASSIC, card(CFT_QUEEN, CST_CLUBS), card(CFT_JACK, CST_SPADES)));
+    CHECK(!canMatch(RST_CLASSIC, card(CFT_KING, CST_CLUBS), card(CFT_ACE, CST_CLUBS)));
+    CHECK(!canMatch(RST_CLASSIC, card(CFT_FIVE, CST_CLUBS), card(CFT_SEVEN, CST_CLUBS)));
+    CHECK(!canMatch(RST_CLASSIC, card(CFT_FIVE, CST_CLUBS), card(CFT_FIVE, CST_HEARTS)));
+
+    int scoreDelta = 0;
+    CHECK(tryMatch(RST_CLASSIC, card(CFT_FOUR, CST_CLUBS), card(CFT_THREE, CST_CLUBS), scoreDelta));
+    CHECK(scoreDelta == ScoreService::BASE_MATCH_SCORE);
+    CHECK(tryMatch(RST_CLASSIC, card(CFT_TWO, CST_CLUBS), card(CFT_ACE, CST_HEARTS), scoreDelta));
+    CHECK(scoreDelta == ScoreService::BASE_MATCH_SCORE + ScoreService::SPECIAL_CARD_BONUS);
+}
+
+TEST_CASE(rule_policy, wraparound_rules) {
+    CHECK(canMatch(RST_WRAPAROUND, card(CFT_KING, CST_CLUBS), card(CFT_ACE, CST_HEARTS)));
+    CHECK(canMatch(RST_WRAPAROUND, card(CFT_ACE, CST_CLUBS), card(CFT_KING, CST_HEARTS)));
+    CHECK(canMatch(RST_WRAPAROUND, card(CFT_SIX, CST_CLUBS), card(CFT_SEVEN, CST_HEARTS)));
+    CHECK(!canMatch(RST_WRAPAROUND, card(CFT_QUEEN, CST_CLUBS), card(CFT_ACE, CST_HEARTS)));
+}
+
+TEST_CASE(rule_policy, same_suit_rules) {
+    CHECK(canMatch(RST_SAME_SUIT, card(CFT_FIVE, CST_DIAMONDS), card(CFT_SIX, CST_DIAMONDS)));
+    CHECK(!canMatch(RST_SAME_SUIT, card(CFT_FIVE, CST_DIAMONDS), card(CFT_SIX, CST_HEARTS)));
+    CHECK(!canMatch(RST_SAME_SUIT, card(CFT_KING, CST_SPADES), card(CFT_ACE, CST_SPADES)));
+}
+
+TEST_CASE(rule_policy, bonus_rules) {
+    int scoreDelta = 0;
+    CHECK(tryMatch(RST_BONUS, card(CFT_FIVE, CST_CLUBS), card(CFT_SEVEN, CST_HEARTS), scoreDelta));
+    CHECK(scoreDelta == ScoreService::BASE_MATCH_SCORE);
+    CHECK(tryMatch(RST_BONUS, card(CFT_FIVE, CST_CLUBS), card(CFT_THREE, CST_CLUBS), scoreDelta));
+    CHECK(scoreDelta == ScoreService::BASE_MATCH_SCORE + ScoreService::SAME_SUIT_BONUS);
+    CHECK(tryMatch(RST_BONUS, card(CFT_JACK, CST_SPADES), card(CFT_KING, CST_SPADES), scoreDelta));
+    CHECK(scoreDelta == ScoreService::BASE_MATCH_SCORE + ScoreService::SPECIAL_CARD_BONUS +
+                        ScoreService::SAME_SUIT_BONUS);
+    CHECK(!canMatch(RST_BONUS, card(CFT_FIVE, CST_CLUBS), card(CFT_EIGHT, CST_CLUBS)));
+    CHECK(!canMatch(RST_BONUS, card(CFT_KING, CST_CLUBS), card(CFT_ACE, CST_CLUBS)));
+}
+
+TEST_CASE(rule_policy, match_tables_agree_with_face_distance) {
+    // 编译期生成的掩码表与逐对比较一致
+    for (int a = 0; a < CFT_NUM_CARD_FACE_TYPES; ++a) {
+        for (int b = 0; b < CFT_NUM_CARD_FACE_TYPES; ++b) {
+            int distance = a > b ? a - b : b - a;
+            int wrapped = distance < CFT_NUM_CARD_FACE_TYPES - distance ? distance : CFT_NUM_CARD_FACE_TYPES - distance;
+            CHECK(ClassicMatch::canMatchFaces(a, b) == (distance == 1));
+            CHECK(WraparoundMatch::canMatchFaces(a, b) == (wrapped == 1));
+            CHECK(WithinTwoMatch::canMatchFaces(a, b) == (distance >= 1 && distance <= 2));
+        }
+        uint16_t mask = FaceMatchIndex::faceBit(static_cast<CardFaceType>(a));
+        CHECK(WraparoundMatch::matchingFacesOf(mask) == WraparoundMatch::matchingFaces(a));
+        CHECK(WithinTwoMatch::matchingFacesOf(mask) == WithinTwoMatch::matchingFaces(a));
+    }
+}
+
+TEST_CASE(rule_policy, end_rule_follows_match_rule) {
+    // 只有一张手牌K和牌桌的A：首尾相接规则下还能走，经典规则下已是死局
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_KING, CST_CLUBS));
+    level.playfield.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    GameModel model;
+
+    level.ruleSet = RST_WRAPAROUND;
+    REQUIRE(GameService::loadLevel(&model, level));
+    CHECK(GameService::checkGameEndCondition(&model) == 0);
+    REQUIRE(GameService::executePlayfieldCardMatch(&model, 1));
+    CHECK(GameService::checkGameEndCondition(&model) == 1);
+
+    level.ruleSet = RST_CLASSIC;
+    REQUIRE(GameService::loadLevel(&model, level));
+    CHECK(GameService::checkGameEndCondition(&model) == -1);
+
+    // 同花色规则下花色不同也是死局
+    level.ruleSet = RST_SAME_SUIT;
+    level.playfield[0] = TestLevels::card(CFT_QUEEN, CST_HEARTS);
+    REQUIRE(GameService::loadLevel(&model, level));
+    CHECK(GameService::checkGameEndCondition(&model) == -1);
+}
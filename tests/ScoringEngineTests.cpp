@@ -0,0 +1,126 @@
+﻿/**
+ * @file ScoringEngineTests.cpp
+ * @brief 事件驱动的计分引擎
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "managers/ScoringEngine.h"
+#include "services/GameService.h"
+#include "services/ScoreService.h"
+
+namespace {
+
+const int FPS = 60;     ///< 计分时钟的帧率
+
+/**
+ * @brief 以三张牌桌卡牌的关卡重置计分，标准用时30秒
+ */
+void resetScoring(ScoringEngine& scoring) {
+    GameModel model;
+    GameService::loadLevel(&model, TestLevels::makeWinnableLevel());
+    scoring.setClock(FPS, 0);
+    scoring.reset(model);
+}
+
+} // namespace
+
+TEST_CASE(scoring, combo_builds_and_swap_breaks_it) {
+    ScoringEngine scoring;
+    resetScoring(scoring);
+    scoring.consume(ScoreEvent(10, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(20, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(30, SET_MATCH, 15));
+    CHECK(scoring.getCombo() == 3);
+    CHECK(scoring.getBreakdown().matchPoints == 35);
+    int comboBonus = ScoreService::calculateComboBonus(2) + ScoreService::calculateComboBonus(3);
+    CHECK(comboBonus > 0);
+    CHECK(scoring.getBreakdown().comboBonus == comboBonus);
+
+    scoring.consume(ScoreEvent(40, SET_SWAP));
+    CHECK(scoring.getCombo() == 0);
+    scoring.consume(ScoreEvent(50, SET_MATCH, 10));
+    CHECK(scoring.getCombo() == 1);
+    CHECK(scoring.getBreakdown().comboBonus == comboBonus);
+    CHECK(scoring.getTotalScore() == 45 + comboBonus);
+}
+
+TEST_CASE(scoring, undo_rolls_back_step_and_combo) {
+    ScoringEngine scoring;
+    resetScoring(scoring);
+    scoring.consume(ScoreEvent(10, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(20, SET_SWAP));
+    scoring.consume(ScoreEvent(30, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(40, SET_MATCH, 10));
+
+    scoring.consume(ScoreEvent(50, SET_UNDO));
+    CHECK(scoring.getBreakdown().matchPoints == 20);
+    CHECK(scoring.getBreakdown().comboBonus == 0);
+    CHECK(scoring.getCombo() == 1);
+    CHECK(!scoring.isPerfect());
+
+    // 撤销切换手牌恢复切换前的连击数
+    scoring.consume(ScoreEvent(60, SET_UNDO));
+    scoring.consume(ScoreEvent(70, SET_UNDO));
+    CHECK(scoring.getCombo() == 1);
+    CHECK(scoring.getBreakdown().matchPoints == 10);
+}
+
+TEST_CASE(scoring, win_bonus_is_undone_with_the_winning_step) {
+    ScoringEngine scoring;
+    resetScoring(scoring);
+    scoring.consume(ScoreEvent(60, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(120, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(180, SET_WIN));
+
+    // 3秒完成，标准用时30秒，完美对局
+    int timeBonus = ScoreService::calculateTimeBonus(3.0f, 30.0f);
+    int perfectBonus = ScoreService::calculateCompletionBonus(0, 3.0f, true);
+    CHECK(timeBonus > 0);
+    CHECK(scoring.getBreakdown().timeBonus == timeBonus);
+    CHECK(scoring.getBreakdown().completionBonus == perfectBonus);
+    // 同一局只结算一次
+    scoring.consume(ScoreEvent(200, SET_WIN));
+    CHECK(scoring.getBreakdown().completionBonus == perfectBonus);
+
+    scoring.consume(ScoreEvent(240, SET_UNDO));
+    CHECK(scoring.getBreakdown().timeBonus == 0);
+    CHECK(scoring.getBreakdown().completionBonus == 0);
+    CHECK(scoring.getBreakdown().matchPoints == 10);
+
+    // 撤销后再赢不再是完美对局
+    scoring.consume(ScoreEvent(1200, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(1200, SET_WIN));
+    CHECK(scoring.getBreakdown().timeBonus == ScoreService::calculateTimeBonus(20.0f, 30.0f));
+    CHECK(scoring.getBreakdown().completionBonus == ScoreService::calculateCompletionBonus(0, 20.0f, false));
+    CHECK(scoring.getBreakdown().completionBonus < perfectBonus);
+}
+
+TEST_CASE(scoring, rejected_click_ends_perfect_game) {
+    ScoringEngine scoring;
+    resetScoring(scoring);
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+    MoveRecord record = MoveRecord();
+    scoring.onInput(IO_HAND_CLICK, false, record, model, 10);
+    CHECK(scoring.isPerfect());
+    scoring.onInput(IO_PLAYFIELD_CLICK, false, record, model, 20);
+    CHECK(!scoring.isPerfect());
+    CHECK(scoring.getTotalScore() == 0);
+}
+
+TEST_CASE(scoring, journal_follows_undo_limit) {
+    ScoringEngine scoring;
+    scoring.setMaxUndoSteps(2);
+    resetScoring(scoring);
+    scoring.consume(ScoreEvent(10, SET_MATCH, 10));
+    scoring.consume(ScoreEvent(20, SET_MATCH, 11));
+    scoring.consume(ScoreEvent(30, SET_MATCH, 12));
+
+    // 最旧的一步已被覆盖，与撤销管理器一样不能再回退
+    scoring.consume(ScoreEvent(40, SET_UNDO));
+    scoring.consume(ScoreEvent(50, SET_UNDO));
+    scoring.consume(ScoreEvent(60, SET_UNDO));
+    CHECK(scoring.getBreakdown().matchPoints == 10);
+    CHECK(scoring.getBreakdown().comboBonus == 0);
+}
@@ -0,0 +1,67 @@
+﻿/**
+ * @file SlotMapTests.cpp
+ * @brief 分代槽位表的句柄和紧密存储
+ */
+
+#include "TestHarness.h"
+#include "utils/SlotMap.h"
+
+namespace {
+
+typedef SlotMap<int, 8, 16> TestMap;    ///< 8个元素、16个键的测试用槽位表
+
+} // namespace
+
+TEST_CASE(slot_map, erase_keeps_values_dense) {
+    TestMap map;
+    map.clear();
+    for (int key = 0; key < 5; ++key) {
+        map.insert(key * 3, key * 100);
+    }
+    CHECK(map.size() == 5);
+
+    // 删除中间的元素时由最后一个元素补位
+    CHECK(map.erase(3));
+    CHECK(map.size() == 4);
+    CHECK(!map.contains(3));
+    CHECK(map.indexOf(12) == 1);
+    for (int key = 0; key < 5; ++key) {
+        const int* value = map.find(key * 3);
+        CHECK(key == 1 ? value == nullptr : (value && *value == key * 100));
+    }
+    for (int i = 0; i < map.size(); ++i) {
+        CHECK(map.slots[map.keys[i]] == i);
+    }
+    CHECK(!map.erase(3));
+}
+
+TEST_CASE(slot_map, stale_handle_is_rejected) {
+    TestMap map;
+    map.clear();
+    SlotHandle first = map.insert(5, 1);
+    CHECK(map.isValid(first));
+    CHECK(map.erase(5));
+    CHECK(!map.isValid(first));
+
+    // 重新插入同一个键后代数增加，旧句柄仍然无效
+    SlotHandle second = map.insert(5, 2);
+    CHECK(second.key == first.key);
+    CHECK(second.generation == first.generation + 1);
+    CHECK(!map.isValid(first));
+    CHECK(map.isValid(second));
+    CHECK(*map.get(second) == 2);
+}
+
+TEST_CASE(slot_map, clear_optionally_keeps_generations) {
+    TestMap map;
+    map.clear();
+    SlotHandle handle = map.insert(2, 7);
+    map.erase(handle);
+
+    map.clear(false);
+    CHECK(map.empty());
+    CHECK(map.insert(2, 8).generation == 1);
+
+    map.clear();
+    CHECK(map.insert(2, 9).generation == 0);
+}
@@ -0,0 +1,78 @@
+﻿/**
+ * @file SolverTests.cpp
+ * @brief 关卡穷举求解器
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "solver/LevelSolver.h"
+#include "services/GameService.h"
+
+namespace {
+
+SolverOptions makeOptions(int threadCount) {
+    SolverOptions options;
+    options.threadCount = threadCount;
+    options.tableSizeLog2 = 12;
+    return options;
+}
+
+} // namespace
+
+TEST_CASE(solver, finds_shortest_solution) {
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, TestLevels::makeWinnableLevel()));
+
+    // 先匹配2、3再切换到K最省步数；先切换到K要多切换一次
+    for (int threadCount = 1; threadCount <= 4; threadCount *= 2) {
+        LevelSolver solver(makeOptions(threadCount));
+        SolverResult result = solver.solve(model);
+        CHECK(result.solvable);
+        CHECK(result.complete);
+        CHECK(result.moveCount == 4);
+        REQUIRE(result.moves.size() == 4);
+
+        // 解可以在模型副本上逐步重放直到清空牌桌
+        GameModel replay = model;
+        for (const MoveRecord& move : result.moves) {
+            CHECK(GameService::replayMove(&replay, move));
+        }
+        CHECK(replay.state.playfield.empty());
+    }
+}
+
+TEST_CASE(solver, proves_unsolvable) {
+    // 只有一张手牌A，牌桌的2匹配后剩下无法匹配的9
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+    level.playfield.push_back(TestLevels::card(CFT_TWO, CST_CLUBS));
+    level.playfield.push_back(TestLevels::card(CFT_NINE, CST_CLUBS));
+
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+    LevelSolver solver(makeOptions(2));
+    SolverResult result = solver.solve(model);
+    CHECK(!result.solvable);
+    CHECK(result.complete);
+    CHECK(result.moveCount == -1);
+    CHECK(result.moves.empty());
+}
+
+TEST_CASE(solver, follows_the_rule_set) {
+    // K与A只在首尾相接规则下相邻
+    LevelConfig level;
+    level.ruleSet = RST_WRAPAROUND;
+    level.stack.push_back(TestLevels::card(CFT_KING, CST_SPADES));
+    level.playfield.push_back(TestLevels::card(CFT_ACE, CST_HEARTS));
+
+    GameModel model;
+    REQUIRE(GameService::loadLevel(&model, level));
+    LevelSolver solver(makeOptions(1));
+    CHECK(solver.solve(model).solvable);
+
+    level.ruleSet = RST_CLASSIC;
+    REQUIRE(GameService::loadLevel(&model, level));
+    SolverResult classic = solver.solve(model);
+    CHECK(!classic.solvable);
+    CHECK(classic.complete);
+}
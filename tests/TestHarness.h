@@ -0,0 +1,79 @@
+﻿#ifndef __TEST_HARNESS_H__
+#define __TEST_HARNESS_H__
+
+#include <string>
+
+/**
+ * @struct TestCase
+ * @brief 一个已注册的测试用例
+ */
+struct TestCase {
+    const char* suite;      ///< 测试集名称，ctest按测试集分别运行
+    const char* name;       ///< 用例名称
+    void (*run)();          ///< 用例函数
+};
+
+/**
+ * @class TestRegistry
+ * @brief 不依赖外部框架的最小测试注册表
+ *
+ * 用例通过TEST_CASE在静态初始化时注册，检查失败只记录不中断，
+ * REQUIRE失败时结束当前用例
+ */
+class TestRegistry {
+public:
+    /**
+     * @brief 注册用例，供TEST_CASE使用
+     *
+     * @return 固定返回0，用于初始化静态变量
+     */
+    static int add(const char* suite, const char* name, void (*run)());
+
+    /**
+     * @brief 记录一次检查失败
+     */
+    static void fail(const char* file, int line, const char* expression);
+
+    /**
+     * @brief 运行测试
+     *
+     * @param suite 只运行该测试集，为空时运行全部
+     * @return 失败的用例数，没有匹配的用例时返回-1
+     */
+    static int run(const char* suite);
+
+    /**
+     * @brief 获取测试用的临时文件路径
+     *
+     * 文件位于构建目录下，路径中带有当前用例名，避免并行运行的测试集互相覆盖
+     */
+    static std::string getTempPath(const char* fileName);
+
+private:
+    TestRegistry() = delete;
+    ~TestRegistry() = delete;
+    TestRegistry(const TestRegistry&) = delete;
+    TestRegistry& operator=(const TestRegistry&) = delete;
+};
+
+#define TEST_CASE(suite, name) \
+    static void suite##_##name(); \
+    static const int suite##_##name##_registered = TestRegistry::add(#suite, #name, &suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            TestRegistry::fail(__FILE__, __LINE__, #expression); \
+        } \
+    } while (0)
+
+#define REQUIRE(expression) \
+    do { \
+        if (!(expression)) { \
+            TestRegistry::fail(__FILE__, __LINE__, #expression); \
+            return; \
+        } \
+    } while (0)
+
+#endif // __TEST_HARNESS_H__
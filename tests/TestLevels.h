@@ -0,0 +1,51 @@
+﻿#ifndef __TEST_LEVELS_H__
+#define __TEST_LEVELS_H__
+
+#include "configs/LevelData.h"
+#include "configs/CardTypes.h"
+
+/**
+ * @class TestLevels
+ * @brief 测试用的小关卡
+ *
+ * 卡牌ID按加载顺序分配：先手牌堆叠，再牌桌卡牌
+ */
+class TestLevels {
+public:
+    /**
+     * @brief 生成一张卡牌配置
+     */
+    static CardConfig card(CardFaceType face, CardSuitType suit, float x = 0.0f, float y = 0.0f) {
+        CardConfig config;
+        config.cardFace = face;
+        config.cardSuit = suit;
+        config.position = GameVec2(x, y);
+        return config;
+    }
+
+    /**
+     * @brief 可以一路匹配清空的关卡
+     *
+     * 手牌：ID 0为梅花K，ID 1为红桃A（顶部）
+     * 牌桌：ID 2为方块2，ID 3为黑桃3，ID 4为梅花Q
+     * 依次点击2、3后牌桌只剩Q，需切换到手牌K再匹配Q
+     */
+    static LevelConfig makeWinnableLevel(int ruleSet = RST_CLASSIC) {
+        LevelConfig level;
+        level.ruleSet = ruleSet;
+        level.stack.push_back(card(CFT_KING, CST_CLUBS));
+        level.stack.push_back(card(CFT_ACE, CST_HEARTS));
+        level.playfield.push_back(card(CFT_TWO, CST_DIAMONDS, 100.0f, 400.0f));
+        level.playfield.push_back(card(CFT_THREE, CST_SPADES, 200.0f, 400.0f));
+        level.playfield.push_back(card(CFT_QUEEN, CST_CLUBS, 300.0f, 400.0f));
+        return level;
+    }
+
+private:
+    TestLevels() = delete;
+    ~TestLevels() = delete;
+    TestLevels(const TestLevels&) = delete;
+    TestLevels& operator=(const TestLevels&) = delete;
+};
+
+#endif // __TEST_LEVELS_H__
@@ -0,0 +1,85 @@
+﻿/**
+ * @file TestMain.cpp
+ * @brief cardgame_core的行为测试入口
+ *
+ * 用法：
+ *   cardgame_core_tests [测试集]
+ *
+ * 退出码：0 全部通过；1 有用例失败或没有匹配的用例
+ */
+
+#include "TestHarness.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+std::vector<TestCase>& getTests() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+const TestCase* g_currentTest = nullptr;   ///< 正在运行的用例
+int g_currentFailures = 0;                 ///< 当前用例的失败检查数
+
+} // namespace
+
+// 注册用例
+int TestRegistry::add(const char* suite, const char* name, void (*run)()) {
+    TestCase test;
+    test.suite = suite;
+    test.name = name;
+    test.run = run;
+    getTests().push_back(test);
+    return 0;
+}
+
+// 记录检查失败
+void TestRegistry::fail(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: %s.%s: CHECK(%s) failed\n", file, line,
+                 g_currentTest ? g_currentTest->suite : "?", g_currentTest ? g_currentTest->name : "?", expression);
+    g_currentFailures++;
+}
+
+// 运行测试
+int TestRegistry::run(const char* suite) {
+    int ran = 0;
+    int failed = 0;
+    for (const TestCase& test : getTests()) {
+        if (suite && std::strcmp(suite, test.suite) != 0) {
+            continue;
+        }
+        g_currentTest = &test;
+        g_currentFailures = 0;
+        test.run();
+        std::printf("[%s] %s.%s\n", g_currentFailures == 0 ? "  OK  " : " FAIL ", test.suite, test.name);
+        ran++;
+        failed += g_currentFailures == 0 ? 0 : 1;
+    }
+    g_currentTest = nullptr;
+    return ran == 0 ? -1 : failed;
+}
+
+// 获取临时文件路径
+std::string TestRegistry::getTempPath(const char* fileName) {
+    std::string path = CARDGAME_TEST_TEMP_DIR "/";
+    if (g_currentTest) {
+        path += g_currentTest->suite;
+        path += '.';
+        path += g_currentTest->name;
+        path += '.';
+    }
+    return path + fileName;
+}
+
+int main(int argc, char** argv) {
+    const char* suite = argc > 1 ? argv[1] : nullptr;
+    int failed = TestRegistry::run(suite);
+    if (failed < 0) {
+        std::fprintf(stderr, "no test cases match '%s'\n", suite ? suite : "");
+        return 1;
+    }
+    std::printf("%d test case(s) failed\n", failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+﻿/**
+ * @file UndoTests.cpp
+ * @brief 撤销管理器的环形缓冲区
+ */
+
+#include "TestHarness.h"
+#include "TestLevels.h"
+#include "services/GameService.h"
+#include "managers/UndoManager.h"
+#include <vector>
+
+namespace {
+
+const int CHAIN_LENGTH = 6;     ///< 顺子关卡的牌桌卡牌数
+
+/**
+ * @brief 顶部手牌5之后牌桌为6到J的顺子，依次点击ID 2到7即可清空
+ */
+LevelConfig makeChainLevel() {
+    LevelConfig level;
+    level.stack.push_back(TestLevels::card(CFT_KING, CST_CLUBS));
+    level.stack.push_back(TestLevels::card(CFT_FIVE, CST_HEARTS));
+    for (int i = 0; i < CHAIN_LENGTH; ++i) {
+        level.playfield.push_back(TestLevels::card(static_cast<CardFaceType>(CFT_SIX + i), CST_SPADES));
+    }
+    return level;
+}
+
+} // namespace
+
+TEST_CASE(undo, ring_buffer_wraps_and_keeps_newest) {
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, makeChainLevel()));
+    REQUIRE(undoManager.init(&model));
+    undoManager.setMaxUndoSteps(3);
+
+    // hashes[i]为第i步之后的状态
+    std::vector<uint64_t> hashes(1, model.computeStateHash());
+    for (int i = 0; i < CHAIN_LENGTH; ++i) {
+        REQUIRE(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 2 + i));
+        hashes.push_back(model.computeStateHash());
+    }
+    CHECK(model.isGameWon);
+    CHECK(undoManager.getUndoCount() == 3);
+
+    // 缓冲区已绕回两次，只能撤销最近三步
+    for (int i = 0; i < 3; ++i) {
+        CHECK(undoManager.undo());
+        CHECK(model.computeStateHash() == hashes[CHAIN_LENGTH - 1 - i]);
+    }
+    CHECK(!undoManager.undo());
+    CHECK(undoManager.getRedoCount() == 3);
+
+    for (int i = 0; i < 3; ++i) {
+        CHECK(GameService::applyInput(&model, &undoManager, IO_REDO, 0));
+    }
+    CHECK(!undoManager.canRedo());
+    CHECK(model.computeStateHash() == hashes[CHAIN_LENGTH]);
+    CHECK(model.isGameWon);
+}
+
+TEST_CASE(undo, new_move_discards_redo) {
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, makeChainLevel()));
+    REQUIRE(undoManager.init(&model));
+
+    REQUIRE(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 2));
+    REQUIRE(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 3));
+    REQUIRE(undoManager.undo());
+    CHECK(undoManager.canRedo());
+
+    REQUIRE(GameService::applyInput(&model, &undoManager, IO_HAND_CLICK, 0));
+    CHECK(!undoManager.canRedo());
+    CHECK(!GameService::applyInput(&model, &undoManager, IO_REDO, 0));
+    CHECK(undoManager.getUndoCount() == 2);
+}
+
+TEST_CASE(undo, unlimited_grows_past_initial_capacity) {
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, makeChainLevel()));
+    REQUIRE(undoManager.init(&model));
+    undoManager.setMaxUndoSteps(0);
+    uint64_t initialHash = model.computeStateHash();
+
+    // 两张手牌来回切换，步数超过初始容量
+    const int moves = static_cast<int>(UndoManager::UNLIMITED_INITIAL_CAPACITY) + 36;
+    for (int i = 0; i < moves; ++i) {
+        REQUIRE(GameService::applyInput(&model, &undoManager, IO_HAND_CLICK, i % 2 == 0 ? 0 : 1));
+    }
+    CHECK(undoManager.getUndoCount() == static_cast<size_t>(moves));
+
+    int undone = 0;
+    while (undoManager.undo()) {
+        undone++;
+    }
+    CHECK(undone == moves);
+    CHECK(model.computeStateHash() == initialHash);
+}
+
+TEST_CASE(undo, shrinking_keeps_newest_records) {
+    GameModel model;
+    UndoManager undoManager;
+    REQUIRE(GameService::loadLevel(&model, makeChainLevel()));
+    REQUIRE(undoManager.init(&model));
+    undoManager.setMaxUndoSteps(0);
+
+    std::vector<uint64_t> hashes(1, model.computeStateHash());
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(GameService::applyInput(&model, &undoManager, IO_PLAYFIELD_CLICK, 2 + i));
+        hashes.push_back(model.computeStateHash());
+    }
+
+    undoManager.setMaxUndoSteps(2);
+    CHECK(undoManager.getUndoCount() == 2);
+    CHECK(undoManager.undo());
+    CHECK(undoManager.undo());
+    CHECK(model.computeStateHash() == hashes[3]);
+    CHECK(!undoManager.undo());
+}
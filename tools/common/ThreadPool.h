@@ -0,0 +1,58 @@
+﻿#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief 命令行工具使用的定长线程池
+ *
+ * 任务按提交顺序被空闲线程取走，wait()阻塞到所有已提交的任务完成
+ * 析构时等待剩余任务完成后结束线程
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param threadCount 线程数，0表示使用硬件线程数
+     */
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    /**
+     * @brief 提交一个任务
+     */
+    void submit(const std::function<void()>& task);
+
+    /**
+     * @brief 等待所有已提交的任务完成
+     */
+    void wait();
+
+    /**
+     * @brief 获取线程数
+     */
+    int getThreadCount() const { return static_cast<int>(m_threads.size()); }
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void workerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskReady;    ///< 有新任务或线程池关闭
+    std::condition_variable m_allDone;      ///< 所有任务完成
+    int m_runningTasks;                     ///< 正在执行的任务数
+    bool m_stopping;
+};
+
+#endif // __THREAD_POOL_H__
@@ -0,0 +1,126 @@
+﻿#include "ToolUtils.h"
+#include "configs/LevelParser.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+namespace {
+
+bool hasExtension(const std::string& name, const std::string& extension) {
+    return name.size() > extension.size() &&
+           name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+} // namespace
+
+bool ToolUtils::readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+bool ToolUtils::readFile(const std::string& path, std::vector<uint8_t>& out) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    out.clear();
+    uint8_t buffer[4096];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.insert(out.end(), buffer, buffer + count);
+    }
+    bool readError = std::ferror(file) != 0;
+    std::fclose(file);
+    return !readError;
+}
+
+bool ToolUtils::writeFile(const std::string& path, const std::string& data) {
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool ToolUtils::makeDirectory(const std::string& path) {
+#ifdef _WIN32
+    int result = _mkdir(path.c_str());
+#else
+    int result = mkdir(path.c_str(), 0755);
+#endif
+    struct stat info;
+    return result == 0 || (stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFDIR);
+}
+
+bool ToolUtils::collectLevelFiles(const std::string& path, std::vector<std::string>& out) {
+    return collectFiles(path, ".json", out);
+}
+
+bool ToolUtils::collectFiles(const std::string& path, const std::string& extension, std::vector<std::string>& out) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    if ((info.st_mode & S_IFMT) != S_IFDIR) {
+        out.push_back(path);
+        return true;
+    }
+
+    std::vector<std::string> names;
+#ifdef _WIN32
+    struct _finddata_t data;
+    intptr_t handle = _findfirst((path + "/*" + extension).c_str(), &data);
+    if (handle != -1) {
+        do {
+            if (hasExtension(data.name, extension)) {
+                names.push_back(data.name);
+            }
+        } while (_findnext(handle, &data) == 0);
+        _findclose(handle);
+    }
+#else
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return false;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        if (hasExtension(entry->d_name, extension)) {
+            names.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+#endif
+
+    std::sort(names.begin(), names.end());
+    for (size_t i = 0; i < names.size(); ++i) {
+        out.push_back(path + "/" + names[i]);
+    }
+    return true;
+}
+
+bool ToolUtils::loadLevelFile(const std::string& path, LevelConfig& level, std::string* error) {
+    std::string json;
+    if (!readFile(path, json)) {
+        if (error) {
+            *error = "cannot read file";
+        }
+        return false;
+    }
+    return LevelParser::parseInsitu(&json[0], level, error);
+}
@@ -0,0 +1,83 @@
+﻿#ifndef __TOOL_UTILS_H__
+#define __TOOL_UTILS_H__
+
+#include "configs/LevelData.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ToolUtils
+ * @brief 命令行工具共用的文件辅助函数
+ *
+ * 工具不依赖cocos2d的FileUtils，直接读取本地文件
+ */
+class ToolUtils {
+public:
+    /**
+     * @brief 读取整个文件
+     *
+     * @return 读取成功返回true
+     */
+    static bool readFile(const std::string& path, std::string& out);
+
+    /**
+     * @brief 读取整个二进制文件
+     *
+     * 直接读入调用方的缓冲区，重复使用同一个缓冲区时不再分配内存
+     *
+     * @return 读取成功返回true
+     */
+    static bool readFile(const std::string& path, std::vector<uint8_t>& out);
+
+    /**
+     * @brief 写入整个文件，已存在时覆盖
+     *
+     * @return 写入成功返回true
+     */
+    static bool writeFile(const std::string& path, const std::string& data);
+
+    /**
+     * @brief 创建目录，已存在时视为成功（不创建上级目录）
+     */
+    static bool makeDirectory(const std::string& path);
+
+    /**
+     * @brief 展开关卡路径
+     *
+     * 文件原样加入；目录按文件名排序加入其中所有.json文件（不递归）
+     *
+     * @param path 文件或目录路径
+     * @param out 追加输出的文件路径
+     * @return 路径存在返回true
+     */
+    static bool collectLevelFiles(const std::string& path, std::vector<std::string>& out);
+
+    /**
+     * @brief 展开文件路径
+     *
+     * 与collectLevelFiles相同，目录中只收集指定扩展名的文件
+     *
+     * @param path 文件或目录路径
+     * @param extension 扩展名，包含前导的点，如".cgir"
+     * @param out 追加输出的文件路径
+     * @return 路径存在返回true
+     */
+    static bool collectFiles(const std::string& path, const std::string& extension, std::vector<std::string>& out);
+
+    /**
+     * @brief 读取并解析关卡文件
+     *
+     * @param error 失败时输出错误描述，可为空
+     * @return 成功返回true
+     */
+    static bool loadLevelFile(const std::string& path, LevelConfig& level, std::string* error = nullptr);
+
+private:
+    ToolUtils() = delete;
+    ~ToolUtils() = delete;
+    ToolUtils(const ToolUtils&) = delete;
+    ToolUtils& operator=(const ToolUtils&) = delete;
+};
+
+#endif // __TOOL_UTILS_H__
@@ -0,0 +1,189 @@
+﻿/**
+ * @file difficulty_estimator.cpp
+ * @brief 关卡难度估计命令行工具
+ *
+ * 对每个关卡做大量随机或贪心模拟对局，输出胜率、平均步数和死局深度的CSV
+ * 模拟按固定大小分批交给线程池，每批的随机种子只由总种子、关卡序号、策略和批序号决定，
+ * 因此同一种子下结果与线程数无关，可以复现
+ *
+ * 用法：
+ *   difficulty_estimator [--playouts N] [--policy random|greedy|both] [--threads N]
+ *                        [--seed N] [--output file.csv] <关卡文件或目录>...
+ */
+
+#include "ThreadPool.h"
+#include "ToolUtils.h"
+#include "services/GameService.h"
+#include "services/PlayoutService.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int BATCH_SIZE = 2000;    ///< 每个线程池任务的模拟局数
+
+/**
+ * @struct LevelJob
+ * @brief 一个关卡在一种策略下的模拟任务
+ */
+struct LevelJob {
+    int levelIndex;
+    PlayoutPolicy policy;
+    PackedGameState initial;
+    std::vector<PlayoutStats> batches;  ///< 每批的汇总，由各任务分别写入
+};
+
+/**
+ * @brief 由总种子、关卡序号、策略和批序号派生批次种子
+ */
+uint32_t batchSeed(uint32_t seed, int levelIndex, int policy, int batch) {
+    uint64_t z = (static_cast<uint64_t>(seed) << 32) ^
+                 (static_cast<uint64_t>(levelIndex) << 20) ^
+                 (static_cast<uint64_t>(policy) << 16) ^
+                 static_cast<uint64_t>(batch);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+
+double ratio(uint64_t value, uint64_t count) {
+    return count == 0 ? 0.0 : static_cast<double>(value) / static_cast<double>(count);
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: difficulty_estimator [--playouts N] [--policy random|greedy|both] [--threads N]\n"
+        "                            [--seed N] [--output file.csv] <level.json|dir>...\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int playouts = 10000;
+    int threadCount = 0;
+    uint32_t seed = 1;
+    bool useRandom = true;
+    bool useGreedy = true;
+    const char* outputPath = nullptr;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--playouts") == 0 && i + 1 < argc) {
+            playouts = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (std::strcmp(arg, "--policy") == 0 && i + 1 < argc) {
+            const char* policy = argv[++i];
+            useRandom = std::strcmp(policy, "greedy") != 0;
+            useGreedy = std::strcmp(policy, "random") != 0;
+        } else if (arg[0] == '-') {
+            printUsage();
+            return 2;
+        } else if (!ToolUtils::collectLevelFiles(arg, files)) {
+            std::fprintf(stderr, "difficulty_estimator: cannot open %s\n", arg);
+            return 2;
+        }
+    }
+    if (files.empty() || playouts <= 0) {
+        printUsage();
+        return 2;
+    }
+
+    // 加载关卡并为每种策略建立任务
+    std::vector<LevelJob> jobs;
+    std::vector<int> playfieldCounts;
+    std::vector<int> handCounts;
+    for (size_t i = 0; i < files.size(); ++i) {
+        LevelConfig level;
+        std::string error;
+        GameModel model;
+        if (!ToolUtils::loadLevelFile(files[i], level, &error)) {
+            std::fprintf(stderr, "difficulty_estimator: %s: %s\n", files[i].c_str(), error.c_str());
+            return 2;
+        }
+        if (!GameService::loadLevel(&model, level)) {
+            std::fprintf(stderr, "difficulty_estimator: %s: level exceeds model capacity\n", files[i].c_str());
+            return 2;
+        }
+        playfieldCounts.push_back(model.state.playfieldCount());
+        handCounts.push_back(model.state.handCount);
+
+        for (int policy = PP_RANDOM; policy <= PP_GREEDY; ++policy) {
+            if ((policy == PP_RANDOM && !useRandom) || (policy == PP_GREEDY && !useGreedy)) {
+                continue;
+            }
+            LevelJob job;
+            job.levelIndex = static_cast<int>(i);
+            job.policy = static_cast<PlayoutPolicy>(policy);
+            job.initial = model.state;
+            job.batches.resize((playouts + BATCH_SIZE - 1) / BATCH_SIZE);
+            jobs.push_back(job);
+        }
+    }
+
+    // 分批模拟
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(threadCount);
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            LevelJob* job = &jobs[j];
+            for (size_t b = 0; b < job->batches.size(); ++b) {
+                int count = std::min(BATCH_SIZE, playouts - static_cast<int>(b) * BATCH_SIZE);
+                uint32_t batch = batchSeed(seed, job->levelIndex, job->policy, static_cast<int>(b));
+                PlayoutStats* stats = &job->batches[b];
+                pool.submit([job, count, batch, stats]() {
+                    PlayoutService::runPlayouts(job->initial, job->policy, count, batch, *stats);
+                });
+            }
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 输出CSV
+    FILE* output = outputPath ? std::fopen(outputPath, "w") : stdout;
+    if (!output) {
+        std::fprintf(stderr, "difficulty_estimator: cannot write %s\n", outputPath);
+        return 2;
+    }
+    std::fprintf(output, "level,playfield_cards,hand_cards,policy,playouts,win_rate,"
+                         "avg_moves,avg_win_moves,avg_dead_end_depth,avg_cards_left,difficulty\n");
+    uint64_t totalPlayouts = 0;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const LevelJob& job = jobs[j];
+        PlayoutStats stats;
+        for (size_t b = 0; b < job.batches.size(); ++b) {
+            stats.merge(job.batches[b]);
+        }
+        totalPlayouts += stats.playouts;
+
+        uint64_t losses = stats.playouts - stats.wins;
+        double winRate = ratio(stats.wins, stats.playouts);
+        std::fprintf(output, "%s,%d,%d,%s,%llu,%.4f,%.2f,%.2f,%.2f,%.2f,%.4f\n",
+                     files[job.levelIndex].c_str(),
+                     playfieldCounts[job.levelIndex], handCounts[job.levelIndex],
+                     job.policy == PP_RANDOM ? "random" : "greedy",
+                     static_cast<unsigned long long>(stats.playouts), winRate,
+                     ratio(stats.totalMoves, stats.playouts), ratio(stats.winMoves, stats.wins),
+                     ratio(stats.deadEndMoves, losses), ratio(stats.deadEndCardsLeft, losses),
+                     1.0 - winRate);
+    }
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    std::fprintf(stderr, "difficulty_estimator: %llu playouts in %.2fs (%.0f playouts/min)\n",
+                 static_cast<unsigned long long>(totalPlayouts), seconds,
+                 seconds > 0.0 ? totalPlayouts * 60.0 / seconds : 0.0);
+    return 0;
+}
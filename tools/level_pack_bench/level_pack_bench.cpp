@@ -0,0 +1,156 @@
+﻿/**
+ * @file level_pack_bench.cpp
+ * @brief 关卡加载基准：JSON与二进制关卡包
+ *
+ * 以一个关卡为布局模板生成指定数量的关卡，分别写成逐个的JSON文件和一个关卡包，
+ * 然后对比把每个关卡加载进GameModel的耗时：
+ * - json：读取文件、解析JSON得到关卡配置、再按配置创建卡牌（与游戏原有的加载路径相同）
+ * - pack：映射关卡包一次，之后按下标直接从映射的卡牌记录创建卡牌
+ *
+ * 用法：
+ *   level_pack_bench [--levels N] [--rounds N] <布局模板.json> <工作目录>
+ */
+
+#include "ToolUtils.h"
+#include "configs/LevelPack.h"
+#include "configs/LevelParser.h"
+#include "services/GameService.h"
+#include "services/LevelGenerationService.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMicroseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void printUsage() {
+    std::fprintf(stderr, "usage: level_pack_bench [--levels N] [--rounds N] <layout.json> <work-dir>\n");
+}
+
+std::string getLevelPath(const std::string& dir, int index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/level_%05d.json", index);
+    return dir + name;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int levelCount = 10000;
+    int rounds = 3;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--levels") == 0 && i + 1 < argc) {
+            levelCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else if (arg[0] == '-') {
+            printUsage();
+            return 2;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2 || levelCount <= 0 || rounds <= 0) {
+        printUsage();
+        return 2;
+    }
+
+    LevelConfig layout;
+    std::string error;
+    if (!ToolUtils::loadLevelFile(paths[0], layout, &error)) {
+        std::fprintf(stderr, "level_pack_bench: %s: %s\n", paths[0].c_str(), error.c_str());
+        return 2;
+    }
+    const std::string& workDir = paths[1];
+    if (!ToolUtils::makeDirectory(workDir)) {
+        std::fprintf(stderr, "level_pack_bench: cannot create %s\n", workDir.c_str());
+        return 2;
+    }
+
+    // 生成关卡并写出两种格式
+    std::vector<LevelConfig> levels(levelCount);
+    LevelGenerationService::Random random(1);
+    LevelGenerationParams params;
+    std::string json;
+    for (int i = 0; i < levelCount; ++i) {
+        LevelGenerationService::generateLevel(layout, params, random, levels[i]);
+        LevelParser::serialize(levels[i], json);
+        if (!ToolUtils::writeFile(getLevelPath(workDir, i), json)) {
+            std::fprintf(stderr, "level_pack_bench: cannot write %s\n", getLevelPath(workDir, i).c_str());
+            return 2;
+        }
+    }
+    std::vector<uint8_t> data;
+    const std::string packPath = workDir + "/levels.cglp";
+    if (!LevelPack::build(levels, data, &error) ||
+        !ToolUtils::writeFile(packPath, std::string(data.begin(), data.end()))) {
+        std::fprintf(stderr, "level_pack_bench: cannot write %s\n", packPath.c_str());
+        return 2;
+    }
+
+    GameModel model;
+    LevelConfig level;
+    uint64_t jsonHashSum = 0;    // 两种加载得到的状态哈希之和应当相同
+    uint64_t packHashSum = 0;
+    double bestJson = 0.0;
+    double bestPack = 0.0;
+    double bestOpen = 0.0;
+    for (int round = 0; round < rounds; ++round) {
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < levelCount; ++i) {
+            if (!ToolUtils::readFile(getLevelPath(workDir, i), json) || !LevelParser::parse(json, level) ||
+                !GameService::loadLevel(&model, level)) {
+                std::fprintf(stderr, "level_pack_bench: cannot load %s\n", getLevelPath(workDir, i).c_str());
+                return 1;
+            }
+            jsonHashSum += model.computeStateHash();
+        }
+        double jsonTime = elapsedMicroseconds(start);
+
+        start = Clock::now();
+        LevelPack pack;
+        if (!pack.openFile(packPath, &error)) {
+            std::fprintf(stderr, "level_pack_bench: %s: %s\n", packPath.c_str(), error.c_str());
+            return 1;
+        }
+        double openTime = elapsedMicroseconds(start);
+        for (int i = 0; i < levelCount; ++i) {
+            if (!GameService::loadLevel(&model, pack, i)) {
+                std::fprintf(stderr, "level_pack_bench: cannot load pack level %d\n", i);
+                return 1;
+            }
+            packHashSum += model.computeStateHash();
+        }
+        double packTime = elapsedMicroseconds(start);
+
+        if (round == 0 || jsonTime < bestJson) {
+            bestJson = jsonTime;
+        }
+        if (round == 0 || packTime < bestPack) {
+            bestPack = packTime;
+            bestOpen = openTime;
+        }
+    }
+    if (jsonHashSum != packHashSum) {
+        std::fprintf(stderr, "level_pack_bench: json and pack loads disagree\n");
+        return 1;
+    }
+
+    std::printf("%d levels, json %u bytes/level, pack %u bytes total\n", levelCount,
+                static_cast<unsigned int>(json.size()), static_cast<unsigned int>(data.size()));
+    std::printf("json: %10.1f us total %8.2f us/level\n", bestJson, bestJson / levelCount);
+    std::printf("pack: %10.1f us total %8.2f us/level (open %.1f us)\n", bestPack, bestPack / levelCount, bestOpen);
+    std::printf("speedup: %.1fx\n", bestPack > 0.0 ? bestJson / bestPack : 0.0);
+    return 0;
+}
@@ -0,0 +1,119 @@
+﻿/**
+ * @file level_packer.cpp
+ * @brief 关卡包转换工具
+ *
+ * 把关卡JSON转换为二进制关卡包（.cglp），关卡下标即输入文件的顺序
+ * 目录按文件名排序展开，因此同一目录每次生成的关卡包都相同
+ * 写入后重新映射关卡包，逐个关卡与JSON比对牌面、花色和量化后的位置
+ *
+ * 用法：
+ *   level_packer --output <关卡包> <关卡文件或目录>...
+ *
+ * 退出码：0 成功；1 关卡无法装入关卡包或比对不一致；2 参数或文件错误
+ */
+
+#include "ToolUtils.h"
+#include "configs/LevelPack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::fprintf(stderr, "usage: level_packer --output <pack.cglp> <level.json|dir>...\n");
+}
+
+/**
+ * @brief 比对一张卡牌，位置允许量化误差
+ */
+bool sameCard(const CardConfig& a, const CardConfig& b) {
+    const float tolerance = 0.5f / LevelPack::DEFAULT_POSITION_SCALE + 1e-4f;
+    return a.cardFace == b.cardFace && a.cardSuit == b.cardSuit &&
+           std::fabs(a.position.x - b.position.x) <= tolerance &&
+           std::fabs(a.position.y - b.position.y) <= tolerance;
+}
+
+bool sameCards(const std::vector<CardConfig>& a, const std::vector<CardConfig>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!sameCard(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string outputPath;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg[0] == '-') {
+            printUsage();
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (outputPath.empty() || inputs.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!ToolUtils::collectLevelFiles(inputs[i], paths)) {
+            std::fprintf(stderr, "level_packer: %s: no such file or directory\n", inputs[i].c_str());
+            return 2;
+        }
+    }
+
+    std::vector<LevelConfig> levels(paths.size());
+    std::string error;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!ToolUtils::loadLevelFile(paths[i], levels[i], &error)) {
+            std::fprintf(stderr, "level_packer: %s: %s\n", paths[i].c_str(), error.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<uint8_t> data;
+    if (!LevelPack::build(levels, data, &error)) {
+        std::fprintf(stderr, "level_packer: %s\n", error.c_str());
+        return 1;
+    }
+    if (!ToolUtils::writeFile(outputPath, std::string(data.begin(), data.end()))) {
+        std::fprintf(stderr, "level_packer: cannot write %s\n", outputPath.c_str());
+        return 2;
+    }
+
+    // 从磁盘重新映射，确认写出的文件能被游戏读取且与输入一致
+    LevelPack pack;
+    if (!pack.openFile(outputPath, &error)) {
+        std::fprintf(stderr, "level_packer: %s: %s\n", outputPath.c_str(), error.c_str());
+        return 1;
+    }
+    LevelConfig decoded;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (!pack.decodeLevel(static_cast<int>(i), decoded) || levels[i].ruleSet != decoded.ruleSet ||
+            !sameCards(levels[i].stack, decoded.stack) || !sameCards(levels[i].playfield, decoded.playfield)) {
+            std::fprintf(stderr, "level_packer: %s: level %u does not round-trip\n",
+                         outputPath.c_str(), static_cast<unsigned int>(i));
+            return 1;
+        }
+    }
+
+    std::printf("%s: %u levels, %u bytes\n", outputPath.c_str(),
+                static_cast<unsigned int>(levels.size()), static_cast<unsigned int>(data.size()));
+    return 0;
+}
@@ -0,0 +1,120 @@
+﻿/**
+ * @file level_solver.cpp
+ * @brief 关卡求解命令行工具
+ *
+ * 对每个关卡判断是否可解、给出最短解的步数和展开的节点数，
+ * 并把解在新的GameModel上逐步交给GameService::replayMove重放验证
+ *
+ * 用法：
+ *   level_solver [--threads N] [--max-nodes N] [--table-bits N] [--print-moves] <关卡文件或目录>...
+ *
+ * 退出码：0 全部可解；1 存在无解、未穷尽或验证失败的关卡；2 参数或文件错误
+ */
+
+#include "ToolUtils.h"
+#include "services/GameService.h"
+#include "solver/LevelSolver.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: level_solver [--threads N] [--max-nodes N] [--table-bits N] [--print-moves] <level.json|dir>...\n");
+}
+
+/**
+ * @brief 在新的对局上重放解，确认其被游戏规则接受并清空牌桌
+ */
+bool verifySolution(const LevelConfig& level, const std::vector<MoveRecord>& moves) {
+    GameModel model;
+    GameService::loadLevel(&model, level);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        if (!GameService::replayMove(&model, moves[i])) {
+            return false;
+        }
+    }
+    return model.checkWinCondition();
+}
+
+void printMoves(const std::vector<MoveRecord>& moves) {
+    for (size_t i = 0; i < moves.size(); ++i) {
+        std::printf("    %3d. %s %d\n", static_cast<int>(i + 1),
+                    moves[i].type == MT_HAND_REPLACE ? "hand " : "match", moves[i].cardId);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SolverOptions options;
+    bool printSolution = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--threads") == 0 && i + 1 < argc) {
+            options.threadCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--max-nodes") == 0 && i + 1 < argc) {
+            options.maxNodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--table-bits") == 0 && i + 1 < argc) {
+            options.tableSizeLog2 = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--print-moves") == 0) {
+            printSolution = true;
+        } else if (arg[0] == '-') {
+            printUsage();
+            return 2;
+        } else if (!ToolUtils::collectLevelFiles(arg, files)) {
+            std::fprintf(stderr, "level_solver: cannot open %s\n", arg);
+            return 2;
+        }
+    }
+    if (files.empty() || options.tableSizeLog2 < 4 || options.tableSizeLog2 > 30) {
+        printUsage();
+        return 2;
+    }
+
+    LevelSolver solver(options);
+    int failures = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        LevelConfig level;
+        std::string error;
+        if (!ToolUtils::loadLevelFile(files[i], level, &error)) {
+            std::fprintf(stderr, "level_solver: %s: %s\n", files[i].c_str(), error.c_str());
+            return 2;
+        }
+
+        GameModel model;
+        if (!GameService::loadLevel(&model, level)) {
+            std::fprintf(stderr, "level_solver: %s: level exceeds model capacity\n", files[i].c_str());
+            return 2;
+        }
+
+        SolverResult result = solver.solve(model);
+        const char* verdict = "unsolvable";
+        if (result.solvable) {
+            verdict = verifySolution(level, result.moves) ? "solvable" : "INVALID";
+        } else if (!result.complete) {
+            verdict = "unknown";
+        }
+        if (!result.solvable || !result.complete || std::strcmp(verdict, "INVALID") == 0) {
+            failures++;
+        }
+
+        std::printf("%s: %s moves=%d nodes=%llu table_hits=%llu time=%.3fs%s\n",
+                    files[i].c_str(), verdict, result.moveCount,
+                    static_cast<unsigned long long>(result.nodes),
+                    static_cast<unsigned long long>(result.tableHits),
+                    result.elapsedSeconds,
+                    result.complete ? "" : " (node limit reached)");
+        if (printSolution && result.solvable) {
+            printMoves(result.moves);
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+﻿#include "LevelCache.h"
+#include "ToolUtils.h"
+#include "services/GameService.h"
+
+LevelCache::LevelCache() {
+}
+
+bool LevelCache::addLevel(const LevelConfig& level, std::string* error) {
+    std::unique_ptr<GameModel> model(new GameModel());
+    if (!GameService::loadLevel(model.get(), level)) {
+        if (error) {
+            *error = "level exceeds model capacity";
+        }
+        return false;
+    }
+
+    uint64_t hash = model->computeStateHash();
+    if (m_levels.find(hash) == m_levels.end()) {
+        m_levels[hash] = std::move(model);
+    }
+    return true;
+}
+
+bool LevelCache::addLevelFile(const std::string& path, std::string* error) {
+    LevelConfig level;
+    return ToolUtils::loadLevelFile(path, level, error) && addLevel(level, error);
+}
+
+const GameModel* LevelCache::find(uint64_t initialStateHash) const {
+    std::unordered_map<uint64_t, std::unique_ptr<GameModel>>::const_iterator it = m_levels.find(initialStateHash);
+    return it != m_levels.end() ? it->second.get() : nullptr;
+}
@@ -0,0 +1,63 @@
+﻿#ifndef __LEVEL_CACHE_H__
+#define __LEVEL_CACHE_H__
+
+#include "configs/LevelData.h"
+#include "models/GameModel.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class LevelCache
+ * @brief 按初始状态哈希索引的已加载关卡
+ *
+ * 每个关卡只解析并加载一次，回放时直接复制加载好的GameModel
+ * 录制的文件头带有初始状态哈希，因此无需约定关卡文件名与关卡ID的对应关系
+ *
+ * 构建阶段（addLevel）只能在单个线程中进行；构建完成后只读，
+ * 可被任意多个线程同时查询而无需加锁
+ */
+class LevelCache {
+public:
+    LevelCache();
+
+    /**
+     * @brief 加载一个关卡
+     *
+     * 初始状态完全相同的关卡只保留先加入的一个
+     * @param level 关卡配置
+     * @param error 失败时输出错误描述，可为空
+     * @return 成功返回true
+     */
+    bool addLevel(const LevelConfig& level, std::string* error = nullptr);
+
+    /**
+     * @brief 读取、解析并加载一个关卡文件
+     *
+     * @param path 关卡文件路径
+     * @param error 失败时输出错误描述，可为空
+     * @return 成功返回true
+     */
+    bool addLevelFile(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief 按初始状态哈希查找关卡
+     *
+     * @return 找到返回处于初始状态的模型，否则返回nullptr
+     */
+    const GameModel* find(uint64_t initialStateHash) const;
+
+    /**
+     * @brief 获取关卡数量
+     */
+    size_t size() const { return m_levels.size(); }
+
+private:
+    LevelCache(const LevelCache&) = delete;
+    LevelCache& operator=(const LevelCache&) = delete;
+
+    std::unordered_map<uint64_t, std::unique_ptr<GameModel>> m_levels; ///< 初始状态哈希到模型
+};
+
+#endif // __LEVEL_CACHE_H__
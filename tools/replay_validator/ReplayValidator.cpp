@@ -0,0 +1,113 @@
+﻿#include "ReplayValidator.h"
+#include "ThreadPool.h"
+#include "ToolUtils.h"
+#include <chrono>
+#include <mutex>
+
+BatchValidationStats::BatchValidationStats()
+    : replays(0), inputs(0), bytes(0), elapsedSeconds(0.0) {
+    for (int i = 0; i < RV_NUM_VERDICTS; ++i) {
+        verdictCounts[i] = 0;
+    }
+}
+
+void BatchValidationStats::merge(const BatchValidationStats& other) {
+    replays += other.replays;
+    inputs += other.inputs;
+    bytes += other.bytes;
+    for (int i = 0; i < RV_NUM_VERDICTS; ++i) {
+        verdictCounts[i] += other.verdictCounts[i];
+    }
+}
+
+double BatchValidationStats::getReplaysPerSecond() const {
+    return elapsedSeconds > 0.0 ? replays / elapsedSeconds : 0.0;
+}
+
+ReplayValidator::ReplayValidator(const LevelCache& levels)
+    : m_levels(levels) {
+}
+
+ReplayVerdict ReplayValidator::validate(const uint8_t* data, size_t size, ReplayReport& report) {
+    report.levelId = 0;
+    report.inputs = 0;
+    report.claimedScore = 0;
+    report.result = ReplayResult();
+
+    if (!m_recording.parse(data, size)) {
+        report.result.verdict = RV_MALFORMED;
+        return report.result.verdict;
+    }
+    report.levelId = m_recording.header.levelId;
+    report.inputs = static_cast<uint32_t>(m_recording.events.size());
+    report.claimedScore = m_recording.hasResult ? m_recording.finalScore : 0;
+
+    const GameModel* level = m_levels.find(m_recording.header.initialStateHash);
+    if (!level) {
+        report.result.verdict = RV_LEVEL_MISMATCH;
+        return report.result.verdict;
+    }
+
+    m_model = *level;
+    return ReplayService::replay(&m_model, m_recording, RS_MAX_SPEED, m_undoManager, m_scoring, report.result);
+}
+
+BatchReplayValidator::BatchReplayValidator(const LevelCache& levels, const BatchValidationOptions& options)
+    : m_levels(levels)
+    , m_options(options) {
+    if (m_options.batchSize == 0) {
+        m_options.batchSize = 1;
+    }
+}
+
+BatchValidationStats BatchReplayValidator::run(SubmissionQueue& queue, const ReportSink& sink) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ThreadPool pool(m_options.threadCount);
+    std::mutex mutex;
+    BatchValidationStats total;
+
+    for (int t = 0; t < pool.getThreadCount(); ++t) {
+        pool.submit([this, &queue, &sink, &mutex, &total]() {
+            ReplayValidator validator(m_levels);
+            BatchValidationStats stats;
+            std::vector<ReplaySubmission> batch;
+            std::vector<ReplayReport> reports;
+            std::vector<uint8_t> fileData;
+
+            while (queue.popBatch(batch, m_options.batchSize) > 0) {
+                reports.resize(batch.size());
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    ReplayReport& report = reports[i];
+                    report.id.swap(batch[i].id);
+
+                    // 读不出的文件按无法解析处理
+                    const std::vector<uint8_t>* data = &batch[i].data;
+                    if (!batch[i].path.empty()) {
+                        if (!ToolUtils::readFile(batch[i].path, fileData)) {
+                            fileData.clear();
+                        }
+                        data = &fileData;
+                    }
+
+                    ReplayVerdict verdict = validator.validate(data->data(), data->size(), report);
+                    stats.replays++;
+                    stats.inputs += report.inputs;
+                    stats.bytes += data->size();
+                    stats.verdictCounts[verdict]++;
+                }
+                if (sink) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    sink(reports);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            total.merge(stats);
+        });
+    }
+    pool.wait();
+
+    total.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
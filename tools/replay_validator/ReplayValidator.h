@@ -0,0 +1,121 @@
+﻿#ifndef __REPLAY_VALIDATOR_H__
+#define __REPLAY_VALIDATOR_H__
+
+#include "LevelCache.h"
+#include "SubmissionQueue.h"
+#include "managers/InputRecording.h"
+#include "services/ReplayService.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplayReport
+ * @brief 一份提交的校验结果
+ */
+struct ReplayReport {
+    std::string id;             ///< 提交标识
+    int32_t levelId;            ///< 录制中的关卡ID，无法解析时为0
+    uint32_t inputs;            ///< 录制中的输入数
+    int32_t claimedScore;       ///< 录制声明的得分，没有结果时为0
+    ReplayResult result;        ///< 回放结果
+};
+
+/**
+ * @struct BatchValidationOptions
+ * @brief 批量校验参数
+ */
+struct BatchValidationOptions {
+    int threadCount;            ///< 校验线程数，0表示使用硬件线程数
+    size_t batchSize;           ///< 每个线程一次从队列取出的提交数
+
+    BatchValidationOptions() : threadCount(0), batchSize(64) {}
+};
+
+/**
+ * @struct BatchValidationStats
+ * @brief 批量校验的汇总
+ */
+struct BatchValidationStats {
+    uint64_t replays;                           ///< 校验的提交数
+    uint64_t inputs;                            ///< 回放的输入总数
+    uint64_t bytes;                             ///< 录制数据总字节数
+    uint64_t verdictCounts[RV_NUM_VERDICTS];    ///< 各结论的提交数
+    double elapsedSeconds;                      ///< 耗时（秒）
+
+    BatchValidationStats();
+
+    /**
+     * @brief 合并另一组汇总，耗时不合并
+     */
+    void merge(const BatchValidationStats& other);
+
+    /**
+     * @brief 获取每秒校验的提交数
+     */
+    double getReplaysPerSecond() const;
+};
+
+/**
+ * @class ReplayValidator
+ * @brief 单线程的录制校验器
+ *
+ * 解析录制，按初始状态哈希从关卡缓存中取出关卡，经ReplayService回放并校验最终状态
+ * 解析出的输入列表、回放模型、撤销管理器和计分引擎在多次校验间复用
+ * 每个线程各用一个实例，共享同一个只读的关卡缓存
+ */
+class ReplayValidator {
+public:
+    explicit ReplayValidator(const LevelCache& levels);
+
+    /**
+     * @brief 校验一份录制
+     *
+     * @param data 录制数据
+     * @param size 数据字节数
+     * @param report 输出的校验结果，标识字段不会被修改
+     * @return 结论
+     */
+    ReplayVerdict validate(const uint8_t* data, size_t size, ReplayReport& report);
+
+private:
+    ReplayValidator(const ReplayValidator&) = delete;
+    ReplayValidator& operator=(const ReplayValidator&) = delete;
+
+    const LevelCache& m_levels;     ///< 共享的关卡缓存
+    InputRecording m_recording;     ///< 复用的解析结果
+    GameModel m_model;              ///< 复用的回放模型
+    UndoManager m_undoManager;      ///< 复用的撤销管理器
+    ScoringEngine m_scoring;        ///< 复用的计分引擎
+};
+
+/**
+ * @class BatchReplayValidator
+ * @brief 多线程批量录制校验
+ *
+ * 在线程池的每个线程上运行一个取队列、校验的循环，每次取出一批提交，
+ * 校验结果按批交给回调；回调由内部互斥锁串行调用，可直接写文件
+ */
+class BatchReplayValidator {
+public:
+    typedef std::function<void(const std::vector<ReplayReport>&)> ReportSink;
+
+    BatchReplayValidator(const LevelCache& levels, const BatchValidationOptions& options);
+
+    /**
+     * @brief 校验队列中的全部提交
+     *
+     * 阻塞到队列被关闭且取空为止；提交由其他线程压入队列
+     * @param queue 提交队列
+     * @param sink 接收校验结果的回调，可为空
+     * @return 汇总
+     */
+    BatchValidationStats run(SubmissionQueue& queue, const ReportSink& sink);
+
+private:
+    const LevelCache& m_levels;
+    BatchValidationOptions m_options;
+};
+
+#endif // __REPLAY_VALIDATOR_H__
@@ -0,0 +1,50 @@
+﻿#include "SubmissionQueue.h"
+
+SubmissionQueue::SubmissionQueue(size_t capacity)
+    : m_capacity(capacity > 0 ? capacity : 1)
+    , m_closed(false) {
+}
+
+bool SubmissionQueue::push(ReplaySubmission& submission) {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this]() { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) {
+            return false;
+        }
+        m_items.push_back(ReplaySubmission());
+        m_items.back().id.swap(submission.id);
+        m_items.back().path.swap(submission.path);
+        m_items.back().data.swap(submission.data);
+    }
+    m_notEmpty.notify_one();
+    return true;
+}
+
+size_t SubmissionQueue::popBatch(std::vector<ReplaySubmission>& out, size_t maxCount) {
+    out.clear();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return m_closed || !m_items.empty(); });
+        while (!m_items.empty() && out.size() < maxCount) {
+            out.push_back(ReplaySubmission());
+            out.back().id.swap(m_items.front().id);
+            out.back().path.swap(m_items.front().path);
+            out.back().data.swap(m_items.front().data);
+            m_items.pop_front();
+        }
+    }
+    if (!out.empty()) {
+        m_notFull.notify_all();
+    }
+    return out.size();
+}
+
+void SubmissionQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_notFull.notify_all();
+    m_notEmpty.notify_all();
+}
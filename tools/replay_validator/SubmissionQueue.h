@@ -0,0 +1,79 @@
+﻿#ifndef __SUBMISSION_QUEUE_H__
+#define __SUBMISSION_QUEUE_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplaySubmission
+ * @brief 一份待校验的录制
+ */
+struct ReplaySubmission {
+    std::string id;                 ///< 提交标识，原样出现在校验结果中
+    std::string path;               ///< 录制文件路径；非空时由校验线程读取文件，data被忽略
+    std::vector<uint8_t> data;      ///< 录制数据
+};
+
+/**
+ * @class SubmissionQueue
+ * @brief 有界的录制提交队列
+ *
+ * 本地替代线上提交队列：生产者逐份压入录制，校验线程成批取出
+ * 队列满时push阻塞，因此内存占用不超过容量乘以单份录制的大小，与提交总数无关
+ * 本地文件只需提交路径，读文件的开销随校验线程一起并行
+ * 关闭后不再接受新的提交，已入队的提交仍会被取完
+ */
+class SubmissionQueue {
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param capacity 最多同时排队的提交数，至少为1
+     */
+    explicit SubmissionQueue(size_t capacity);
+
+    /**
+     * @brief 压入一份提交，队列满时阻塞
+     *
+     * @param submission 提交，成功后其内容被移走
+     * @return 成功返回true，队列已关闭返回false
+     */
+    bool push(ReplaySubmission& submission);
+
+    /**
+     * @brief 取出一批提交，队列为空时阻塞
+     *
+     * @param out 输出的提交，会先被清空
+     * @param maxCount 最多取出的数量
+     * @return 取出的数量；队列已关闭且为空时返回0
+     */
+    size_t popBatch(std::vector<ReplaySubmission>& out, size_t maxCount);
+
+    /**
+     * @brief 关闭队列，唤醒所有等待的线程
+     */
+    void close();
+
+    /**
+     * @brief 获取容量
+     */
+    size_t getCapacity() const { return m_capacity; }
+
+private:
+    SubmissionQueue(const SubmissionQueue&) = delete;
+    SubmissionQueue& operator=(const SubmissionQueue&) = delete;
+
+    std::deque<ReplaySubmission> m_items;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;      ///< 有空位或队列关闭
+    std::condition_variable m_notEmpty;     ///< 有提交或队列关闭
+    size_t m_capacity;
+    bool m_closed;
+};
+
+#endif // __SUBMISSION_QUEUE_H__
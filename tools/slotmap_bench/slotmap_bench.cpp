@@ -0,0 +1,179 @@
+﻿/**
+ * @file slotmap_bench.cpp
+ * @brief 牌桌卡牌容器微基准
+ *
+ * 对比原先的std::vector<CardModel>（按ID线性查找、erase移除）与SlotMap
+ * 在50、500、5000张牌桌卡牌下的查找、移除和遍历耗时
+ *
+ * 构建：
+ *   cmake -S tools/slotmap_bench -B build/slotmap_bench
+ *   cmake --build build/slotmap_bench
+ */
+
+#include "utils/SlotMap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 与原CardModel布局相同的卡牌，不依赖cocos2d
+ */
+struct BenchCard {
+    int id;
+    int face;
+    int suit;
+    bool isFaceUp;
+    float x;
+    float y;
+};
+
+const int ROUNDS = 20;
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedNanoseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+BenchCard makeCard(int id) {
+    BenchCard card;
+    card.id = id;
+    card.face = id % 13;
+    card.suit = (id / 13) % 4;
+    card.isFaceUp = true;
+    card.x = static_cast<float>(id);
+    card.y = 0.0f;
+    return card;
+}
+
+/**
+ * @brief 单项测试的结果（每次操作的纳秒数）
+ */
+struct BenchResult {
+    double lookupNs;
+    double removeNs;
+    double iterateNs;
+};
+
+/**
+ * @brief 原先的vector实现
+ */
+BenchResult runVector(int cardCount, const std::vector<int>& order) {
+    BenchResult result = { 0.0, 0.0, 0.0 };
+    long checksum = 0;
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::vector<BenchCard> cards;
+        for (int id = 0; id < cardCount; ++id) {
+            cards.push_back(makeCard(id));
+        }
+
+        auto start = Clock::now();
+        for (int id : order) {
+            auto it = std::find_if(cards.begin(), cards.end(),
+                [id](const BenchCard& card) { return card.id == id; });
+            checksum += it->face;
+        }
+        result.lookupNs += elapsedNanoseconds(start);
+
+        start = Clock::now();
+        for (const BenchCard& card : cards) {
+            checksum += card.suit;
+        }
+        result.iterateNs += elapsedNanoseconds(start);
+
+        start = Clock::now();
+        for (int id : order) {
+            auto it = std::find_if(cards.begin(), cards.end(),
+                [id](const BenchCard& card) { return card.id == id; });
+            cards.erase(it);
+        }
+        result.removeNs += elapsedNanoseconds(start);
+    }
+
+    if (checksum == 42) {
+        std::printf(" ");
+    }
+    result.lookupNs /= static_cast<double>(ROUNDS) * cardCount;
+    result.removeNs /= static_cast<double>(ROUNDS) * cardCount;
+    result.iterateNs /= static_cast<double>(ROUNDS) * cardCount;
+    return result;
+}
+
+/**
+ * @brief SlotMap实现
+ */
+template <int Capacity>
+BenchResult runSlotMap(int cardCount, const std::vector<int>& order) {
+    typedef SlotMap<BenchCard, Capacity, Capacity> CardMap;
+    std::unique_ptr<CardMap> cards(new CardMap());
+    BenchResult result = { 0.0, 0.0, 0.0 };
+    long checksum = 0;
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        cards->clear(false);
+        for (int id = 0; id < cardCount; ++id) {
+            cards->insert(id, makeCard(id));
+        }
+
+        auto start = Clock::now();
+        for (int id : order) {
+            checksum += cards->find(id)->face;
+        }
+        result.lookupNs += elapsedNanoseconds(start);
+
+        start = Clock::now();
+        for (int i = 0; i < cards->size(); ++i) {
+            checksum += cards->values[i].suit;
+        }
+        result.iterateNs += elapsedNanoseconds(start);
+
+        start = Clock::now();
+        for (int id : order) {
+            cards->erase(cards->handleOf(id));
+        }
+        result.removeNs += elapsedNanoseconds(start);
+    }
+
+    if (checksum == 42) {
+        std::printf(" ");
+    }
+    result.lookupNs /= static_cast<double>(ROUNDS) * cardCount;
+    result.removeNs /= static_cast<double>(ROUNDS) * cardCount;
+    result.iterateNs /= static_cast<double>(ROUNDS) * cardCount;
+    return result;
+}
+
+void printRow(const char* name, int cardCount, const BenchResult& result) {
+    std::printf("%-8s %6d %12.2f %12.2f %12.2f\n", name, cardCount,
+                result.lookupNs, result.removeNs, result.iterateNs);
+}
+
+template <int Capacity>
+void runSize(int cardCount) {
+    // 查找和移除都按同一个随机顺序进行，模拟玩家任意点击牌桌卡牌
+    std::vector<int> order(cardCount);
+    for (int i = 0; i < cardCount; ++i) {
+        order[i] = i;
+    }
+    std::mt19937 rng(12345);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    printRow("vector", cardCount, runVector(cardCount, order));
+    printRow("slotmap", cardCount, runSlotMap<Capacity>(cardCount, order));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-8s %6s %12s %12s %12s\n", "impl", "cards", "lookup ns", "remove ns", "iterate ns");
+    runSize<50>(50);
+    runSize<500>(500);
+    runSize<5000>(5000);
+    return 0;
+}